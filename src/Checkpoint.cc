@@ -0,0 +1,158 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "Checkpoint.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+
+using namespace openwbo;
+
+void Checkpoint::clear() {
+  algorithm = "none";
+  fingerprint = 0;
+  nVars = nSoft = 0;
+  lb = cores = ub = 0;
+  model.clear();
+  relaxed.clear();
+  nodes.clear();
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  save : (file : const char *)  ->  [bool]
+  |
+  |  Description:
+  |
+  |    Writes the checkpoint as text to 'file'. The text is written to the
+  |    temporary file 'file' + ".tmp", which then replaces 'file' with a
+  |    rename, so a run that is killed while writing leaves the previous
+  |    checkpoint intact.
+  |
+  |________________________________________________________________________________________________@*/
+bool Checkpoint::save(const char *file) {
+  std::string tmp = std::string(file) + ".tmp";
+  FILE *out = fopen(tmp.c_str(), "w");
+  if (out == NULL)
+    return false;
+
+  fprintf(out, "c open-wbo checkpoint\n");
+  fprintf(out, "algorithm %s\n", algorithm.c_str());
+  fprintf(out, "fingerprint %" PRIx64 " vars %d soft %d\n", fingerprint, nVars,
+          nSoft);
+  fprintf(out, "lb %" PRIu64 " cores %" PRIu64 " ub %" PRIu64 "\n", lb, cores,
+          ub);
+  fprintf(out, "model ");
+  if (model.empty())
+    fprintf(out, "-");
+  for (size_t i = 0; i < model.size(); i++)
+    fputc(model[i] ? '1' : '0', out);
+  fprintf(out, "\nrelaxed %d", (int)relaxed.size());
+  for (size_t i = 0; i < relaxed.size(); i++)
+    fprintf(out, " %d", relaxed[i]);
+  fprintf(out, "\n");
+  for (size_t i = 0; i < nodes.size(); i++)
+    fprintf(out, "node %c %d %d %" PRId64 "\n", nodes[i].role, nodes[i].first,
+            nodes[i].parts, nodes[i].lb);
+  fprintf(out, "end\n");
+
+  bool ok = !ferror(out);
+  ok = fclose(out) == 0 && ok;
+  return ok && rename(tmp.c_str(), file) == 0;
+}
+
+// Reads the text of 'format', which ends with "%n" and has no other
+// conversion. The return value of fscanf is 0 whether the text matched or
+// not, so only the position stored by "%n" tells them apart.
+static bool matchText(FILE *in, const char *format) {
+  int n = -1;
+  return fscanf(in, format, &n) == 0 && n > 0;
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  load : (file : const char *)  ->  [bool]
+  |
+  |  Description:
+  |
+  |    Reads a checkpoint written by 'save'. Every line must have all of its
+  |    fields and the sizes must fit the formula of the header, otherwise the
+  |    checkpoint is cleared and false is returned: a truncated or corrupted
+  |    file is never resumed.
+  |
+  |________________________________________________________________________________________________@*/
+bool Checkpoint::load(const char *file) {
+  clear();
+  FILE *in = fopen(file, "r");
+  if (in == NULL)
+    return false;
+
+  char name[256] = "";
+  int nRelaxed = 0;
+  bool ok =
+      matchText(in, " c open-wbo checkpoint%n") &&
+      fscanf(in, " algorithm %255s", name) == 1 &&
+      fscanf(in, " fingerprint %" SCNx64 " vars %d soft %d", &fingerprint,
+             &nVars, &nSoft) == 3 &&
+      nVars >= 0 && nSoft >= 0 &&
+      fscanf(in, " lb %" SCNu64 " cores %" SCNu64 " ub %" SCNu64, &lb, &cores,
+             &ub) == 3 &&
+      matchText(in, " model%n");
+  algorithm = name;
+
+  if (ok) {
+    int c = fgetc(in);
+    while (c == ' ')
+      c = fgetc(in);
+    if (c != '-')
+      for (; c == '0' || c == '1'; c = fgetc(in))
+        model.push_back(c == '1');
+    ok = model.empty() || (int)model.size() == nVars;
+  }
+
+  ok = ok && fscanf(in, " relaxed %d", &nRelaxed) == 1 && nRelaxed >= 0;
+  for (int i = 0; ok && i < nRelaxed; i++) {
+    int soft;
+    ok = fscanf(in, "%d", &soft) == 1 && soft >= 0 && soft < nSoft;
+    relaxed.push_back(soft);
+  }
+
+  Node node;
+  while (ok && fscanf(in, " node %c %d %d %" SCNd64, &node.role, &node.first,
+                      &node.parts, &node.lb) == 4) {
+    ok = (node.role == _NODE_CURRENT_ || node.role == _NODE_QUEUED_ ||
+          node.role == _NODE_WAITING_) &&
+         node.first >= 0 && node.parts > 0;
+    nodes.push_back(node);
+  }
+  ok = ok && matchText(in, " end%n");
+
+  fclose(in);
+  if (!ok)
+    clear();
+  return ok;
+}
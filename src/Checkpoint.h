@@ -0,0 +1,77 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#ifndef Checkpoint_h
+#define Checkpoint_h
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+namespace openwbo {
+
+// State of a search that can be saved to a file and used by a later run to
+// continue the search. The state is only valid for the same formula
+// ('fingerprint') and the bounds are only valid without user assumptions.
+class Checkpoint {
+
+public:
+  Checkpoint() { clear(); }
+
+  void clear();
+
+  // Writes 'file' + ".tmp" and renames it to 'file'.
+  bool save(const char *file);
+  bool load(const char *file);
+
+  // Node of the guide tree of PartMSU3 (see PartMSU3::saveState).
+  enum { _NODE_CURRENT_ = 'c', _NODE_QUEUED_ = 'q', _NODE_WAITING_ = 'w' };
+  struct Node {
+    char role;
+    int first; // First partition of the node.
+    int parts; // Number of partitions of the node.
+    int64_t lb;
+  };
+
+  std::string algorithm; // Algorithm that owns the state of the search.
+  uint64_t fingerprint;  // Hash of the formula.
+  int nVars;
+  int nSoft;
+
+  uint64_t lb;    // Lower bound of the formula.
+  uint64_t cores; // Lower bound of the algorithm (number of cores).
+  uint64_t ub;    // Cost of 'model'.
+  std::vector<char> model; // Best model on the variables of the formula.
+
+  std::vector<int> relaxed; // Soft clauses relaxed by the algorithm.
+  std::vector<Node> nodes;
+};
+
+} // namespace openwbo
+
+#endif
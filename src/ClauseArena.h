@@ -0,0 +1,182 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#ifndef ClauseArena_h
+#define ClauseArena_h
+
+#ifdef SIMP
+#include "simp/SimpSolver.h"
+#else
+#include "core/Solver.h"
+#endif
+
+#include "MemoryUsage.h"
+
+using NSPACE::vec;
+using NSPACE::Lit;
+
+namespace openwbo {
+
+// Read-only view of the literals of one clause of an arena. It is not valid
+// after the arena changes.
+class LitSpan {
+
+public:
+  LitSpan() : data(NULL), sz(0) {}
+  LitSpan(const Lit *lits, int size) : data(lits), sz(size) {}
+
+  int size() const { return sz; }
+  const Lit &operator[](int i) const {
+    assert(i >= 0 && i < sz);
+    return data[i];
+  }
+  const Lit &last() const { return (*this)[sz - 1]; }
+
+  void copyTo(vec<Lit> &copy) const {
+    copy.clear();
+    copy.capacity(sz);
+    for (int i = 0; i < sz; i++)
+      copy.push(data[i]);
+  }
+
+protected:
+  const Lit *data;
+  int sz;
+};
+
+// Clauses stored one after another in a single literal array (CSR): the
+// literals of clause i are lits[offsets[i]] .. lits[offsets[i+1]-1]. Clauses
+// can only be added at the end.
+class ClauseArena {
+
+public:
+  ClauseArena() { offsets.push(0); }
+
+  void add(const vec<Lit> &clause) {
+    for (int i = 0; i < clause.size(); i++)
+      lits.push(clause[i]);
+    offsets.push(lits.size());
+  }
+
+  // Adds 'sizes.size()' clauses whose literals are one after another in
+  // 'clause_lits'.
+  void add(const vec<int> &sizes, const vec<Lit> &clause_lits) {
+    offsets.capacity(offsets.size() + sizes.size());
+    lits.capacity(lits.size() + clause_lits.size());
+    for (int i = 0; i < clause_lits.size(); i++)
+      lits.push(clause_lits[i]);
+    for (int i = 0; i < sizes.size(); i++)
+      offsets.push(offsets.last() + sizes[i]);
+    assert(offsets.last() == lits.size());
+  }
+
+  int size() const { return offsets.size() - 1; }
+  int nLits() const { return lits.size(); }
+
+  LitSpan operator[](int i) const {
+    assert(i >= 0 && i < size());
+    return LitSpan(lits.size() > 0 ? &lits[offsets[i]] : NULL,
+                   offsets[i + 1] - offsets[i]);
+  }
+
+  // Flat arrays for loops over all the clauses.
+  const vec<int> &getOffsets() const { return offsets; }
+  const vec<Lit> &getLits() const { return lits; }
+
+  uint64_t bytes() const { return vecBytes(offsets) + vecBytes(lits); }
+
+protected:
+  vec<int> offsets;
+  vec<Lit> lits;
+};
+
+// Lists of literals in a single array that can grow after they are created,
+// like the relaxation variables of the soft clauses. A list that is not the
+// last one in the array is moved to the end when a literal is added to it;
+// the array is compacted when more than half of it is unused.
+class LitLists {
+
+public:
+  LitLists() : unused(0) {}
+
+  void add() {
+    starts.push(lits.size());
+    sizes.push(0);
+  }
+
+  void push(int list, Lit l) {
+    if (starts[list] + sizes[list] != lits.size()) {
+      if (2 * (unused + sizes[list]) > lits.size())
+        compact();
+      if (starts[list] + sizes[list] != lits.size()) {
+        int start = lits.size();
+        lits.capacity(start + sizes[list] + 1);
+        for (int i = 0; i < sizes[list]; i++)
+          lits.push(lits[starts[list] + i]);
+        unused += sizes[list];
+        starts[list] = start;
+      }
+    }
+    lits.push(l);
+    sizes[list]++;
+  }
+
+  int size() const { return starts.size(); }
+
+  LitSpan operator[](int i) const {
+    assert(i >= 0 && i < size());
+    return LitSpan(sizes[i] > 0 ? &lits[starts[i]] : NULL, sizes[i]);
+  }
+
+  uint64_t bytes() const {
+    return vecBytes(starts) + vecBytes(sizes) + vecBytes(lits);
+  }
+
+protected:
+  // Copies the lists to a new array in order, without the unused literals.
+  void compact() {
+    vec<Lit> compacted;
+    compacted.capacity(lits.size() - unused);
+    for (int i = 0; i < starts.size(); i++) {
+      int start = compacted.size();
+      for (int j = 0; j < sizes[i]; j++)
+        compacted.push(lits[starts[i] + j]);
+      starts[i] = start;
+    }
+    compacted.moveTo(lits);
+    unused = 0;
+  }
+
+  vec<int> starts;
+  vec<int> sizes;
+  vec<Lit> lits;
+  int unused; // Literals of lists that were moved.
+};
+
+} // namespace openwbo
+
+#endif
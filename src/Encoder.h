@@ -164,6 +164,14 @@ public:
     totalizer.setIncremental(incremental);
   }
 
+  // Bytes of the auxiliary structures of the encodings.
+  //
+  uint64_t memoryUsage() {
+    return ladder.memoryUsage() + cnetworks.memoryUsage() +
+           mtotalizer.memoryUsage() + totalizer.memoryUsage() +
+           adder.memoryUsage() + swc.memoryUsage() + gte.memoryUsage();
+  }
+
 protected:
   int incremental_strategy;
   int cardinality_encoding;
@@ -0,0 +1,571 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "HittingSet.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits.h>
+#include <limits>
+
+using namespace openwbo;
+
+void HittingSet::init(const std::vector<uint64_t> &weights) {
+  weight = weights;
+  forbidden.assign(weight.size(), 0);
+  cores.clear();
+  elemCores.assign(weight.size(), std::vector<int>());
+  order.clear();
+  solved.clear();
+}
+
+void HittingSet::addCore(const std::vector<int> &core) {
+  for (size_t i = 0; i < core.size(); i++)
+    elemCores[core[i]].push_back((int)cores.size());
+  cores.push_back(core);
+}
+
+static bool smallerCore(const std::vector<std::vector<int> > *cores, int a,
+                        int b) {
+  return (*cores)[a].size() < (*cores)[b].size();
+}
+
+void HittingSet::sortCores() {
+  if (order.size() == cores.size())
+    return;
+  order.resize(cores.size());
+  for (size_t k = 0; k < order.size(); k++)
+    order[k] = (int)k;
+  std::stable_sort(order.begin(), order.end(),
+                   std::bind(smallerCore, &cores, std::placeholders::_1,
+                             std::placeholders::_2));
+}
+
+static int findRoot(std::vector<int> &parent, int k) {
+  while (parent[k] != k) {
+    parent[k] = parent[parent[k]];
+    k = parent[k];
+  }
+  return k;
+}
+
+// Cores connected by the elements that are not forbidden. The minimum-cost
+// hitting set is the union of the minimum-cost hitting sets of the
+// components. Each component is in packing order.
+void HittingSet::components(std::vector<std::vector<int> > &comps) {
+  std::vector<int> parent(cores.size());
+  for (size_t k = 0; k < parent.size(); k++)
+    parent[k] = (int)k;
+  for (size_t e = 0; e < elemCores.size(); e++) {
+    if (forbidden[e] || elemCores[e].size() < 2)
+      continue;
+    int root = findRoot(parent, elemCores[e][0]);
+    for (size_t i = 1; i < elemCores[e].size(); i++) {
+      int other = findRoot(parent, elemCores[e][i]);
+      if (other != root)
+        parent[other] = root;
+    }
+  }
+
+  std::vector<int> index(cores.size(), -1);
+  comps.clear();
+  for (size_t i = 0; i < order.size(); i++) {
+    int root = findRoot(parent, order[i]);
+    if (index[root] == -1) {
+      index[root] = (int)comps.size();
+      comps.push_back(std::vector<int>());
+    }
+    comps[index[root]].push_back(order[i]);
+  }
+}
+
+uint64_t HittingSet::greedy(std::vector<int> &hs) {
+  sortCores();
+  hs.clear();
+  return greedy(order, hs);
+}
+
+// Completes 'hs' with the element with the most unhit cores of 'ks' per unit
+// of weight until every core is hit, then removes the elements, heaviest
+// first, whose cores are all hit by other elements. Every core of an element
+// that is not forbidden must be in 'ks' (e.g. 'ks' is a component).
+uint64_t HittingSet::greedy(const std::vector<int> &ks, std::vector<int> &hs) {
+  std::vector<int> elems;
+  std::vector<int> count(weight.size(), 0);
+  for (size_t i = 0; i < ks.size(); i++) {
+    bool open = false;
+    for (size_t j = 0; j < cores[ks[i]].size(); j++) {
+      int e = cores[ks[i]][j];
+      if (forbidden[e])
+        continue;
+      open = true;
+      if (count[e]++ == 0)
+        elems.push_back(e);
+    }
+    if (!open)
+      return UINT64_MAX;
+  }
+
+  std::vector<int> hits(cores.size(), 0);
+  int unhit = (int)ks.size();
+  std::vector<int> chosen;
+  chosen.swap(hs);
+  for (;;) {
+    int best_e = -1;
+    if (!chosen.empty()) {
+      best_e = chosen.back();
+      chosen.pop_back();
+    } else if (unhit > 0) {
+      double best_ratio = 0;
+      for (size_t i = 0; i < elems.size(); i++) {
+        int e = elems[i];
+        if (count[e] == 0)
+          continue;
+        double ratio = (double)count[e] / (double)weight[e];
+        if (best_e == -1 || ratio > best_ratio) {
+          best_e = e;
+          best_ratio = ratio;
+        }
+      }
+    }
+    if (best_e == -1)
+      break;
+
+    hs.push_back(best_e);
+    for (size_t i = 0; i < elemCores[best_e].size(); i++) {
+      int k = elemCores[best_e][i];
+      if (hits[k]++ > 0)
+        continue;
+      unhit--;
+      for (size_t j = 0; j < cores[k].size(); j++)
+        if (!forbidden[cores[k][j]])
+          count[cores[k][j]]--;
+    }
+  }
+
+  std::vector<std::pair<uint64_t, int> > heaviest;
+  for (size_t i = 0; i < hs.size(); i++)
+    heaviest.push_back(std::make_pair(weight[hs[i]], hs[i]));
+  std::sort(heaviest.rbegin(), heaviest.rend());
+  hs.clear();
+  uint64_t cost = 0;
+  for (size_t i = 0; i < heaviest.size(); i++) {
+    int e = heaviest[i].second;
+    bool redundant = true;
+    for (size_t j = 0; j < elemCores[e].size() && redundant; j++)
+      redundant = hits[elemCores[e][j]] > 1;
+    if (redundant) {
+      for (size_t j = 0; j < elemCores[e].size(); j++)
+        hits[elemCores[e][j]]--;
+      continue;
+    }
+    hs.push_back(e);
+    cost += weight[e];
+  }
+  return cost;
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  lagrangian : (ub : uint64_t) (reduced : std::vector<double>&)  ->  [double]
+  |
+  |  Description:
+  |
+  |    Lagrangian relaxation of the hitting set problem. For multipliers u of
+  |    the cores, the reduced cost of an element is its weight minus the
+  |    multipliers of its cores and the sum of the multipliers plus the
+  |    negative reduced costs is a lower bound. The multipliers start at a
+  |    packing of the cores and follow the subgradient (1 minus the elements
+  |    of the core with negative reduced cost) with the step of Held and Karp
+  |    towards 'ub', which is halved when the bound stalls. Every 5 steps the
+  |    elements with negative reduced cost are completed to a hitting set by
+  |    the greedy algorithm.
+  |
+  |  Post-conditions:
+  |    * Returns the best bound, or infinity if a core only has forbidden
+  |      elements, and 'reduced' gets the reduced costs of that bound: a
+  |      hitting set with element e costs at least the bound plus the reduced
+  |      cost of e, if it is positive.
+  |    * 'hs' is the cheapest of those hitting sets and 'cost' is its cost.
+  |
+  |________________________________________________________________________________________________@*/
+double HittingSet::lagrangian(uint64_t ub, std::vector<double> &reduced,
+                              std::vector<int> &hs, uint64_t &cost) {
+  sortCores();
+  std::vector<double> u(cores.size(), 0);
+  std::vector<double> rc(weight.begin(), weight.end());
+  double bound = 0;
+  for (size_t i = 0; i < order.size(); i++) {
+    std::vector<int> &core = cores[order[i]];
+    double m = -1;
+    for (size_t j = 0; j < core.size(); j++)
+      if (!forbidden[core[j]] && (m < 0 || rc[core[j]] < m))
+        m = rc[core[j]];
+    if (m < 0)
+      return std::numeric_limits<double>::infinity();
+    u[order[i]] = m;
+    bound += m;
+    for (size_t j = 0; j < core.size(); j++)
+      if (!forbidden[core[j]])
+        rc[core[j]] -= m;
+  }
+  reduced = rc;
+
+  double best_bound = bound;
+  double lambda = 2;
+  int stall = 0;
+  std::vector<int> g(cores.size());
+  cost = UINT64_MAX;
+  for (int it = 0; it < lagrangian_iterations && lambda > 0.005; it++) {
+    if (it % 5 == 0) {
+      std::vector<int> candidate;
+      for (size_t e = 0; e < rc.size(); e++)
+        if (!forbidden[e] && rc[e] < 0)
+          candidate.push_back((int)e);
+      uint64_t c = greedy(order, candidate);
+      if (c < cost) {
+        cost = c;
+        hs = candidate;
+      }
+    }
+
+    double norm = 0;
+    for (size_t k = 0; k < cores.size(); k++) {
+      g[k] = 1;
+      for (size_t j = 0; j < cores[k].size(); j++)
+        if (!forbidden[cores[k][j]] && rc[cores[k][j]] < 0)
+          g[k]--;
+      norm += (double)g[k] * g[k];
+    }
+    if (norm == 0 || bound >= (double)ub)
+      break;
+
+    double step = lambda * ((double)ub - bound) / norm;
+    bound = 0;
+    for (size_t e = 0; e < rc.size(); e++)
+      rc[e] = (double)weight[e];
+    for (size_t k = 0; k < cores.size(); k++) {
+      u[k] = std::max(0.0, u[k] + step * g[k]);
+      bound += u[k];
+      for (size_t j = 0; j < cores[k].size(); j++)
+        rc[cores[k][j]] -= u[k];
+    }
+    for (size_t e = 0; e < rc.size(); e++)
+      if (!forbidden[e] && rc[e] < 0)
+        bound += rc[e];
+
+    if (bound > best_bound) {
+      best_bound = bound;
+      reduced = rc;
+      stall = 0;
+    } else if (++stall == 20) {
+      lambda /= 2;
+      stall = 0;
+    }
+  }
+  return best_bound;
+}
+
+/************************************************************************************************
+ //
+ // Exact hitting set
+ //
+ ************************************************************************************************/
+
+void HittingSet::initWorker(Worker &w) {
+  w.chosen.assign(weight.size(), 0);
+  w.excluded.assign(weight.size(), 0);
+  w.hits.assign(cores.size(), 0);
+  w.residual.assign(weight.size(), 0);
+  w.chosen_list.clear();
+}
+
+void HittingSet::choose(Worker &w, int e, int inc) {
+  w.chosen[e] = inc > 0;
+  for (size_t i = 0; i < elemCores[e].size(); i++)
+    w.hits[elemCores[e][i]] += inc;
+  if (inc > 0)
+    w.chosen_list.push_back(e);
+  else
+    w.chosen_list.pop_back();
+}
+
+int HittingSet::branchingCore(Worker &w) {
+  int best_k = -1;
+  int best_open = INT_MAX;
+  for (size_t i = 0; i < active.size(); i++) {
+    int k = active[i];
+    if (w.hits[k] > 0)
+      continue;
+    int open = 0;
+    for (size_t j = 0; j < cores[k].size(); j++)
+      if (!forbidden[cores[k][j]] && !w.excluded[cores[k][j]])
+        open++;
+    if (open == 0)
+      return -2;
+    if (open < best_open) {
+      best_k = k;
+      best_open = open;
+    }
+  }
+  return best_k;
+}
+
+// Packing of the unhit cores with the weights of the elements that can still
+// be chosen. Stops as soon as the bound reaches 'limit'.
+uint64_t HittingSet::nodeBound(Worker &w, uint64_t limit) {
+  for (size_t i = 0; i < active.size(); i++) {
+    if (w.hits[active[i]] > 0)
+      continue;
+    std::vector<int> &core = cores[active[i]];
+    for (size_t j = 0; j < core.size(); j++)
+      w.residual[core[j]] = weight[core[j]];
+  }
+
+  uint64_t lb = 0;
+  for (size_t i = 0; i < active.size() && lb < limit; i++) {
+    if (w.hits[active[i]] > 0)
+      continue;
+    std::vector<int> &core = cores[active[i]];
+    uint64_t m = UINT64_MAX;
+    for (size_t j = 0; j < core.size(); j++)
+      if (!forbidden[core[j]] && !w.excluded[core[j]] && w.residual[core[j]] < m)
+        m = w.residual[core[j]];
+    lb += m;
+    for (size_t j = 0; j < core.size(); j++)
+      if (!forbidden[core[j]] && !w.excluded[core[j]])
+        w.residual[core[j]] -= m;
+  }
+  return lb;
+}
+
+static bool cheaperElement(const std::vector<std::pair<uint64_t, int> > &a,
+                           int x, int y) {
+  return a[x] < a[y];
+}
+
+// Cheapest elements first; among elements of the same weight, the ones that
+// hit more cores first.
+void HittingSet::branchingElements(Worker &w, int core,
+                                   std::vector<int> &elems) {
+  std::vector<std::pair<uint64_t, int> > keys;
+  elems.clear();
+  for (size_t i = 0; i < cores[core].size(); i++) {
+    int e = cores[core][i];
+    if (forbidden[e] || w.excluded[e])
+      continue;
+    int unhit = 0;
+    for (size_t j = 0; j < elemCores[e].size(); j++)
+      if (w.hits[elemCores[e][j]] == 0)
+        unhit++;
+    keys.push_back(std::make_pair(weight[e], -unhit));
+    elems.push_back(e);
+  }
+
+  std::vector<int> idx(elems.size());
+  for (size_t i = 0; i < idx.size(); i++)
+    idx[i] = (int)i;
+  std::sort(idx.begin(), idx.end(),
+            std::bind(cheaperElement, std::cref(keys), std::placeholders::_1,
+                      std::placeholders::_2));
+  std::vector<int> sorted(elems.size());
+  for (size_t i = 0; i < idx.size(); i++)
+    sorted[i] = elems[idx[i]];
+  elems.swap(sorted);
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  branch : (w : Worker&) (cost : uint64_t)  ->  [void]
+  |
+  |  Description:
+  |
+  |    Branches on the elements of the unhit core with the fewest elements
+  |    that can be chosen. The i-th branch chooses the i-th element and
+  |    excludes the previous ones, so that each hitting set is found once.
+  |
+  |  Post-conditions:
+  |    * 'best' and 'best_hs' are the best hitting set of the component found
+  |      by any thread.
+  |    * 'aborted' is set if the search reached the node limit.
+  |
+  |________________________________________________________________________________________________@*/
+void HittingSet::branch(Worker &w, uint64_t cost) {
+  if (aborted)
+    return;
+  if (++nodes - start_nodes > node_limit) {
+    aborted = true;
+    return;
+  }
+  if (cost >= best)
+    return;
+
+  int core = branchingCore(w);
+  if (core == -2)
+    return;
+  if (core == -1) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (cost < best) {
+      best = cost;
+      best_hs = w.chosen_list;
+      found = true;
+    }
+    return;
+  }
+
+  uint64_t incumbent = best;
+  if (cost >= incumbent || cost + nodeBound(w, incumbent - cost) >= incumbent)
+    return;
+
+  std::vector<int> elems;
+  branchingElements(w, core, elems);
+  for (size_t i = 0; i < elems.size(); i++) {
+    choose(w, elems[i], 1);
+    branch(w, cost + weight[elems[i]]);
+    choose(w, elems[i], -1);
+    w.excluded[elems[i]] = 1;
+  }
+  for (size_t i = 0; i < elems.size(); i++)
+    w.excluded[elems[i]] = 0;
+}
+
+void HittingSet::solveSubtrees(Worker *w, std::vector<int> *elems,
+                               std::atomic<int> *next) {
+  for (;;) {
+    int i = (*next)++;
+    if (i >= (int)elems->size())
+      return;
+    for (int j = 0; j < i; j++)
+      w->excluded[(*elems)[j]] = 1;
+    choose(*w, (*elems)[i], 1);
+    branch(*w, weight[(*elems)[i]]);
+    choose(*w, (*elems)[i], -1);
+    for (int j = 0; j < i; j++)
+      w->excluded[(*elems)[j]] = 0;
+  }
+}
+
+// Minimum-cost hitting set of the cores in 'active', starting from the greedy
+// one. With several threads, the branches of the root are shared by the
+// threads, each with its own state, and the incumbent is shared. If the node
+// limit is reached, 'hs' is the best hitting set found and 'lb' is the bound
+// of the root; otherwise 'lb' is equal to 'cost'.
+bool HittingSet::solveComponent(std::vector<int> &hs, uint64_t &cost,
+                                uint64_t &lb) {
+  found = false;
+  aborted = false;
+  start_nodes = nodes;
+  best_hs.clear();
+  best = greedy(active, best_hs);
+  if (best == UINT64_MAX)
+    return false;
+  found = true;
+
+  Worker root;
+  initWorker(root);
+  lb = nodeBound(root, UINT64_MAX);
+  int core = branchingCore(root);
+  if (core >= 0 && threads <= 1)
+    branch(root, 0);
+  else if (core >= 0 && lb < best) {
+    nodes++;
+    std::vector<int> elems;
+    branchingElements(root, core, elems);
+    std::vector<Worker> workers(threads);
+    std::vector<std::thread> pool;
+    std::atomic<int> next(0);
+    for (int t = 0; t < threads; t++) {
+      initWorker(workers[t]);
+      pool.push_back(std::thread(&HittingSet::solveSubtrees, this,
+                                 &workers[t], &elems, &next));
+    }
+    for (int t = 0; t < threads; t++)
+      pool[t].join();
+  }
+
+  hs = best_hs;
+  cost = best;
+  if (!aborted)
+    lb = cost;
+  return true;
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  solve : (bound : uint64_t) (hs : std::vector<int>&) (cost : uint64_t&)
+  |          (lb : uint64_t&)  ->  [bool]
+  |
+  |  Description:
+  |
+  |    Minimum-cost hitting set, solved by a branch and bound on each
+  |    component of the cores. The cores are only added, hence a component
+  |    with the same cores as in a previous call keeps its hitting set. A
+  |    component that reaches the node limit contributes its best hitting set
+  |    to 'hs' and the bound of its root to 'lb'.
+  |
+  |  Post-conditions:
+  |    * Returns false if no hitting set costs less than 'bound'.
+  |    * Otherwise 'hs' is a hitting set of cost 'cost' and 'lb' is a lower
+  |      bound of the minimum cost. If 'lb' is equal to 'cost', 'hs' is a
+  |      minimum-cost hitting set.
+  |
+  |________________________________________________________________________________________________@*/
+bool HittingSet::solve(uint64_t bound, std::vector<int> &hs, uint64_t &cost,
+                       uint64_t &lb) {
+  sortCores();
+  std::vector<std::vector<int> > comps;
+  components(comps);
+
+  hs.clear();
+  cost = 0;
+  lb = 0;
+  std::map<std::vector<int>, std::pair<uint64_t, std::vector<int> > > cache;
+  for (size_t c = 0; c < comps.size(); c++) {
+    uint64_t comp_cost, comp_lb;
+    std::vector<int> comp_hs;
+    std::map<std::vector<int>,
+             std::pair<uint64_t, std::vector<int> > >::iterator it =
+        solved.find(comps[c]);
+    if (it != solved.end()) {
+      comp_cost = comp_lb = it->second.first;
+      comp_hs = it->second.second;
+    } else {
+      active = comps[c];
+      if (!solveComponent(comp_hs, comp_cost, comp_lb))
+        return false;
+    }
+    if (comp_lb == comp_cost)
+      cache[comps[c]] = std::make_pair(comp_cost, comp_hs);
+    cost += comp_cost;
+    lb += comp_lb;
+    hs.insert(hs.end(), comp_hs.begin(), comp_hs.end());
+    if (lb >= bound)
+      return false;
+  }
+  solved.swap(cache);
+  return true;
+}
@@ -0,0 +1,143 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#ifndef HittingSet_h
+#define HittingSet_h
+
+#include <stdint.h>
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace openwbo {
+
+// Minimum-cost hitting sets of a set of cores over weighted elements (the
+// soft clauses). The exact solver splits the cores in components that share
+// no element and solves each one with a branch and bound that branches on the
+// elements of an unhit core and bounds each node with a packing of the unhit
+// cores; the subtrees of the root can be solved by several threads.
+class HittingSet {
+
+public:
+  HittingSet()
+      : lagrangian_iterations(300), node_limit(UINT64_MAX), threads(1), nodes(0), start_nodes(0),
+        aborted(false), best(0), found(false) {}
+
+  void init(const std::vector<uint64_t> &weights);
+  void addCore(const std::vector<int> &core);
+  // The element cannot be in a hitting set (its soft clause was hardened).
+  void forbid(int e) {
+    forbidden[e] = 1;
+    solved.clear();
+  }
+  bool isForbidden(int e) { return forbidden[e] != 0; }
+  int nCores() { return (int)cores.size(); }
+
+  // Threads of the exact solver (1 = no threads, 0 = one per core).
+  void setThreads(int n) {
+    threads = n > 0 ? n : (int)std::thread::hardware_concurrency();
+    if (threads < 1)
+      threads = 1;
+  }
+  // Nodes of the exact solver in all the calls.
+  uint64_t getNodes() { return nodes; }
+
+  // Greedy hitting set: adds the element with the most unhit cores per unit
+  // of weight until every core is hit. Returns the cost of 'hs', or
+  // UINT64_MAX if a core only has forbidden elements.
+  uint64_t greedy(std::vector<int> &hs);
+  // Hitting set 'hs' of cost 'cost' and lower bound 'lb' of the minimum
+  // cost. The hitting set is minimum ('lb' == 'cost') unless the exact
+  // solver reached the node limit in a component. Returns false if there is
+  // no hitting set whose cost is smaller than 'bound'.
+  bool solve(uint64_t bound, std::vector<int> &hs, uint64_t &cost,
+             uint64_t &lb);
+  // Nodes of the exact solver in each component of a call.
+  void setNodeLimit(uint64_t limit) { node_limit = limit; }
+  // Lower bound of the cost of a hitting set from a Lagrangian relaxation of
+  // the cores, improved towards 'ub'. 'reduced' gets the reduced cost of each
+  // element and 'hs' the cheapest hitting set built from the relaxation.
+  double lagrangian(uint64_t ub, std::vector<double> &reduced,
+                    std::vector<int> &hs, uint64_t &cost);
+
+protected:
+  // State of the search of a thread.
+  struct Worker {
+    std::vector<char> chosen;   // Element is in the hitting set.
+    std::vector<char> excluded; // Element was branched on by an ancestor.
+    std::vector<int> hits;      // Chosen elements of each core.
+    std::vector<uint64_t> residual;
+    std::vector<int> chosen_list;
+  };
+
+  void sortCores();
+  void components(std::vector<std::vector<int> > &comps);
+  uint64_t greedy(const std::vector<int> &ks, std::vector<int> &hs);
+  bool solveComponent(std::vector<int> &hs, uint64_t &cost, uint64_t &lb);
+
+  void initWorker(Worker &w);
+  void choose(Worker &w, int e, int inc);
+  // Unhit core with the fewest elements that can be chosen, -1 if every core
+  // is hit and -2 if a core cannot be hit.
+  int branchingCore(Worker &w);
+  uint64_t nodeBound(Worker &w, uint64_t limit);
+  // Elements of 'core' that can be chosen, cheapest first.
+  void branchingElements(Worker &w, int core, std::vector<int> &elems);
+  void branch(Worker &w, uint64_t cost);
+  void solveSubtrees(Worker *w, std::vector<int> *elems,
+                     std::atomic<int> *next);
+
+  std::vector<uint64_t> weight;
+  std::vector<char> forbidden;
+  std::vector<std::vector<int> > cores;
+  std::vector<std::vector<int> > elemCores; // Cores of each element.
+  std::vector<int> order; // Cores by increasing size (packing order).
+
+  std::vector<int> active; // Cores of the component being solved.
+  // Hitting set and cost of each component of the last call.
+  std::map<std::vector<int>, std::pair<uint64_t, std::vector<int> > > solved;
+
+  int lagrangian_iterations;
+  uint64_t node_limit;
+  int threads;
+  std::atomic<uint64_t> nodes;
+  uint64_t start_nodes;       // Nodes before the current component.
+  std::atomic<bool> aborted; // The node limit was reached.
+
+  // Incumbent of the exact solver.
+  std::mutex lock;
+  std::atomic<uint64_t> best;
+  bool found;
+  std::vector<int> best_hs;
+};
+
+} // namespace openwbo
+
+#endif
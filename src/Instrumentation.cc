@@ -0,0 +1,155 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "Instrumentation.h"
+
+#include <string.h>
+
+using namespace openwbo;
+
+namespace {
+const char *phase_names[_PHASE_COUNT_] = {
+    "parse",       "encode",     "load",   "lower_bound", "preprocess",
+    "solver_load", "split",      "guide_tree",    "search",      "sat",
+    "enumerate"};
+const char *counter_names[_COUNTER_COUNT_] = {
+    "variables", "hard_clauses", "soft_clauses", "sat_calls",
+    "cores",     "conflicts",    "propagations"};
+} // namespace
+
+Instrumentation::Instrumentation() : start(Clock::now()) {
+  for (int i = 0; i < _PHASE_COUNT_; i++) {
+    phase_time[i] = 0;
+    phase_calls[i] = 0;
+  }
+  for (int i = 0; i < _COUNTER_COUNT_; i++)
+    counters[i] = 0;
+}
+
+Instrumentation &Instrumentation::get() {
+  static Instrumentation instance;
+  return instance;
+}
+
+void Instrumentation::addTime(int phase, double seconds) {
+  std::lock_guard<std::mutex> guard(lock);
+  phase_time[phase] += seconds;
+  phase_calls[phase]++;
+}
+
+void Instrumentation::startPhase(int phase) { phase_start[phase] = now(); }
+
+void Instrumentation::stopPhase(int phase) {
+  addTime(phase, since(phase_start[phase]));
+}
+
+void Instrumentation::count(int counter, uint64_t n) {
+  std::lock_guard<std::mutex> guard(lock);
+  counters[counter] += n;
+}
+
+void Instrumentation::set(int counter, uint64_t n) {
+  std::lock_guard<std::mutex> guard(lock);
+  counters[counter] = n;
+}
+
+void Instrumentation::satCall(double seconds, int result, uint64_t conflicts,
+                              uint64_t propagations, int assumptions) {
+  std::lock_guard<std::mutex> guard(lock);
+  SatCall call = {seconds, result, conflicts, propagations, assumptions};
+  sat_calls.push_back(call);
+  phase_time[_PHASE_SAT_] += seconds;
+  phase_calls[_PHASE_SAT_]++;
+  counters[_COUNTER_SAT_CALLS_]++;
+  if (result == 0)
+    counters[_COUNTER_CORES_]++;
+  counters[_COUNTER_CONFLICTS_] += conflicts;
+  counters[_COUNTER_PROPAGATIONS_] += propagations;
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  writeJSON : (file : const char *)  ->  [bool]
+  |
+  |  Description:
+  |
+  |    Writes the report: wall time since the start, time and number of calls
+  |    of each phase, counters and one entry per SAT call.
+  |
+  |    When the time limit exceeds it is called by the exit handler on the
+  |    thread of Progress, never in a signal handler, so it waits for the
+  |    lock like the other methods: the search only holds it to update the
+  |    counters.
+  |
+  |________________________________________________________________________________________________@*/
+bool Instrumentation::writeJSON(const char *file) {
+  std::lock_guard<std::mutex> guard(lock);
+
+  FILE *out = strcmp(file, "-") == 0 ? stdout : fopen(file, "w");
+  if (out == NULL)
+    return false;
+
+#ifdef INSTRUMENTATION
+  fprintf(out, "{\n  \"instrumented\": true,\n");
+#else
+  fprintf(out, "{\n  \"instrumented\": false,\n");
+#endif
+  fprintf(out, "  \"wall_time\": %.6f,\n", since(start));
+
+  fprintf(out, "  \"phases\": {\n");
+  for (int i = 0; i < _PHASE_COUNT_; i++)
+    fprintf(out, "    \"%s\": {\"time\": %.6f, \"calls\": %llu}%s\n",
+            phase_names[i], phase_time[i], (unsigned long long)phase_calls[i],
+            i + 1 < _PHASE_COUNT_ ? "," : "");
+  fprintf(out, "  },\n");
+
+  fprintf(out, "  \"counters\": {\n");
+  for (int i = 0; i < _COUNTER_COUNT_; i++)
+    fprintf(out, "    \"%s\": %llu%s\n", counter_names[i],
+            (unsigned long long)counters[i], i + 1 < _COUNTER_COUNT_ ? "," : "");
+  fprintf(out, "  },\n");
+
+  fprintf(out, "  \"sat_calls\": [");
+  size_t calls = sat_calls.size();
+  for (size_t i = 0; i < calls; i++) {
+    const SatCall &c = sat_calls[i];
+    fprintf(out,
+            "%s\n    {\"time\": %.6f, \"result\": \"%s\", \"conflicts\": %llu, "
+            "\"propagations\": %llu, \"assumptions\": %d}",
+            i > 0 ? "," : "", c.time,
+            c.result == 1 ? "SAT" : c.result == 0 ? "UNSAT" : "UNKNOWN",
+            (unsigned long long)c.conflicts,
+            (unsigned long long)c.propagations, c.assumptions);
+  }
+  fprintf(out, "%s]\n}\n", calls == 0 ? "" : "\n  ");
+
+  if (out != stdout)
+    fclose(out);
+  else
+    fflush(out);
+  return true;
+}
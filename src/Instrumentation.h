@@ -0,0 +1,152 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#ifndef Instrumentation_h
+#define Instrumentation_h
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+namespace openwbo {
+
+// Phases of the pipeline that are timed.
+enum {
+  _PHASE_PARSE_ = 0,
+  _PHASE_ENCODE_,
+  _PHASE_LOAD_,
+  _PHASE_LOWER_BOUND_,
+  _PHASE_PREPROCESS_,
+  _PHASE_SOLVER_LOAD_,
+  _PHASE_SPLIT_,
+  _PHASE_GUIDE_TREE_,
+  _PHASE_SEARCH_,
+  _PHASE_SAT_,
+  _PHASE_ENUMERATE_,
+  _PHASE_COUNT_
+};
+
+// Counters that are set or incremented during the run.
+enum {
+  _COUNTER_VARIABLES_ = 0,
+  _COUNTER_HARD_,
+  _COUNTER_SOFT_,
+  _COUNTER_SAT_CALLS_,
+  _COUNTER_CORES_,
+  _COUNTER_CONFLICTS_,
+  _COUNTER_PROPAGATIONS_,
+  _COUNTER_COUNT_
+};
+
+// Collects the time spent in each phase (on a monotonic clock), counters and
+// the statistics of every SAT call, and writes them as a JSON report. The
+// calls are only compiled in with INSTRUMENTATION defined (make
+// INSTRUMENTATION=1); otherwise the macros below expand to nothing and the
+// report only says that the build is not instrumented.
+class Instrumentation {
+
+public:
+  typedef std::chrono::steady_clock Clock;
+
+  static Instrumentation &get();
+
+  static Clock::time_point now() { return Clock::now(); }
+  static double since(Clock::time_point t) {
+    return std::chrono::duration<double>(Clock::now() - t).count();
+  }
+
+  void addTime(int phase, double seconds);
+  void startPhase(int phase);
+  void stopPhase(int phase);
+
+  void count(int counter, uint64_t n = 1);
+  void set(int counter, uint64_t n);
+
+  // Records a SAT call ('result' is 1 for SAT, 0 for UNSAT, -1 otherwise).
+  void satCall(double seconds, int result, uint64_t conflicts,
+               uint64_t propagations, int assumptions);
+
+  // Writes the report to 'file' ("-" for the standard output).
+  bool writeJSON(const char *file);
+
+protected:
+  Instrumentation();
+
+  struct SatCall {
+    double time;
+    int result;
+    uint64_t conflicts;
+    uint64_t propagations;
+    int assumptions;
+  };
+
+  std::mutex lock;
+  Clock::time_point start;
+  double phase_time[_PHASE_COUNT_];
+  uint64_t phase_calls[_PHASE_COUNT_];
+  Clock::time_point phase_start[_PHASE_COUNT_];
+  uint64_t counters[_COUNTER_COUNT_];
+  std::vector<SatCall> sat_calls;
+};
+
+// Adds the time from its construction to its destruction to a phase.
+class ScopedTimer {
+public:
+  ScopedTimer(int phase) : phase(phase), start(Instrumentation::now()) {}
+  ~ScopedTimer() {
+    Instrumentation &instr = Instrumentation::get();
+    instr.addTime(phase, instr.since(start));
+  }
+
+protected:
+  int phase;
+  Instrumentation::Clock::time_point start;
+};
+
+} // namespace openwbo
+
+#ifdef INSTRUMENTATION
+#define INSTR_CONCAT_(a, b) a##b
+#define INSTR_CONCAT(a, b) INSTR_CONCAT_(a, b)
+#define INSTR_TIMER(phase)                                                     \
+  openwbo::ScopedTimer INSTR_CONCAT(instr_timer_, __LINE__)(phase)
+#define INSTR_START(phase) openwbo::Instrumentation::get().startPhase(phase)
+#define INSTR_STOP(phase) openwbo::Instrumentation::get().stopPhase(phase)
+#define INSTR_COUNT(counter, n) openwbo::Instrumentation::get().count(counter, n)
+#define INSTR_SET(counter, n) openwbo::Instrumentation::get().set(counter, n)
+#else
+#define INSTR_TIMER(phase)
+#define INSTR_START(phase)
+#define INSTR_STOP(phase)
+#define INSTR_COUNT(counter, n)
+#define INSTR_SET(counter, n)
+#endif
+
+#endif
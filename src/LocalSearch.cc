@@ -0,0 +1,315 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "LocalSearch.h"
+
+using namespace openwbo;
+
+namespace {
+// Improving variables sampled to pick the one to flip (best from multiple
+// selections).
+const int bms_samples = 15;
+} // namespace
+
+LocalSearch::LocalSearch(MaxSATFormula *formula)
+    : unsat_cost(0), step(0), random_state(91648253), total_flips(0),
+      improvements(0) {
+  load(formula);
+}
+
+void LocalSearch::load(MaxSATFormula *formula) {
+  nVars = 0;
+  nHard = formula->nHard();
+  nSoft = formula->nSoft();
+  clause_start.clear();
+  clause_lits.clear();
+  soft_weight.clear();
+  supported = formula->getFormat() == _FORMAT_MAXSAT_ &&
+              formula->nCard() == 0 && formula->nPB() == 0;
+  if (!supported)
+    return;
+
+  clause_start.push_back(0);
+  for (int i = 0; i < formula->nHard(); i++) {
+    LitSpan clause = formula->getHardClause(i);
+    for (int j = 0; j < clause.size(); j++)
+      clause_lits.push_back(clause[j]);
+    clause_start.push_back(clause_lits.size());
+  }
+  for (int i = 0; i < formula->nSoft(); i++) {
+    LitSpan clause = formula->getSoftClause(i);
+    for (int j = 0; j < clause.size(); j++)
+      clause_lits.push_back(clause[j]);
+    clause_start.push_back(clause_lits.size());
+    soft_weight.push_back(formula->getSoftWeight(i));
+  }
+  for (size_t i = 0; i < clause_lits.size(); i++)
+    if (var(clause_lits[i]) >= nVars)
+      nVars = var(clause_lits[i]) + 1;
+
+  // Occurrence lists by counting sort of the literals.
+  int nClauses = clause_start.size() - 1;
+  occ_start.assign(2 * nVars + 1, 0);
+  for (size_t i = 0; i < clause_lits.size(); i++)
+    occ_start[toInt(clause_lits[i]) + 1]++;
+  for (int l = 0; l < 2 * nVars; l++)
+    occ_start[l + 1] += occ_start[l];
+  occ_clauses.resize(clause_lits.size());
+  std::vector<int> next(occ_start.begin(), occ_start.end() - 1);
+  for (int c = 0; c < nClauses; c++)
+    for (int i = clause_start[c]; i < clause_start[c + 1]; i++)
+      occ_clauses[next[toInt(clause_lits[i])]++] = c;
+
+  value.resize(nVars);
+  frozen.resize(nVars);
+  score.resize(nVars);
+  stamp.resize(nVars);
+  good_pos.resize(nVars);
+  weight.resize(nClauses);
+  sat_count.resize(nClauses);
+  sat_var.resize(nClauses);
+  unsat_pos.resize(nClauses);
+}
+
+uint64_t LocalSearch::nextRandom() {
+  random_state ^= random_state >> 12;
+  random_state ^= random_state << 25;
+  random_state ^= random_state >> 27;
+  return random_state * 2685821657736338717ULL;
+}
+
+void LocalSearch::setScore(int v, int64_t delta) {
+  score[v] += delta;
+  bool is_good = score[v] > 0 && !frozen[v];
+  if (is_good && good_pos[v] < 0) {
+    good_pos[v] = good.size();
+    good.push_back(v);
+  } else if (!is_good && good_pos[v] >= 0) {
+    good[good_pos[v]] = good.back();
+    good_pos[good.back()] = good_pos[v];
+    good.pop_back();
+    good_pos[v] = -1;
+  }
+}
+
+void LocalSearch::falsify(int c) {
+  std::vector<int> &unsat = c < nHard ? unsat_hard : unsat_soft;
+  unsat_pos[c] = unsat.size();
+  unsat.push_back(c);
+  if (c >= nHard)
+    unsat_cost += soft_weight[c - nHard];
+}
+
+void LocalSearch::satisfy(int c) {
+  std::vector<int> &unsat = c < nHard ? unsat_hard : unsat_soft;
+  unsat[unsat_pos[c]] = unsat.back();
+  unsat_pos[unsat.back()] = unsat_pos[c];
+  unsat.pop_back();
+  if (c >= nHard)
+    unsat_cost -= soft_weight[c - nHard];
+}
+
+void LocalSearch::initSearch(vec<lbool> &start, vec<Lit> &fixed) {
+  for (int v = 0; v < nVars; v++) {
+    value[v] = v < start.size() && start[v] == l_True;
+    frozen[v] = 0;
+    score[v] = 0;
+    stamp[v] = 0;
+    good_pos[v] = -1;
+  }
+  for (int i = 0; i < fixed.size(); i++)
+    if (var(fixed[i]) < nVars)
+      frozen[var(fixed[i])] = 1;
+  good.clear();
+  unsat_hard.clear();
+  unsat_soft.clear();
+  unsat_cost = 0;
+
+  for (int c = 0; c < (int)weight.size(); c++) {
+    weight[c] = 1;
+    sat_count[c] = 0;
+    for (int i = clause_start[c]; i < clause_start[c + 1]; i++)
+      if (isTrue(clause_lits[i])) {
+        sat_count[c]++;
+        sat_var[c] = var(clause_lits[i]);
+      }
+    if (sat_count[c] == 0) {
+      falsify(c);
+      for (int i = clause_start[c]; i < clause_start[c + 1]; i++)
+        score[var(clause_lits[i])] += weight[c];
+    } else if (sat_count[c] == 1)
+      score[sat_var[c]] -= weight[c];
+  }
+  for (int v = 0; v < nVars; v++)
+    setScore(v, 0);
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  flip : (v : int)  ->  [void]
+  |
+  |  Description:
+  |
+  |    Flips 'v' and updates the number of true literals of its clauses and
+  |    the scores of their variables. A clause adds its weight to the score
+  |    of every variable while it is falsified and subtracts it from the score
+  |    of its only true variable.
+  |
+  |________________________________________________________________________________________________@*/
+void LocalSearch::flip(int v) {
+  value[v] = !value[v];
+  stamp[v] = step;
+  Lit t = mkLit(v, !value[v]);
+
+  for (int i = occ_start[toInt(t)]; i < occ_start[toInt(t) + 1]; i++) {
+    int c = occ_clauses[i];
+    if (sat_count[c] == 0) {
+      satisfy(c);
+      for (int j = clause_start[c]; j < clause_start[c + 1]; j++)
+        setScore(var(clause_lits[j]), -weight[c]);
+      setScore(v, -weight[c]);
+      sat_var[c] = v;
+    } else if (sat_count[c] == 1)
+      setScore(sat_var[c], weight[c]);
+    sat_count[c]++;
+  }
+
+  for (int i = occ_start[toInt(~t)]; i < occ_start[toInt(~t) + 1]; i++) {
+    int c = occ_clauses[i];
+    sat_count[c]--;
+    if (sat_count[c] == 0) {
+      falsify(c);
+      for (int j = clause_start[c]; j < clause_start[c + 1]; j++)
+        setScore(var(clause_lits[j]), weight[c]);
+      setScore(v, weight[c]);
+    } else if (sat_count[c] == 1) {
+      int j = clause_start[c];
+      while (!isTrue(clause_lits[j]))
+        j++;
+      sat_var[c] = var(clause_lits[j]);
+      setScore(sat_var[c], -weight[c]);
+    }
+  }
+}
+
+// Increases the weight of the falsified hard clauses and, up to their real
+// weight, of the falsified soft clauses.
+void LocalSearch::updateWeights() {
+  for (size_t i = 0; i < unsat_hard.size(); i++) {
+    int c = unsat_hard[i];
+    weight[c]++;
+    for (int j = clause_start[c]; j < clause_start[c + 1]; j++)
+      setScore(var(clause_lits[j]), 1);
+  }
+  for (size_t i = 0; i < unsat_soft.size(); i++) {
+    int c = unsat_soft[i];
+    if ((uint64_t)weight[c] >= soft_weight[c - nHard])
+      continue;
+    weight[c]++;
+    for (int j = clause_start[c]; j < clause_start[c + 1]; j++)
+      setScore(var(clause_lits[j]), 1);
+  }
+}
+
+int LocalSearch::pickVar() {
+  int best = -1;
+  if (!good.empty()) {
+    int samples = good.size() <= (size_t)bms_samples ? good.size() : bms_samples;
+    for (int i = 0; i < samples; i++) {
+      int v = samples == (int)good.size() ? good[i]
+                                          : good[nextRandom() % good.size()];
+      if (best < 0 || score[v] > score[best] ||
+          (score[v] == score[best] && stamp[v] < stamp[best]))
+        best = v;
+    }
+    return best;
+  }
+
+  updateWeights();
+  std::vector<int> &unsat = unsat_hard.empty() ? unsat_soft : unsat_hard;
+  if (unsat.empty())
+    return -1;
+  int c = unsat[nextRandom() % unsat.size()];
+  for (int j = clause_start[c]; j < clause_start[c + 1]; j++) {
+    int v = var(clause_lits[j]);
+    if (!frozen[v] && (best < 0 || score[v] > score[best] ||
+                       (score[v] == score[best] && stamp[v] < stamp[best])))
+      best = v;
+  }
+  return best;
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  improve : (start : vec<lbool>&) (fixed : vec<Lit>&) (flips : int)
+  |            (cost : uint64_t&) (best : vec<lbool>&)  ->  [bool]
+  |
+  |  Description:
+  |
+  |    SATLike search from the model 'start'. All clauses start with weight
+  |    1. While some unfrozen variable has a positive score, the best of a
+  |    sample of them is flipped (the least recently flipped on ties);
+  |    otherwise the weights of the falsified clauses are increased and the
+  |    best variable of a random falsified clause (hard if there is one) is
+  |    flipped. Every assignment that satisfies the hard clauses and is
+  |    cheaper than the best one is kept.
+  |
+  |  Post-conditions:
+  |    * If it returns true, 'best' satisfies the hard clauses and the literals
+  |      of 'fixed', and 'cost' is its cost.
+  |
+  |________________________________________________________________________________________________@*/
+bool LocalSearch::improve(vec<lbool> &start, vec<Lit> &fixed, int flips,
+                          uint64_t &cost, vec<lbool> &best) {
+  if (!supported || flips <= 0)
+    return false;
+
+  initSearch(start, fixed);
+  uint64_t best_cost = cost;
+  bool found = false;
+  for (step = 1; step <= (uint64_t)flips && best_cost > 0; step++) {
+    int v = pickVar();
+    if (v < 0)
+      break;
+    flip(v);
+    total_flips++;
+    if (unsat_hard.empty() && unsat_cost < best_cost) {
+      best_cost = unsat_cost;
+      best_value = value;
+      found = true;
+    }
+  }
+  if (!found)
+    return false;
+
+  start.copyTo(best);
+  for (int v = 0; v < nVars && v < best.size(); v++)
+    best[v] = best_value[v] ? l_True : l_False;
+  cost = best_cost;
+  improvements++;
+  return true;
+}
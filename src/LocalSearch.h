@@ -0,0 +1,123 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#ifndef LocalSearch_h
+#define LocalSearch_h
+
+#include "MaxSATFormula.h"
+
+#include <vector>
+
+using NSPACE::lbool;
+
+namespace openwbo {
+
+// Local search over the hard and soft clauses of a MaxSAT formula with
+// dynamic clause weights (SATLike). It starts from a model of the hard
+// clauses, flips the variable with the best weighted score among a sample of
+// the improving ones and, when there is none, increases the weights of the
+// falsified clauses and flips a variable of one of them. The cardinality and
+// PB constraints of the formula are not supported.
+class LocalSearch {
+
+public:
+  LocalSearch(MaxSATFormula *formula);
+
+  // Takes a new snapshot of the clauses of 'formula'. The statistics are
+  // kept.
+  void load(MaxSATFormula *formula);
+  // True if the clauses of 'formula' are those of the snapshot. Algorithms
+  // that add clauses to the formula during the search make it stale.
+  bool isSnapshotOf(MaxSATFormula *formula) {
+    return formula->nHard() == nHard && formula->nSoft() == nSoft;
+  }
+
+  bool isSupported() { return supported; }
+
+  // Runs at most 'flips' flips from 'start', a model of the hard clauses of
+  // cost 'cost', without flipping the variables of 'fixed'. Returns true if
+  // it found a model of the hard clauses whose cost is smaller than 'cost';
+  // 'best' is then that model (extended with the other variables of
+  // 'start') and 'cost' its cost.
+  bool improve(vec<lbool> &start, vec<Lit> &fixed, int flips, uint64_t &cost,
+               vec<lbool> &best);
+
+  // Flips and improved models in all the calls.
+  uint64_t getFlips() { return total_flips; }
+  uint64_t getImprovements() { return improvements; }
+
+protected:
+  void initSearch(vec<lbool> &start, vec<Lit> &fixed);
+  void flip(int v);
+  void updateWeights();
+  int pickVar(); // Variable to flip, or -1 if there is none.
+  uint64_t nextRandom();
+
+  void setScore(int v, int64_t delta);
+  void falsify(int c);
+  void satisfy(int c);
+
+  bool isTrue(Lit l) { return value[var(l)] != sign(l); }
+
+  bool supported;
+  int nVars;
+  int nHard; // The first 'nHard' clauses are hard, the others are soft.
+  int nSoft;
+
+  // Literals of the clauses (clause_start[c] .. clause_start[c+1]) and the
+  // clauses of each literal (occ_start[toInt(l)] .. occ_start[toInt(l)+1]).
+  std::vector<int> clause_start;
+  std::vector<Lit> clause_lits;
+  std::vector<int> occ_start;
+  std::vector<int> occ_clauses;
+  std::vector<uint64_t> soft_weight; // Weight of the soft clause nHard + i.
+
+  // State of the search.
+  std::vector<char> value;
+  std::vector<char> frozen;
+  std::vector<int64_t> score;   // Weight made minus weight broken by a flip.
+  std::vector<uint64_t> stamp;  // Flip of the last change of the variable.
+  std::vector<int64_t> weight;  // Dynamic weight of each clause.
+  std::vector<int> sat_count;   // True literals of each clause.
+  std::vector<int> sat_var;     // The true variable if sat_count is 1.
+  std::vector<int> unsat_hard;  // Falsified hard clauses.
+  std::vector<int> unsat_soft;  // Falsified soft clauses.
+  std::vector<int> unsat_pos;   // Position of a clause in its unsat list.
+  std::vector<int> good;        // Unfrozen variables with a positive score.
+  std::vector<int> good_pos;    // Position in 'good' (-1 if absent).
+  std::vector<char> best_value; // Best assignment of the call.
+  uint64_t unsat_cost;          // Weight of the falsified soft clauses.
+  uint64_t step;
+
+  uint64_t random_state;
+  uint64_t total_flips;
+  uint64_t improvements;
+};
+
+} // namespace openwbo
+
+#endif
@@ -34,9 +34,11 @@
 #include <signal.h>
 #include <zlib.h>
 
+#include <atomic>
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <sstream>
 #include <stdlib.h>
 #include <string>
 #include <vector>
@@ -47,18 +49,27 @@
 #include "core/Solver.h"
 #endif
 
+#include "Instrumentation.h"
+#include "Progress.h"
 #include "MaxSAT.h"
 #include "MaxTypes.h"
 #include "ParserMaxSAT.h"
 #include "ParserPB.h"
 
 // Algorithms
+#include "algorithms/Alg_CoreBoosted.h"
+#include "algorithms/Alg_IHS.h"
 #include "algorithms/Alg_LinearSU.h"
 #include "algorithms/Alg_MSU3.h"
 #include "algorithms/Alg_OLL.h"
 #include "algorithms/Alg_PartMSU3.h"
+#include "algorithms/Alg_Portfolio.h"
 #include "algorithms/Alg_WBO.h"
 
+// Game of Life
+#include "life/Life_Encoding.h"
+#include "life/Life_LowerBound.h"
+
 #define VER1_(x) #x
 #define VER_(x) VER1_(x)
 #define SATVER VER_(SOLVERNAME)
@@ -75,15 +86,26 @@ using namespace openwbo;
 
 //=================================================================================================
 
-static MaxSAT *mxsolver;
+static std::atomic<MaxSAT *> mxsolver(NULL);
 int lin, col;
-
-static void SIGINT_exit(int signum) { //Modified to print solution when the time limit exceeds
+//Written with stdout locked, since they are read by the exit handler
+static bool enumerating = false;
+static bool finished = false;
+static int nbEnumerated = 0;
+static bool reportStats = false;
+static int nbVars = 0, nbHard = 0, nbSoft = 0;
+static const char *reportFile = NULL;
+
+// Prints the predecessor stored in the solver, or an empty board if no model
+// was found.
+static void printBoard(MaxSAT *solver) {
+	vec<lbool> model;
+	solver->copyModel(model);
 	printf("%d %d\n", lin, col);
-	if (mxsolver->getValue(1) != 0){
+	if (model.size() > 0){
 		for (int i = 0; i < lin; i++){
 			for (int j = 0; j < col; j++){
-				if (mxsolver->getValue(i*col+j) < 1)
+				if (i*col+j >= model.size() || model[i*col+j] != l_True)
 					printf ("0 ");
 				else
 					printf ("1 ");
@@ -98,7 +120,80 @@ static void SIGINT_exit(int signum) { //Modified to print solution when the time
 			printf ("\n");
 		}
 	}
-  exit(0);
+}
+
+// Rejects a combination of options that the chosen algorithm does not support.
+static void rejectOptions(const char *message) {
+	printf("c Error: %s.\n", message);
+	printf("s UNKNOWN\n");
+	exit(_ERROR_);
+}
+
+// Streams every predecessor found during the enumeration.
+static void printEnumeratedBoard(MaxSAT *solver, uint64_t cost) {
+	flockfile(stdout);
+	printf("c predecessor %d live cells %" PRIu64 "\n", ++nbEnumerated, cost);
+	printBoard(solver);
+	fflush(stdout);
+	funlockfile(stdout);
+}
+
+// Peak resident set size of the process in MB. The peak virtual size
+// (memUsedPeak) also counts the reserved stacks of the threads and the
+// shadow memory of the sanitizers.
+static double peakResidentMemory() {
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return -1;
+	return (double)usage.ru_maxrss / 1024;
+}
+
+// Prints one line with the statistics of the last search (read by
+// tools/bench.sh). Times are CPU seconds since the start and are negative if
+// the event did not happen. Without 'sample' the memory is not walked again,
+// since the search may still be running.
+static void printSearchStats(MaxSAT *solver, int status, double optimum_time,
+		bool sample = true) {
+	const char *name = "UNKNOWN";
+	if (status == _OPTIMUM_) name = "OPTIMUM";
+	else if (status == _SATISFIABLE_) name = "SATISFIABLE";
+	else if (status == _UNSATISFIABLE_) name = "UNSATISFIABLE";
+	double first_model = solver->getFirstModelTime();
+	int64_t cost = first_model < 0 ? -1 : (int64_t)solver->getBestCost();
+	printf("c stats status %s first-model %.3f optimum %.3f cost %" PRId64
+			" vars %d hard %d soft %d peak-rss %.1f\n", name, first_model,
+			optimum_time, cost, nbVars, nbHard, nbSoft, peakResidentMemory());
+	solver->printMemory(sample);
+	solver->printProfile();
+	solver->printCoreReduction();
+	solver->printLocalSearch();
+}
+
+//Prints the best solution when the time limit exceeds or on SIGTERM. It runs
+//on the thread of Progress, not in the signal handler, while the search goes
+//on in the other threads; it ends the process with _exit, so that no
+//destructor runs under them
+static void exitOnSignal() {
+	flockfile(stdout);
+	//The answer of the last query was already printed
+	if (finished){
+		funlockfile(stdout);
+		return;
+	}
+	//The solver only exists once the formula is built
+	MaxSAT *solver = mxsolver;
+	//The enumerated predecessors were already printed
+	if (solver != NULL && !enumerating)
+		printBoard(solver);
+	if (solver != NULL && reportStats)
+		printSearchStats(solver, solver->getFirstModelTime() < 0 ?
+				_UNKNOWN_ : _SATISFIABLE_, -1, false);
+	if (reportFile != NULL)
+		Instrumentation::get().writeJSON(reportFile);
+	if (solver != NULL)
+		solver->writeCheckpoint();
+	fflush(NULL);
+	_exit(0);
 }
 
 //=================================================================================================
@@ -154,12 +249,27 @@ void limitTime(uint32_t /*max_cpu_time*/)
 }
 #endif
 
-void addLiterals(MaxSATFormula* maxsat_formula, std::initializer_list<Lit> literals) {
-	vec<Lit> clause;
-	for (const auto& lit : literals) {
-		clause.push(lit);  // Add each literal to the vec<Lit>
+// Reads a file of forced (1) and forbidden (0) predecessor cells, where '.'
+// leaves the cell free. Each block of lin x col tokens is one query.
+static bool readMasks(const char *file, vec<vec<Lit> > &queries) {
+	std::ifstream in(file);
+	if (!in.is_open())
+		return false;
+
+	std::string token;
+	int cell = 0;
+	while (in >> token){
+		if (cell == 0)
+			queries.push();
+		if (token == "1")
+			queries.last().push(mkLit(cell, false));
+		else if (token == "0")
+			queries.last().push(mkLit(cell, true));
+		else if (token != ".")
+			return false;
+		cell = (cell + 1) % (lin*col);
 	}
-	maxsat_formula->addHardClause(clause);
+	return cell == 0;
 }
 
 //=================================================================================================
@@ -185,6 +295,17 @@ int main(int argc, char **argv) {
 			"Limit on memory usage in megabytes.\n", 8192,
 			IntRange(0, INT32_MAX));
 
+	IntOption algorithm("Open-WBO", "algorithm",
+			"Search algorithm "
+			"(0=wbo,1=linear-su,2=msu3,3=part-msu3,4=oll,5=portfolio,"
+			"6=core-boosted,7=ihs).\n",
+			_ALGORITHM_PART_MSU3_, IntRange(0, 7));
+
+	IntOption weight_strategy("WBO", "weight-strategy",
+			"Weight strategy of WBO for weighted formulas (0=none, "
+			"1=weight-based, 2=diversity-based).\n",
+			0, IntRange(0, 2));
+
 	IntOption partition_strategy("PartMSU3", "partition-strategy",
 			"Partition strategy (0=sequential, "
 			"1=sequential-sorted, 2=binary)"
@@ -201,392 +322,481 @@ int main(int argc, char **argv) {
 			"1=totalizer, 2=modulo totalizer).\n",
 			1, IntRange(0, 2));
 
+	BoolOption unit_relax("Open-WBO", "unit-relax",
+			"Use the negated literal of unit soft clauses as relaxation "
+			"literal instead of a fresh variable.\n",
+			true);
+
+	IntOption lower_bound("Life", "lower-bound",
+			"Lower bound from disjoint live-cell windows (0=none, "
+			"1=greedy, 2=exact on small components).\n",
+			2, IntRange(0, 2));
+
+	BoolOption lower_bound_card("Life", "lower-bound-card",
+			"Add the windows of the lower bound as cardinality constraints.\n",
+			false);
+
+	IntOption enum_models("Life", "enum",
+			"Enumerate up to this many predecessors in non-decreasing number "
+			"of live cells (0=single predecessor).\n",
+			0, IntRange(0, INT32_MAX));
+
+	BoolOption enum_optimal("Life", "enum-optimal",
+			"Enumerate all optimal predecessors (up to -enum if set).\n",
+			false);
+
+	IntOption threads("Life", "threads",
+			"Number of threads that generate the formula (0=one per core).\n",
+			0, IntRange(0, 1024));
+
+	BoolOption stats("Life", "stats",
+			"Print a line with the time to the first model and to the optimum, "
+			"the cost, the formula size and the peak memory of each search, and "
+			"the memory used by each component of the solver.\n",
+			false);
+
+	IntOption memory_interval("Life", "memory-interval",
+			"Sample the memory of each component every N seconds during the "
+			"search to keep its peak for -stats (0=only at the end).\n",
+			0, IntRange(0, INT32_MAX));
+
+	StringOption mask_file("Life", "mask",
+			"File with masks of forced/forbidden predecessor cells. Each mask "
+			"is solved as a query under assumptions (-algorithm=3 or 4).\n");
+
+	StringOption report("Life", "report",
+			"Write a JSON report with the time of each phase, the counters and "
+			"the SAT calls to this file ('-' for stdout). Only the wall time is "
+			"reported unless built with INSTRUMENTATION=1.\n");
+
+	StringOption trace_file("Life", "trace",
+			"Write a CSV trace with the bounds, the core size and the SAT solver "
+			"statistics of each SAT call to this file.\n");
+
+	IntOption progress("Life", "progress",
+			"Print the bounds, SAT calls and cores every N seconds (0=only "
+			"when the process receives SIGUSR1, -1=never).\n",
+			0, IntRange(-1, INT32_MAX));
+
+	StringOption progress_file("Life", "progress-file",
+			"Append the progress lines to this file instead of stderr.\n");
+
+	StringOption portfolio_engines("Life", "portfolio",
+			"Engines of the portfolio (-algorithm=5) that run in parallel, "
+			"separated by commas: part, oll, msu3, linear, wbo, boosted, ihs. LinearSU "
+			"uses the -cardinality encoding, the others the totalizer.\n",
+			"part,oll,msu3,linear");
+
+	IntOption core_trim("Life", "core-trim",
+			"Solve again under the assumptions of each core of MSU3 and PartMSU3 "
+			"until it stops shrinking, at most N times (0=off).\n",
+			0, IntRange(0, INT32_MAX));
+
+	IntOption core_min_budget("Life", "core-min-budget",
+			"Minimise each core of MSU3 and PartMSU3 by removing one soft clause "
+			"at a time, with a budget of N conflicts per SAT call (0=off).\n",
+			0, IntRange(0, INT32_MAX));
+
+	IntOption boost_time("Life", "boost-time",
+			"Seconds of the core-guided phase of the core-boosted search "
+			"(-algorithm=6) before the linear search (0=no limit).\n",
+			5, IntRange(0, INT32_MAX));
+
+	IntOption boost_conflicts("Life", "boost-conflicts",
+			"Conflicts of the core-guided phase of the core-boosted search "
+			"before the linear search (0=no limit).\n",
+			0, IntRange(0, INT32_MAX));
+
+	BoolOption disjoint_cores("Life", "disjoint-cores",
+			"Before the search of PartMSU3 (binary merging) and OLL, find cores "
+			"over disjoint soft clauses until the others are satisfiable and "
+			"encode them as the first cores of the search.\n",
+			false);
+
+	IntOption local_search("Life", "local-search",
+			"Flips of local search that tries to improve each model of "
+			"PartMSU3, OLL and the weighted MSU3 (0=off).\n",
+			0, IntRange(0, INT32_MAX));
+
+	IntOption search_threads("Life", "search-threads",
+			"Number of threads that solve independent subtrees of the guide tree "
+			"of PartMSU3 with binary merging or of the hitting set solver of "
+			"IHS (0=one per core).\n",
+			1, IntRange(0, 1024));
+
+	IntOption border_weight("Life", "border-weight",
+			"Cost of a live cell on the border of the predecessor (the other "
+			"cells cost 1).\n",
+			1, IntRange(1, INT32_MAX));
+
+	IntOption preprocess("Life", "preprocess",
+			"Simplify the hard clauses before the search with the cells frozen "
+			"(0=none, 1=subsumption and variable elimination, 2=also "
+			"failed-literal probing).\n",
+			0, IntRange(0, 2));
+
+	StringOption checkpoint_file("Life", "checkpoint",
+			"Save the bounds, the best predecessor and the cores of the search "
+			"to this file, also when the process is stopped by a time limit.\n");
+
+	IntOption checkpoint_interval("Life", "checkpoint-interval",
+			"Seconds between two writes of the checkpoint.\n",
+			60, IntRange(0, INT32_MAX));
+
+	StringOption resume_file("Life", "resume",
+			"Continue the search from a checkpoint of the same board.\n");
+
+	parseOptions(argc, argv, true);
+
 	// Try to set resource limits:
 	if (cpu_lim != 0) limitTime(cpu_lim);
 	if (mem_lim != 0) limitMemory(mem_lim);
 
 	double initial_time = cpuTime();
+	Instrumentation::get();
+	reportFile = report;
 	MaxSAT *S = NULL;
-	S = new PartMSU3(verbosity, partition_strategy, graph_type, cardinality);
+	switch ((int)algorithm) {
+	case _ALGORITHM_WBO_:
+		S = new WBO(verbosity, weight_strategy);
+		break;
+	case _ALGORITHM_LINEAR_SU_:
+		S = new LinearSU(verbosity, false, cardinality);
+		break;
+	case _ALGORITHM_MSU3_:
+		S = new MSU3(verbosity);
+		break;
+	case _ALGORITHM_OLL_:
+		S = new OLL(verbosity, cardinality);
+		break;
+	case _ALGORITHM_CORE_BOOSTED_:
+		S = new CoreBoosted(verbosity, boost_time, boost_conflicts);
+		break;
+	case _ALGORITHM_IHS_:
+		S = new IHS(verbosity, search_threads);
+		break;
+	case _ALGORITHM_PORTFOLIO_: {
+		Portfolio *portfolio = new Portfolio(verbosity);
+		std::stringstream names((const char *)portfolio_engines);
+		std::string name;
+		while (std::getline(names, name, ',')){
+			MaxSAT *engine = NULL;
+			if (name == "part")
+				engine = new PartMSU3(verbosity, partition_strategy, graph_type, _CARD_TOTALIZER_);
+			else if (name == "oll")
+				engine = new OLL(verbosity, _CARD_TOTALIZER_);
+			else if (name == "msu3")
+				engine = new MSU3(verbosity);
+			else if (name == "linear")
+				engine = new LinearSU(verbosity, false, cardinality);
+			else if (name == "boosted")
+				engine = new CoreBoosted(verbosity, boost_time, boost_conflicts);
+			else if (name == "ihs")
+				engine = new IHS(verbosity);
+			else if (name == "wbo")
+				engine = new WBO(verbosity, weight_strategy);
+			else {
+				printf("c Error: Unknown portfolio engine %s.\n", name.c_str());
+				printf("s UNKNOWN\n");
+				exit(_ERROR_);
+			}
+			engine->setUnitRelaxation(unit_relax);
+			engine->setCoreReduction(core_trim, core_min_budget);
+			engine->setDisjointCores(disjoint_cores);
+			engine->setLocalSearch(local_search);
+			portfolio->addEngine(engine, name.c_str());
+		}
+		S = portfolio;
+		break;
+	}
+	default: {
+		PartMSU3 *part = new PartMSU3(verbosity, partition_strategy, graph_type, cardinality);
+		part->setThreads(search_threads);
+		S = part;
+		break;
+	}
+	}
 
-	signal(SIGXCPU, SIGINT_exit);
-	signal(SIGTERM, SIGINT_exit);
+	bool checkpointing = checkpoint_file != NULL || resume_file != NULL;
+	bool enumerate = enum_models > 0 || enum_optimal;
+
+	//PartMSU3 and OLL only support the totalizer
+	if ((algorithm == _ALGORITHM_PART_MSU3_ || algorithm == _ALGORITHM_OLL_) &&
+			cardinality != _CARD_TOTALIZER_)
+		rejectOptions("-algorithm=3 and -algorithm=4 require -cardinality=1");
+
+	//The linear search bounds the models of its solver and IHS hardens soft
+	//clauses, so WBO, LinearSU, CoreBoosted and IHS cannot enumerate
+	if (enumerate && (algorithm == _ALGORITHM_WBO_ ||
+			algorithm == _ALGORITHM_LINEAR_SU_ ||
+			algorithm == _ALGORITHM_CORE_BOOSTED_ || algorithm == _ALGORITHM_IHS_))
+		rejectOptions("-enum and -enum-optimal require -algorithm=2, 3 or 4");
+
+	//PartMSU3 reuses its solver for the queries of a mask file and OLL
+	//rebuilds it; the other algorithms cannot search twice
+	if (mask_file != NULL && algorithm != _ALGORITHM_PART_MSU3_ &&
+			algorithm != _ALGORITHM_OLL_)
+		rejectOptions("-mask requires -algorithm=3 or 4");
+
+	//The engines of a portfolio are neither traced nor enumerated and have no
+	//single state to save
+	if (algorithm == _ALGORITHM_PORTFOLIO_ && mask_file != NULL)
+		rejectOptions("-mask cannot be used with -algorithm=5");
+	if (algorithm == _ALGORITHM_PORTFOLIO_ && enumerate)
+		rejectOptions("-enum and -enum-optimal cannot be used with -algorithm=5");
+	if (algorithm == _ALGORITHM_PORTFOLIO_ && trace_file != NULL)
+		rejectOptions("-trace cannot be used with -algorithm=5");
+	if (algorithm == _ALGORITHM_PORTFOLIO_ && checkpointing)
+		rejectOptions("-checkpoint and -resume cannot be used with -algorithm=5");
+
+	//Only the binary merging of PartMSU3 and the hitting sets of IHS have
+	//independent subproblems
+	if (search_threads != 1 && algorithm != _ALGORITHM_IHS_ &&
+			(algorithm != _ALGORITHM_PART_MSU3_ ||
+			partition_strategy != _PART_BINARY_))
+		rejectOptions("-search-threads requires -algorithm=3 with "
+				"-partition-strategy=2 or -algorithm=7");
+	//The threads of the binary merging neither reduce their cores nor save
+	//their subtrees in a checkpoint
+	if (search_threads != 1 && algorithm == _ALGORITHM_PART_MSU3_ &&
+			checkpointing)
+		rejectOptions("-search-threads cannot be used with -checkpoint or "
+				"-resume");
+	if (search_threads != 1 && algorithm == _ALGORITHM_PART_MSU3_ &&
+			(core_trim > 0 || core_min_budget > 0))
+		rejectOptions("-search-threads cannot be used with -core-trim or "
+				"-core-min-budget");
+
+	if (disjoint_cores && algorithm != _ALGORITHM_OLL_ &&
+			algorithm != _ALGORITHM_CORE_BOOSTED_ &&
+			algorithm != _ALGORITHM_PORTFOLIO_ &&
+			(algorithm != _ALGORITHM_PART_MSU3_ ||
+			partition_strategy != _PART_BINARY_))
+		rejectOptions("-disjoint-cores requires -algorithm=3 with "
+				"-partition-strategy=2, -algorithm=4, 5 or 6");
+
+	//With weights CoreBoosted and the enumeration are not supported and
+	//MSU3/PartMSU3 harden soft clauses, so they neither save their cores nor
+	//answer masks
+	if (border_weight > 1 && algorithm == _ALGORITHM_CORE_BOOSTED_)
+		rejectOptions("-border-weight cannot be used with -algorithm=6");
+	if (border_weight > 1 && enumerate)
+		rejectOptions("-border-weight cannot be used with -enum or -enum-optimal");
+	if (border_weight > 1 && mask_file != NULL)
+		rejectOptions("-border-weight cannot be used with -mask");
+	if (border_weight > 1 && checkpointing)
+		rejectOptions("-border-weight cannot be used with -checkpoint or -resume");
+
+	//The preprocessing may remove soft clauses, so the indices of the cores of
+	//a checkpoint would not be those of the board
+	if (preprocess > 0 && checkpointing)
+		rejectOptions("-preprocess cannot be used with -checkpoint or -resume");
+
+	//A checkpoint is the state of a single search without assumptions
+	if (mask_file != NULL && checkpointing)
+		rejectOptions("-mask cannot be used with -checkpoint or -resume");
+
+	S->setUnitRelaxation(unit_relax);
+	S->setCoreReduction(core_trim, core_min_budget);
+	S->setDisjointCores(disjoint_cores);
+	S->setLocalSearch(local_search);
+
+	//The reporting thread also prints the answer when the time limit exceeds
+	FILE *progress_out = stderr;
+	if (progress >= 0 && progress_file != NULL &&
+			(progress_out = fopen(progress_file, "a")) == NULL){
+		printf("c Error: Cannot open the progress file %s.\n", (const char *)progress_file);
+		printf("s UNKNOWN\n");
+		exit(_ERROR_);
+	}
+	Progress::get().start(progress, progress_out);
+
+	SearchTrace *trace = NULL;
+	if (trace_file != NULL){
+		trace = SearchTrace::open(trace_file);
+		if (trace == NULL){
+			printf("c Error: Cannot open the trace file %s.\n", (const char *)trace_file);
+			printf("s UNKNOWN\n");
+			exit(_ERROR_);
+		}
+		S->setTrace(trace);
+	}
+
+	Progress::get().onExit(SIGXCPU, exitOnSignal);
+	Progress::get().onExit(SIGTERM, exitOnSignal);
 
 	MaxSATFormula *maxsat_formula = new MaxSATFormula();
 
 	// Leitura da matriz
+	INSTR_START(_PHASE_PARSE_);
 	scanf ("%d", &lin);
 	scanf ("%d", &col);
-	int board_t1[lin*col];
+	std::vector<int> board_t1(lin*col);
 	for (int i = 0; i < lin*col; i++){
 		scanf ("%d", &board_t1[i]);
 		maxsat_formula->newVar();
 	}
 
-	maxsat_formula->setFormat(_FORMAT_MAXSAT_);
-	for (int i = 1; i < lin-1; i++){
-		for (int j = 1; j < col-1; j++){
-			if (board_t1[i*col+j] == 1){
-				//{mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)}
-				//Loneliness = C(8,7) = 8!/7! = 8 possibilidades
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				//Stagnation = C(8,2) = 8!/6!2! = 28 possiblidades
-				addLiterals(maxsat_formula, {mkLit(i*col+j, false), mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, false), mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, false), mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, true), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, false), mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, false), mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, false), mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, false), mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, false), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, false), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, true), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, false), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, false), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, false), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, false), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, false), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, true), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, false), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, false), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, false), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, false), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, false), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, false), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, false), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, true), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, false), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, true), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, false), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, true), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, false), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, false), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, false), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, false), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, false), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, false), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1, true)});
-				//Overcrowding = C(8,4)= 8!/4!4! = 70 possibilidades
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1, true), mkLit(i*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1, true), mkLit((i+1)*col+j, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1, true), mkLit((i+1)*col+j-1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1, true), mkLit(i*col+j-1, true), mkLit(i*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1, true), mkLit(i*col+j-1, true), mkLit((i+1)*col+j, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1, true), mkLit(i*col+j-1, true), mkLit((i+1)*col+j-1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1, true), mkLit(i*col+j-1, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j-1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1, true), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, true), mkLit(i*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, true), mkLit((i+1)*col+j, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, true), mkLit((i+1)*col+j-1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j+1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j+1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j-1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j+1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j+1, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j+1, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j+1, true), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit(i*col+j-1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit(i*col+j-1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j-1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit(i*col+j-1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit(i*col+j-1, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit(i*col+j-1, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit(i*col+j-1, true), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, true), mkLit(i*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, true), mkLit((i+1)*col+j, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, true), mkLit((i+1)*col+j-1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j-1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1, true), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j-1, true), mkLit(i*col+j-1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j-1, true), mkLit(i*col+j-1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j-1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j-1, true), mkLit(i*col+j-1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j-1, true), mkLit(i*col+j-1, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j-1, true), mkLit(i*col+j-1, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j-1, true), mkLit(i*col+j-1, true), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j-1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j-1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j-1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j-1, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j-1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, true), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j+1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j+1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j+1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j+1, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j-1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1, true)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j-1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j-1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j-1, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j+1, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1, true)});
-			} else {
-				//Preservation = C(8,2) = 8!/6!2! = 28 possibilidades
-				addLiterals(maxsat_formula, {mkLit(i*col+j, true), mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, true), mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, true), mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, true), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, true), mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, true), mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, true), mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, true), mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, true), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, true), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, true), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, true), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, true), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, true), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, true), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, true), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, true), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, true), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, false), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, true), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, true), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, true), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, true), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, true), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, true), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, true), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, true), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, true), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, true), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, true), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, true), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, true), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, true), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, true), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit(i*col+j, true), mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1, true)});
-				//Life = C(8,3) = 8!/5!3! = 56 possibilidades
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, true), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, true), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, false), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, true), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, true), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, true), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, true), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, true), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, false), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, true), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, true), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, true), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1, true), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, true), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, true), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, true), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, false), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, false), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, false), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1, true), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, true), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, true), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, true), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, true), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1,false)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1,false), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, true), mkLit((i+1)*col+j, false), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1, true)});
-				addLiterals(maxsat_formula, {mkLit((i-1)*col+j, false), mkLit((i-1)*col+j-1,false), mkLit((i-1)*col+j+1,false), mkLit(i*col+j-1, false), mkLit(i*col+j+1, false), mkLit((i+1)*col+j, true), mkLit((i+1)*col+j-1, true), mkLit((i+1)*col+j+1, true)});
-			}
-		}
-	}
-	// 4 edges
-
-	//Preservation(0,0) = C(3,2) = 3!/2! = 3
-	addLiterals(maxsat_formula, {mkLit(0, true), mkLit(1, true), mkLit(col, true), mkLit(col+1, false)});
-	addLiterals(maxsat_formula, {mkLit(0, true), mkLit(1, true), mkLit(col, false), mkLit(col+1, true)});
-	addLiterals(maxsat_formula, {mkLit(0, true), mkLit(1, false), mkLit(col, true), mkLit(col+1, true)});
-	//Life(0,0) = C(3,3) = 3!/3! = 1
-	addLiterals(maxsat_formula, {mkLit(1, true), mkLit(col, true), mkLit(col+1, true)});
-
-	//Preservation(0,col-1) = C(3,2) = 3!/2! = 3
-	addLiterals(maxsat_formula, {mkLit(col-1, true), mkLit(col-2, true), mkLit(2*col-1, true), mkLit(2*col-2, false)});
-	addLiterals(maxsat_formula, {mkLit(col-1, true), mkLit(col-2, true), mkLit(2*col-1, false), mkLit(2*col-2, true)});
-	addLiterals(maxsat_formula, {mkLit(col-1, true), mkLit(col-2, false), mkLit(2*col-1, true), mkLit(2*col-2, true)});
-	//Life(0,col-1) = C(3,3) = 3!/3! = 1
-	addLiterals(maxsat_formula, {mkLit(col-2, true), mkLit(2*col-1, true), mkLit(2*col-2, true)});
-
-	//Preservation(lin-1,0) = C(3,2) = 3!/2! = 3
-	addLiterals(maxsat_formula, {mkLit((lin-1)*col, true), mkLit((lin-1)*col+1, true), mkLit((lin-2)*col, true), mkLit((lin-2)*col+1, false)});
-	addLiterals(maxsat_formula, {mkLit((lin-1)*col, true), mkLit((lin-1)*col+1, true), mkLit((lin-2)*col, false), mkLit((lin-2)*col+1, true)});
-	addLiterals(maxsat_formula, {mkLit((lin-1)*col, true), mkLit((lin-1)*col+1, false), mkLit((lin-2)*col, true), mkLit((lin-2)*col+1, true)});
-	//Life(lin-1,0) = C(3,3) = 3!/3! = 1
-	addLiterals(maxsat_formula, {mkLit((lin-1)*col+1, true), mkLit((lin-2)*col, true), mkLit((lin-2)*col+1, true)});
-
-	//Preservation(lin-1,col-1) = C(3,2) = 3!/2! = 3
-	addLiterals(maxsat_formula, {mkLit(lin*col-1, true), mkLit(lin*col-2, true), mkLit((lin-1)*col-1, true), mkLit((lin-1)*col-2, false)});
-	addLiterals(maxsat_formula, {mkLit(lin*col-1, true), mkLit(lin*col-2, true), mkLit((lin-1)*col-1, false), mkLit((lin-1)*col-2, true)});
-	addLiterals(maxsat_formula, {mkLit(lin*col-1, true), mkLit(lin*col-2, false), mkLit((lin-1)*col-1, true), mkLit((lin-1)*col-2, true)});
-	//Life(lin-1,col-1) = C(3,3) = 3!/3! = 1
-	addLiterals(maxsat_formula, {mkLit(lin*col-2, true), mkLit((lin-1)*col-1, true), mkLit((lin-1)*col-2, true)});
-
-	//First and last line
-	for (int j = 0; j < col-1; j++){
-		//Preservation(0,j) = C(5,2) = 5!/2!3! = 10
-		addLiterals(maxsat_formula, {mkLit(j, true), mkLit(j-1, true), mkLit(j+1, true), mkLit(col+j-1, false), mkLit(col+j, false), mkLit(col+j+1, false)});
-		addLiterals(maxsat_formula, {mkLit(j, true), mkLit(j-1, true), mkLit(j+1, false), mkLit(col+j-1, true), mkLit(col+j, false), mkLit(col+j+1, false)});
-		addLiterals(maxsat_formula, {mkLit(j, true), mkLit(j-1, true), mkLit(j+1, false), mkLit(col+j-1, false), mkLit(col+j, true), mkLit(col+j+1, false)});
-		addLiterals(maxsat_formula, {mkLit(j, true), mkLit(j-1, true), mkLit(j+1, false), mkLit(col+j-1, false), mkLit(col+j, false), mkLit(col+j+1, true)});
-		addLiterals(maxsat_formula, {mkLit(j, true), mkLit(j-1, false), mkLit(j+1, true), mkLit(col+j-1, true), mkLit(col+j, false), mkLit(col+j+1, false)});
-		addLiterals(maxsat_formula, {mkLit(j, true), mkLit(j-1, false), mkLit(j+1, true), mkLit(col+j-1, false), mkLit(col+j, true), mkLit(col+j+1, false)});
-		addLiterals(maxsat_formula, {mkLit(j, true), mkLit(j-1, false), mkLit(j+1, true), mkLit(col+j-1, false), mkLit(col+j, false), mkLit(col+j+1, true)});
-		addLiterals(maxsat_formula, {mkLit(j, true), mkLit(j-1, false), mkLit(j+1, false), mkLit(col+j-1, true), mkLit(col+j, true), mkLit(col+j+1, false)});
-		addLiterals(maxsat_formula, {mkLit(j, true), mkLit(j-1, false), mkLit(j+1, false), mkLit(col+j-1, true), mkLit(col+j, false), mkLit(col+j+1, true)});
-		addLiterals(maxsat_formula, {mkLit(j, true), mkLit(j-1, false), mkLit(j+1, false), mkLit(col+j-1, false), mkLit(col+j, true), mkLit(col+j+1, true)});
-		//Life(0,j) = C(5,3) = 5!/3!2! = 10
-		addLiterals(maxsat_formula, {mkLit(j-1, true), mkLit(j+1, true), mkLit(col+j-1, true), mkLit(col+j, false), mkLit(col+j+1, false)});
-		addLiterals(maxsat_formula, {mkLit(j-1, true), mkLit(j+1, true), mkLit(col+j-1, false), mkLit(col+j, true), mkLit(col+j+1, false)});
-		addLiterals(maxsat_formula, {mkLit(j-1, true), mkLit(j+1, true), mkLit(col+j-1, false), mkLit(col+j, false), mkLit(col+j+1, true)});
-		addLiterals(maxsat_formula, {mkLit(j-1, true), mkLit(j+1, false), mkLit(col+j-1, true), mkLit(col+j, true), mkLit(col+j+1, false)});
-		addLiterals(maxsat_formula, {mkLit(j-1, true), mkLit(j+1, false), mkLit(col+j-1, true), mkLit(col+j, false), mkLit(col+j+1, true)});
-		addLiterals(maxsat_formula, {mkLit(j-1, true), mkLit(j+1, false), mkLit(col+j-1, false), mkLit(col+j, true), mkLit(col+j+1, true)});
-		addLiterals(maxsat_formula, {mkLit(j-1, false), mkLit(j+1, true), mkLit(col+j-1, true), mkLit(col+j, true), mkLit(col+j+1, false)});
-		addLiterals(maxsat_formula, {mkLit(j-1, false), mkLit(j+1, true), mkLit(col+j-1, true), mkLit(col+j, false), mkLit(col+j+1, true)});
-		addLiterals(maxsat_formula, {mkLit(j-1, false), mkLit(j+1, true), mkLit(col+j-1, false), mkLit(col+j, true), mkLit(col+j+1, true)});
-		addLiterals(maxsat_formula, {mkLit(j-1, false), mkLit(j+1, false), mkLit(col+j-1, true), mkLit(col+j, true), mkLit(col+j+1, true)});
-
-		//Preservation(lin-1,j) = C(5,2) = 5!/2!3! = 10
-		addLiterals(maxsat_formula, {mkLit((lin-1)*col+j, true), mkLit((lin-1)*col+j-1, true), mkLit((lin-1)*col+j+1, true), mkLit((lin-2)*col+j-1, false), mkLit((lin-2)*col+j, false), mkLit((lin-2)*col+j+1, false)});
-		addLiterals(maxsat_formula, {mkLit((lin-1)*col+j, true), mkLit((lin-1)*col+j-1, true), mkLit((lin-1)*col+j+1, false), mkLit((lin-2)*col+j-1, true), mkLit((lin-2)*col+j, false), mkLit((lin-2)*col+j+1, false)});
-		addLiterals(maxsat_formula, {mkLit((lin-1)*col+j, true), mkLit((lin-1)*col+j-1, true), mkLit((lin-1)*col+j+1, false), mkLit((lin-2)*col+j-1, false), mkLit((lin-2)*col+j, true), mkLit((lin-2)*col+j+1, false)});
-		addLiterals(maxsat_formula, {mkLit((lin-1)*col+j, true), mkLit((lin-1)*col+j-1, true), mkLit((lin-1)*col+j+1, false), mkLit((lin-2)*col+j-1, false), mkLit((lin-2)*col+j, false), mkLit((lin-2)*col+j+1, true)});
-		addLiterals(maxsat_formula, {mkLit((lin-1)*col+j, true), mkLit((lin-1)*col+j-1, false), mkLit((lin-1)*col+j+1, true), mkLit((lin-2)*col+j-1, true), mkLit((lin-2)*col+j, false), mkLit((lin-2)*col+j+1, false)});
-		addLiterals(maxsat_formula, {mkLit((lin-1)*col+j, true), mkLit((lin-1)*col+j-1, false), mkLit((lin-1)*col+j+1, true), mkLit((lin-2)*col+j-1, false), mkLit((lin-2)*col+j, true), mkLit((lin-2)*col+j+1, false)});
-		addLiterals(maxsat_formula, {mkLit((lin-1)*col+j, true), mkLit((lin-1)*col+j-1, false), mkLit((lin-1)*col+j+1, true), mkLit((lin-2)*col+j-1, false), mkLit((lin-2)*col+j, false), mkLit((lin-2)*col+j+1, true)});
-		addLiterals(maxsat_formula, {mkLit((lin-1)*col+j, true), mkLit((lin-1)*col+j-1, false), mkLit((lin-1)*col+j+1, false), mkLit((lin-2)*col+j-1, true), mkLit((lin-2)*col+j, true), mkLit((lin-2)*col+j+1, false)});
-		addLiterals(maxsat_formula, {mkLit((lin-1)*col+j, true), mkLit((lin-1)*col+j-1, false), mkLit((lin-1)*col+j+1, false), mkLit((lin-2)*col+j-1, true), mkLit((lin-2)*col+j, false), mkLit((lin-2)*col+j+1, true)});
-		addLiterals(maxsat_formula, {mkLit((lin-1)*col+j, true), mkLit((lin-1)*col+j-1, false), mkLit((lin-1)*col+j+1, false), mkLit((lin-2)*col+j-1, false), mkLit((lin-2)*col+j, true), mkLit((lin-2)*col+j+1, true)});
-		//Life(lin-1,j) = C(5,3) = 5!/3!2! = 10
-		addLiterals(maxsat_formula, {mkLit((lin-1)*col+j-1, true), mkLit((lin-1)*col+j+1, true), mkLit((lin-2)*col+j-1, true), mkLit((lin-2)*col+j, false), mkLit((lin-2)*col+j+1, false)});
-		addLiterals(maxsat_formula, {mkLit((lin-1)*col+j-1, true), mkLit((lin-1)*col+j+1, true), mkLit((lin-2)*col+j-1, false), mkLit((lin-2)*col+j, true), mkLit((lin-2)*col+j+1, false)});
-		addLiterals(maxsat_formula, {mkLit((lin-1)*col+j-1, true), mkLit((lin-1)*col+j+1, true), mkLit((lin-2)*col+j-1, false), mkLit((lin-2)*col+j, false), mkLit((lin-2)*col+j+1, true)});
-		addLiterals(maxsat_formula, {mkLit((lin-1)*col+j-1, true), mkLit((lin-1)*col+j+1, false), mkLit((lin-2)*col+j-1, true), mkLit((lin-2)*col+j, true), mkLit((lin-2)*col+j+1, false)});
-		addLiterals(maxsat_formula, {mkLit((lin-1)*col+j-1, true), mkLit((lin-1)*col+j+1, false), mkLit((lin-2)*col+j-1, true), mkLit((lin-2)*col+j, false), mkLit((lin-2)*col+j+1, true)});
-		addLiterals(maxsat_formula, {mkLit((lin-1)*col+j-1, true), mkLit((lin-1)*col+j+1, false), mkLit((lin-2)*col+j-1, false), mkLit((lin-2)*col+j, true), mkLit((lin-2)*col+j+1, true)});
-		addLiterals(maxsat_formula, {mkLit((lin-1)*col+j-1, false), mkLit((lin-1)*col+j+1, true), mkLit((lin-2)*col+j-1, true), mkLit((lin-2)*col+j, true), mkLit((lin-2)*col+j+1, false)});
-		addLiterals(maxsat_formula, {mkLit((lin-1)*col+j-1, false), mkLit((lin-1)*col+j+1, true), mkLit((lin-2)*col+j-1, true), mkLit((lin-2)*col+j, false), mkLit((lin-2)*col+j+1, true)});
-		addLiterals(maxsat_formula, {mkLit((lin-1)*col+j-1, false), mkLit((lin-1)*col+j+1, true), mkLit((lin-2)*col+j-1, false), mkLit((lin-2)*col+j, true), mkLit((lin-2)*col+j+1, true)});
-		addLiterals(maxsat_formula, {mkLit((lin-1)*col+j-1, false), mkLit((lin-1)*col+j+1, false), mkLit((lin-2)*col+j-1, true), mkLit((lin-2)*col+j, true), mkLit((lin-2)*col+j+1, true)}); 
-	}
-
-	//Right and left columns
-	for (int i = 1; i < lin-1; i++){
-		//Preservation(i,0) = C(5,2) = 5!/2!3! = 10
-		addLiterals(maxsat_formula, {mkLit(i*col, true), mkLit((i-1)*col, true), mkLit((i-1)*col+1, true), mkLit(i*col+1, false), mkLit((i+1)*col, false), mkLit((i+1)*col+1, false)});
-		addLiterals(maxsat_formula, {mkLit(i*col, true), mkLit((i-1)*col, true), mkLit((i-1)*col+1, false), mkLit(i*col+1, true), mkLit((i+1)*col, false), mkLit((i+1)*col+1, false)});
-		addLiterals(maxsat_formula, {mkLit(i*col, true), mkLit((i-1)*col, true), mkLit((i-1)*col+1, false), mkLit(i*col+1, false), mkLit((i+1)*col, true), mkLit((i+1)*col+1, false)});
-		addLiterals(maxsat_formula, {mkLit(i*col, true), mkLit((i-1)*col, true), mkLit((i-1)*col+1, false), mkLit(i*col+1, false), mkLit((i+1)*col, false), mkLit((i+1)*col+1, true)});
-		addLiterals(maxsat_formula, {mkLit(i*col, true), mkLit((i-1)*col, false), mkLit((i-1)*col+1, true), mkLit(i*col+1, true), mkLit((i+1)*col, false), mkLit((i+1)*col+1, false)});
-		addLiterals(maxsat_formula, {mkLit(i*col, true), mkLit((i-1)*col, false), mkLit((i-1)*col+1, true), mkLit(i*col+1, false), mkLit((i+1)*col, true), mkLit((i+1)*col+1, false)});
-		addLiterals(maxsat_formula, {mkLit(i*col, true), mkLit((i-1)*col, false), mkLit((i-1)*col+1, true), mkLit(i*col+1, false), mkLit((i+1)*col, false), mkLit((i+1)*col+1, true)});
-		addLiterals(maxsat_formula, {mkLit(i*col, true), mkLit((i-1)*col, false), mkLit((i-1)*col+1, false), mkLit(i*col+1, true), mkLit((i+1)*col, true), mkLit((i+1)*col+1, false)});
-		addLiterals(maxsat_formula, {mkLit(i*col, true), mkLit((i-1)*col, false), mkLit((i-1)*col+1, false), mkLit(i*col+1, true), mkLit((i+1)*col, false), mkLit((i+1)*col+1, true)});
-		addLiterals(maxsat_formula, {mkLit(i*col, true), mkLit((i-1)*col, false), mkLit((i-1)*col+1, false), mkLit(i*col+1, false), mkLit((i+1)*col, true), mkLit((i+1)*col+1, true)});
-		//Life(i,0) = C(5,3) = 5!/3!2! = 10
-		addLiterals(maxsat_formula, {mkLit((i-1)*col, true), mkLit((i-1)*col+1, true), mkLit(i*col+1, true), mkLit((i+1)*col, false), mkLit((i+1)*col+1, false)});
-		addLiterals(maxsat_formula, {mkLit((i-1)*col, true), mkLit((i-1)*col+1, true), mkLit(i*col+1, false), mkLit((i+1)*col, true), mkLit((i+1)*col+1, false)});
-		addLiterals(maxsat_formula, {mkLit((i-1)*col, true), mkLit((i-1)*col+1, true), mkLit(i*col+1, false), mkLit((i+1)*col, false), mkLit((i+1)*col+1, true)});
-		addLiterals(maxsat_formula, {mkLit((i-1)*col, true), mkLit((i-1)*col+1, false), mkLit(i*col+1, true), mkLit((i+1)*col, true), mkLit((i+1)*col+1, false)});
-		addLiterals(maxsat_formula, {mkLit((i-1)*col, true), mkLit((i-1)*col+1, false), mkLit(i*col+1, true), mkLit((i+1)*col, false), mkLit((i+1)*col+1, true)});
-		addLiterals(maxsat_formula, {mkLit((i-1)*col, true), mkLit((i-1)*col+1, false), mkLit(i*col+1, false), mkLit((i+1)*col, true), mkLit((i+1)*col+1, true)});
-		addLiterals(maxsat_formula, {mkLit((i-1)*col, false), mkLit((i-1)*col+1, true), mkLit(i*col+1, true), mkLit((i+1)*col, true), mkLit((i+1)*col+1, false)});
-		addLiterals(maxsat_formula, {mkLit((i-1)*col, false), mkLit((i-1)*col+1, true), mkLit(i*col+1, true), mkLit((i+1)*col, false), mkLit((i+1)*col+1, true)});
-		addLiterals(maxsat_formula, {mkLit((i-1)*col, false), mkLit((i-1)*col+1, true), mkLit(i*col+1, false), mkLit((i+1)*col, true), mkLit((i+1)*col+1, true)});
-		addLiterals(maxsat_formula, {mkLit((i-1)*col, false), mkLit((i-1)*col+1, false), mkLit(i*col+1, true), mkLit((i+1)*col, true), mkLit((i+1)*col+1, true)});
-
-		//Preservation(i,col-1)) = C(5,2) = 5!/2!3! = 10
-		addLiterals(maxsat_formula, {mkLit((i+1)*col-1, true), mkLit(i*col-1, true), mkLit(i*col-2, true), mkLit((i+1)*col-2, false), mkLit((i+2)*col-2, false), mkLit((i+2)*col-1, false)});
-		addLiterals(maxsat_formula, {mkLit((i+1)*col-1, true), mkLit(i*col-1, true), mkLit(i*col-2, false), mkLit((i+1)*col-2, true), mkLit((i+2)*col-2, false), mkLit((i+2)*col-1, false)});
-		addLiterals(maxsat_formula, {mkLit((i+1)*col-1, true), mkLit(i*col-1, true), mkLit(i*col-2, false), mkLit((i+1)*col-2, false), mkLit((i+2)*col-2, true), mkLit((i+2)*col-1, false)});
-		addLiterals(maxsat_formula, {mkLit((i+1)*col-1, true), mkLit(i*col-1, true), mkLit(i*col-2, false), mkLit((i+1)*col-2, false), mkLit((i+2)*col-2, false), mkLit((i+2)*col-1, true)});
-		addLiterals(maxsat_formula, {mkLit((i+1)*col-1, true), mkLit(i*col-1, false), mkLit(i*col-2, true), mkLit((i+1)*col-2, true), mkLit((i+2)*col-2, false), mkLit((i+2)*col-1, false)});
-		addLiterals(maxsat_formula, {mkLit((i+1)*col-1, true), mkLit(i*col-1, false), mkLit(i*col-2, true), mkLit((i+1)*col-2, false), mkLit((i+2)*col-2, true), mkLit((i+2)*col-1, false)});
-		addLiterals(maxsat_formula, {mkLit((i+1)*col-1, true), mkLit(i*col-1, false), mkLit(i*col-2, true), mkLit((i+1)*col-2, false), mkLit((i+2)*col-2, false), mkLit((i+2)*col-1, true)});
-		addLiterals(maxsat_formula, {mkLit((i+1)*col-1, true), mkLit(i*col-1, false), mkLit(i*col-2, false), mkLit((i+1)*col-2, true), mkLit((i+2)*col-2, true), mkLit((i+2)*col-1, false)});
-		addLiterals(maxsat_formula, {mkLit((i+1)*col-1, true), mkLit(i*col-1, false), mkLit(i*col-2, false), mkLit((i+1)*col-2, true), mkLit((i+2)*col-2, false), mkLit((i+2)*col-1, true)});
-		addLiterals(maxsat_formula, {mkLit((i+1)*col-1, true), mkLit(i*col-1, false), mkLit(i*col-2, false), mkLit((i+1)*col-2, false), mkLit((i+2)*col-2, true), mkLit((i+2)*col-1, true)});
-		//Life(i,col-1) = C(5,3) = 5!/3!2! = 10
-		addLiterals(maxsat_formula, {mkLit(i*col-1, true), mkLit(i*col-2, true), mkLit((i+1)*col-2, true), mkLit((i+2)*col-2, false), mkLit((i+2)*col-1, false)});
-		addLiterals(maxsat_formula, {mkLit(i*col-1, true), mkLit(i*col-2, true), mkLit((i+1)*col-2, false), mkLit((i+2)*col-2, true), mkLit((i+2)*col-1, false)});
-		addLiterals(maxsat_formula, {mkLit(i*col-1, true), mkLit(i*col-2, true), mkLit((i+1)*col-2, false), mkLit((i+2)*col-2, false), mkLit((i+2)*col-1, true)});
-		addLiterals(maxsat_formula, {mkLit(i*col-1, true), mkLit(i*col-2, false), mkLit((i+1)*col-2, true), mkLit((i+2)*col-2, true), mkLit((i+2)*col-1, false)});
-		addLiterals(maxsat_formula, {mkLit(i*col-1, true), mkLit(i*col-2, false), mkLit((i+1)*col-2, true), mkLit((i+2)*col-2, false), mkLit((i+2)*col-1, true)});
-		addLiterals(maxsat_formula, {mkLit(i*col-1, true), mkLit(i*col-2, false), mkLit((i+1)*col-2, false), mkLit((i+2)*col-2, true), mkLit((i+2)*col-1, true)});
-		addLiterals(maxsat_formula, {mkLit(i*col-1, false), mkLit(i*col-2, true), mkLit((i+1)*col-2, true), mkLit((i+2)*col-2, true), mkLit((i+2)*col-1, false)});
-		addLiterals(maxsat_formula, {mkLit(i*col-1, false), mkLit(i*col-2, true), mkLit((i+1)*col-2, true), mkLit((i+2)*col-2, false), mkLit((i+2)*col-1, true)});
-		addLiterals(maxsat_formula, {mkLit(i*col-1, false), mkLit(i*col-2, true), mkLit((i+1)*col-2, false), mkLit((i+2)*col-2, true), mkLit((i+2)*col-1, true)});
-		addLiterals(maxsat_formula, {mkLit(i*col-1, false), mkLit(i*col-2, false), mkLit((i+1)*col-2, true), mkLit((i+2)*col-2, true), mkLit((i+2)*col-1, true)}); 
+	vec<vec<Lit> > queries;
+	if (mask_file != NULL && !readMasks(mask_file, queries)){
+		printf("c Error: Invalid mask file %s.\n", (const char *)mask_file);
+		printf("s UNKNOWN\n");
+		exit(_ERROR_);
 	}
+	INSTR_STOP(_PHASE_PARSE_);
 
-	//Adding soft clauses to minimize the number of alive cells
+	maxsat_formula->setFormat(_FORMAT_MAXSAT_);
+	//Hard clauses of every cell, generated in parallel by bands of rows
+	vec<int> sizes;
+	vec<Lit> lits;
+	INSTR_START(_PHASE_ENCODE_);
+	LifeEncoding encoding(lin, col, board_t1.data());
+	encoding.encode(threads, sizes, lits);
+	INSTR_STOP(_PHASE_ENCODE_);
+	int lonely_i, lonely_j;
+	if (encoding.findLonelyCell(lonely_i, lonely_j))
+		printf("c Cell %d %d is alive with less than 2 neighbours on the board.\n",
+				lonely_i, lonely_j);
+	INSTR_START(_PHASE_LOAD_);
+	maxsat_formula->addHardClauses(sizes, lits);
+	sizes.clear(true);
+	lits.clear(true);
+
+	//Adding soft clauses to minimize the number of alive cells, the cells of
+	//the border cost -border-weight
 	for (int i = 0; i < lin*col; i++){
 		vec<Lit> clause;
 		clause.push(mkLit(i, true));
-		maxsat_formula->addSoftClause(1, clause);
+		uint64_t weight = 1;
+		if (i < col || i >= (lin-1)*col || i % col == 0 || i % col == col-1)
+			weight = border_weight;
+		maxsat_formula->setMaximumWeight(weight);
+		maxsat_formula->updateSumWeights(weight);
+		maxsat_formula->addSoftClause(weight, clause);
+	}
+	maxsat_formula->setProblemType(border_weight > 1 ? _WEIGHTED_ : _UNWEIGHTED_);
+	INSTR_STOP(_PHASE_LOAD_);
+
+	//Each window of the packing needs at least 3 live cells. The search stops
+	//as soon as a predecessor with that many cells is found.
+	if (lower_bound > 0){
+		INSTR_TIMER(_PHASE_LOWER_BOUND_);
+		LifeLowerBound life_lb(lin, col, board_t1.data());
+		life_lb.compute(lower_bound == 2 ? 48 : 0);
+		vec<Lit> window;
+		for (int w = 0; lower_bound_card && w < life_lb.nWindows(); w++){
+			life_lb.windowLits(w, window);
+			maxsat_formula->addCardinalityConstraint(new Card(window, 3, true));
+		}
+		S->setInitialLB(life_lb.lowerBound());
+		if (verbosity > 0)
+			printf("c Lower bound: %" PRIu64 " (%d windows, %s)\n", life_lb.lowerBound(),
+					life_lb.nWindows(), life_lb.isExact() ? "exact" : "greedy");
+	}
+
+	Preprocessor preprocessor;
+	if (preprocess > 0){
+		INSTR_TIMER(_PHASE_PREPROCESS_);
+		for (int q = 0; q < queries.size(); q++)
+			for (int i = 0; i < queries[q].size(); i++)
+				preprocessor.setAssumed(var(queries[q][i]));
+		MaxSATFormula *simplified = preprocessor.simplify(maxsat_formula,
+				true, preprocess == 2);
+		//Without a predecessor the original formula is kept and the search
+		//reports it
+		if (simplified != NULL){
+			delete maxsat_formula;
+			maxsat_formula = simplified;
+			S->setPreprocessor(&preprocessor);
+		}
+		if (verbosity > 0 && simplified == NULL)
+			printf("c Preprocessing: the hard clauses are unsatisfiable\n");
+		else if (verbosity > 0)
+			printf("c Preprocessing: %d -> %d hard clauses (%d units, %d "
+					"eliminated, %d equivalent, %d dominated, %d soft "
+					"removed)\n",
+					preprocessor.nHardBefore(), preprocessor.nHardAfter(),
+					preprocessor.nUnits(), preprocessor.nEliminated(),
+					preprocessor.nEquivalent(), preprocessor.nDominated(),
+					preprocessor.nSoftRemoved());
 	}
 
 	if (S->getMaxSATFormula() == NULL)
 		S->loadFormula(maxsat_formula);
 	S->setInitialTime(initial_time);
+	nbVars = maxsat_formula->nVars();
+	nbHard = maxsat_formula->nHard();
+	nbSoft = maxsat_formula->nSoft();
+	INSTR_SET(_COUNTER_VARIABLES_, nbVars);
+	INSTR_SET(_COUNTER_HARD_, nbHard);
+	INSTR_SET(_COUNTER_SOFT_, nbSoft);
+	reportStats = stats;
+	S->setMemoryInterval(memory_interval);
+	if (resume_file != NULL){
+		Checkpoint checkpoint;
+		if (!checkpoint.load(resume_file)){
+			printf("c Error: Invalid checkpoint file %s.\n", (const char *)resume_file);
+			printf("s UNKNOWN\n");
+			exit(_ERROR_);
+		}
+		if (!S->resumeFrom(checkpoint))
+			printf("c Checkpoint %s is not of this board, it is ignored.\n",
+					(const char *)resume_file);
+	}
+	if (checkpoint_file != NULL)
+		S->setCheckpoint(checkpoint_file, checkpoint_interval);
+	S->setPrint(false);
 	mxsolver = S;
-	mxsolver->setPrint(false);
-	int ret = (int)mxsolver->search();
-	printf("%d %d\n", lin, col);
-	if (mxsolver->getValue(1) != 0){
-		for (int i = 0; i < lin; i++){
-			for (int j = 0; j < col; j++){
-				if (mxsolver->getValue(i*col+j) < 1)
-					printf ("0 ");
-				else
-					printf ("1 ");
-			}
-			printf ("\n");
+	//Without masks there is a single query without assumptions
+	int nbQueries = queries.size() > 0 ? queries.size() : 1;
+	for (int q = 0; q < nbQueries; q++){
+		if (queries.size() > 0){
+			printf("c query %d\n", q+1);
+			S->setUserAssumptions(queries[q]);
 		}
-	} else {
-		for (int i = 0; i < lin; i++){
-			for (int j = 0; j < col; j++){
-				printf ("0 ");
-			}
-			printf ("\n");
+		if (trace != NULL)
+			trace->newSearch();
+		INSTR_START(_PHASE_SEARCH_);
+		int ret = (int)S->search();
+		INSTR_STOP(_PHASE_SEARCH_);
+		if (checkpoint_file != NULL && !S->writeCheckpoint(true))
+			printf("c Error: Cannot write the checkpoint to %s.\n",
+					(const char *)checkpoint_file);
+		//The answer is printed with stdout locked, so that the exit handler
+		//never prints it again nor in the middle of it
+		flockfile(stdout);
+		if (ret == _UNSATISFIABLE_)
+			printf("c no predecessor\n");
+		if (stats)
+			printSearchStats(S, ret,
+					ret == _OPTIMUM_ ? cpuTime() - initial_time : -1);
+		bool enumerate = (enum_models > 0 || enum_optimal) && ret == _OPTIMUM_;
+		if (enumerate)
+			enumerating = true;
+		else {
+			printBoard(S);
+			finished = q + 1 == nbQueries;
+		}
+		fflush(stdout);
+		funlockfile(stdout);
+		if (enumerate){
+			//Reuses the solver of the search to enumerate the predecessors
+			nbEnumerated = 0;
+			INSTR_START(_PHASE_ENUMERATE_);
+			S->enumerate(enum_models, enum_optimal, printEnumeratedBoard);
+			INSTR_STOP(_PHASE_ENUMERATE_);
+			flockfile(stdout);
+			enumerating = false;
+			finished = q + 1 == nbQueries;
+			funlockfile(stdout);
 		}
 	}
+	if (reportFile != NULL && !Instrumentation::get().writeJSON(reportFile)){
+		printf("c Error: Cannot write the report to %s.\n", reportFile);
+		exit(_ERROR_);
+	}
+	Progress::get().stop();
 	delete S;
+	delete trace;
 	return 0;
 } 
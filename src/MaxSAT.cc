@@ -26,6 +26,9 @@
  */
 
 #include "MaxSAT.h"
+#include "Encoder.h"
+#include "Instrumentation.h"
+#include "Progress.h"
 
 #include <sstream>
 
@@ -43,10 +46,24 @@ StatusCode MaxSAT::search() {
   return _ERROR_;
 }
 
+int MaxSAT::enumerate(int limit, bool optimal_only, ModelCallback callback) {
+  if(print) printf("Error: Invalid MaxSAT algoritm for enumeration.\n");
+  throw MaxSATException(__FILE__, __LINE__, "Did not implement enumeration");
+  return 0;
+}
+
 void MaxSAT::setInitialTime(double initial) {
   initialTime = initial;
 } // Sets the initial time.
 
+// Sets a lower bound that was computed outside of the search (e.g. from the
+// structure of the problem). The bound must be admissible since the search
+// stops as soon as the upper bound reaches it.
+void MaxSAT::setInitialLB(uint64_t lb) {
+  if (lb > initialLB)
+    initialLB = lb;
+}
+
 /************************************************************************************************
  //
  // SAT solver interface
@@ -87,6 +104,63 @@ void MaxSAT::reserveSATVariables(Solver *S, unsigned maxVariable) {
 #endif
 }
 
+// Adds the hard clauses of the MaxSAT formula to the SAT solver. If the SAT
+// solver supports it and the hard clauses are trusted, they are copied into a
+// flat buffer and added in bulk, one chunk of literals at a time.
+void MaxSAT::loadHardClauses(Solver *S) {
+  INSTR_TIMER(_PHASE_SOLVER_LOAD_);
+#ifdef SAT_HAS_BULK_CLAUSES
+  if (maxsat_formula->hasTrustedHard()) {
+    vec<int> sizes;
+    vec<Lit> lits;
+    for (int i = 0; i < maxsat_formula->nHard(); i++) {
+      LitSpan clause = maxsat_formula->getHardClause(i);
+      sizes.push(clause.size());
+      for (int j = 0; j < clause.size(); j++)
+        lits.push(clause[j]);
+
+      if (lits.size() >= (1 << 20) || i == maxsat_formula->nHard() - 1) {
+        S->addClauses(sizes, lits);
+        sizes.clear();
+        lits.clear();
+      }
+    }
+    return;
+  }
+#endif
+  vec<Lit> clause;
+  for (int i = 0; i < maxsat_formula->nHard(); i++) {
+    maxsat_formula->getHardClause(i).copyTo(clause);
+    S->addClause(clause);
+  }
+}
+
+void MaxSAT::solverMemoryUsage(Solver *S, MemoryUsage &mem) {
+  if (S == NULL)
+    return;
+#ifdef SAT_HAS_MEMORY_USAGE
+  uint64_t arena, watches, learnts;
+  S->memoryUsage(arena, watches, learnts);
+  mem.add(_MEM_SAT_ARENA_, arena);
+  mem.add(_MEM_SAT_WATCHES_, watches);
+  mem.add(_MEM_SAT_LEARNTS_, learnts);
+#endif
+}
+
+// Adds the memory of the MaxSAT formula. Algorithms add their own SAT solver
+// and encoders.
+void MaxSAT::memoryUsage(MemoryUsage &mem) {
+  if (maxsat_formula != NULL)
+    maxsat_formula->memoryUsage(mem);
+}
+
+void MaxSAT::sampleMemory() {
+  memory_time = NSPACE::realTime();
+  memory.clear();
+  memoryUsage(memory);
+  memory.commit();
+}
+
 // Solve the formula that is currently loaded in the SAT solver with a set of
 // assumptions and with the option to use preprocessing for 'simp'.
 lbool MaxSAT::searchSATSolver(Solver *S, vec<Lit> &assumptions, bool pre) {
@@ -96,21 +170,1007 @@ lbool MaxSAT::searchSATSolver(Solver *S, vec<Lit> &assumptions, bool pre) {
 // that belong to soft clauses. To preprocessing to be used those variables
 // should be frozen.
 
+  if (!checkpoint_file.empty()) {
+    bool expired = NSPACE::realTime() - checkpoint_time >= checkpoint_interval;
+    takeCheckpoint(expired);
+    if (expired) {
+      checkpoint_time = NSPACE::realTime();
+      writeCheckpoint();
+    }
+  }
+  SATCallStart start;
+  startSATCall(S, start);
+  Progress::get().publish(start.lb, start.ub, model.size() > 0,
+                          trace_node_parts);
+
+  if (shared_bounds != NULL) {
+    shared_bounds->publishLB(start.lb);
+    setInitialLB(shared_bounds->lowerBound());
+  }
+
+  // In a portfolio the SAT call is split in slices of conflicts, so that the
+  // engine stops soon after another engine ends the search and uses the best
+  // model of the other engines. A budget set by the caller still ends the
+  // call: no slice goes beyond it.
+  lbool res = l_Undef;
+  int64_t budget = S->confBudget();
+  for (;;) {
+    if (shared_bounds != NULL) {
+      if (shared_bounds->cancelled())
+        throw MaxSATException(__FILE__, __LINE__, "Search cancelled");
+      sharedUpperBound(S);
+      int64_t slice = SharedBounds::slice_conflicts;
+      if (budget >= 0 && budget - (int64_t)S->conflicts < slice)
+        slice = budget - (int64_t)S->conflicts;
+      S->setConfBudget(slice);
+    }
 #ifdef SIMP
-  lbool res = ((NSPACE::SimpSolver *)S)->solveLimited(assumptions, pre);
+    res = ((NSPACE::SimpSolver *)S)->solveLimited(assumptions, pre);
 #else
-  lbool res = S->solveLimited(assumptions);
+    res = S->solveLimited(assumptions);
 #endif
+    if (res != l_Undef || shared_bounds == NULL)
+      break;
+    if (budget >= 0 && S->conflicts >= (uint64_t)budget)
+      break;
+  }
+  if (shared_bounds != NULL) {
+    S->budgetOff();
+    if (budget >= 0)
+      S->setConfBudget(budget - (int64_t)S->conflicts);
+    if (res == l_True)
+      shared_bounds->publishModel(S->model, computeCostModel(S->model));
+  }
+
+  recordSATCall(S, start, res, assumptions.size());
+
+  if (memory_interval > 0 &&
+      NSPACE::realTime() - memory_time >= memory_interval)
+    sampleMemory();
 
   return res;
 }
 
+void MaxSAT::startSATCall(Solver *S, SATCallStart &start) {
+  start.conflicts = S->conflicts;
+  start.decisions = S->decisions;
+  start.propagations = S->propagations;
+  start.lb = currentLB();
+  start.ub = ubCost;
+  start.time = Instrumentation::now();
+#ifdef GLUCOSE_PROFILE
+  start.profile = S->profile;
+#endif
+}
+
+void MaxSAT::recordSATCall(Solver *S, const SATCallStart &start, lbool res,
+                           int assumptions) {
+  double seconds = Instrumentation::since(start.time);
+  if (res == l_False)
+    Progress::get().addCore();
+#ifdef GLUCOSE_PROFILE
+  profile.accumulate(S->profile, start.profile);
+#endif
+#ifdef INSTRUMENTATION
+  Instrumentation::get().satCall(
+      seconds, res == l_True ? 1 : (res == l_False ? 0 : -1),
+      S->conflicts - start.conflicts, S->propagations - start.propagations,
+      assumptions);
+#endif
+
+  if (trace != NULL) {
+    TraceRow row;
+    row.seconds = seconds;
+    row.result = res == l_True ? 1 : (res == l_False ? 0 : -1);
+    row.assumptions = assumptions;
+    row.core = res == l_False ? S->conflict.size() : 0;
+    row.lb = start.lb;
+    row.ub = start.ub;
+    row.cost = res == l_True ? (int64_t)computeCostModel(S->model) : -1;
+    row.conflicts = S->conflicts - start.conflicts;
+    row.decisions = S->decisions - start.decisions;
+    row.propagations = S->propagations - start.propagations;
+    row.learnts = S->nLearnts();
+    row.node_first = trace_node_first;
+    row.node_parts = trace_node_parts;
+    trace->write(row);
+  }
+}
+
+// Only an engine with a model of its own takes the upper bound of the other
+// engines: before its first model a bound would be mistaken for one of its
+// own (e.g. an unsatisfiable bound for an unsatisfiable formula). A bound that
+// reaches the lower bound is not encoded, the portfolio ends the search.
+void MaxSAT::sharedUpperBound(Solver *S) {
+  uint64_t ub = shared_bounds->upperBound();
+  if (model.size() == 0 || ub >= ubCost)
+    return;
+  ubCost = ub;
+  if (verbosity > 0)
+    printf("c Shared UB : %-12" PRIu64 "\n", ubCost);
+  if (ubCost > currentLB())
+    tightenUpperBound(S);
+}
+
+// Returns the assumptions of the algorithm preceded by the user assumptions.
+// The user assumptions are constant during a search, hence cores that only
+// contain user assumptions can only occur before the first model is found.
+vec<Lit> &MaxSAT::withUserAssumptions(Solver *S, vec<Lit> &assumptions) {
+  if (user_assumptions.size() == 0)
+    return assumptions;
+
+  mergeUserAssumptions(S, assumptions, merged_assumptions);
+  return merged_assumptions;
+}
+
+// Glucose opens a decision level for every assumption, even one that is
+// already satisfied. The user assumptions that hold at the root of 'S' and
+// the assumptions of the algorithm that repeat a user assumption (e.g. the
+// unit soft clauses of the cells fixed by a mask) are therefore left out:
+// with them the levels could outnumber the variables, and 'computeLBD' of
+// Glucose indexes an array of one entry per variable by level.
+void MaxSAT::mergeUserAssumptions(Solver *S, vec<Lit> &assumptions,
+                                  vec<Lit> &merged) {
+  merged.clear();
+  for (int i = 0; i < user_assumptions.size(); i++)
+    if (S->value(user_assumptions[i]) != l_True)
+      merged.push(user_assumptions[i]);
+  for (int i = 0; i < assumptions.size(); i++)
+    if (!isUserAssumption(assumptions[i]))
+      merged.push(assumptions[i]);
+}
+
+// Resets the bounds so that the SAT solver of a previous search can be reused
+// for a new search (e.g. with different user assumptions).
+void MaxSAT::resetSearch() {
+  ubCost = maxsat_formula->getSumWeights();
+  lbCost = 0;
+  nbSatisfiable = 0;
+  disjointLB = 0;
+  {
+    std::lock_guard<std::mutex> guard(model_lock);
+    model.clear();
+  }
+  searchStatus = _UNKNOWN_;
+  firstModelTime = -1;
+  trace_node_first = -1;
+  trace_node_parts = 0;
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  reduceCore : (S : Solver *)  ->  [void]
+  |
+  |  Description:
+  |
+  |    Reduces the core of the last SAT call in two stages. Trimming solves
+  |    again under the assumptions of the core until the core stops shrinking.
+  |    Minimisation removes one soft clause at a time from the assumptions; if
+  |    the SAT call is still unsatisfiable within 'core_min_budget' conflicts,
+  |    the new core replaces the remaining candidates, otherwise the soft
+  |    clause is kept. Assumptions that are not of soft clauses (encodings and
+  |    user assumptions) are always kept. A model found by a reduction call
+  |    satisfies the user assumptions and may improve the upper bound (see
+  |    'reductionCall').
+  |
+  |  Pre-conditions:
+  |    * The last SAT call of 'S' was unsatisfiable.
+  |
+  |  Post-conditions:
+  |    * 'S->conflict' is a core that is a subset of the initial one.
+  |
+  |________________________________________________________________________________________________@*/
+void MaxSAT::reduceCore(Solver *S) {
+  if ((core_trim == 0 && core_min_budget == 0) || S->conflict.size() <= 1)
+    return;
+
+  sumSizeUnreduced += S->conflict.size();
+  vec<Lit> core;
+  vec<Lit> core_assumptions;
+  vec<Lit> assumptions;
+  S->conflict.copyTo(core);
+
+  for (int i = 0; i < core_trim; i++) {
+    core_assumptions.clear();
+    for (int j = 0; j < core.size(); j++)
+      core_assumptions.push(~core[j]);
+    mergeUserAssumptions(S, core_assumptions, assumptions);
+    if (reductionCall(S, assumptions, -1) != l_False ||
+        S->conflict.size() >= core.size())
+      break;
+    S->conflict.copyTo(core);
+  }
+
+  if (core_min_budget > 0) {
+    vec<Lit> kept;
+    vec<Lit> candidates;
+    for (int i = 0; i < core.size(); i++) {
+      if (coreSoft(core[i]) == -1)
+        kept.push(core[i]);
+      else
+        candidates.push(core[i]);
+    }
+
+    std::set<int> inCore;
+    while (candidates.size() > 0) {
+      Lit removed = candidates.last();
+      candidates.pop();
+      core_assumptions.clear();
+      for (int i = 0; i < kept.size(); i++)
+        core_assumptions.push(~kept[i]);
+      for (int i = 0; i < candidates.size(); i++)
+        core_assumptions.push(~candidates[i]);
+      mergeUserAssumptions(S, core_assumptions, assumptions);
+
+      lbool res = reductionCall(S, assumptions, core_min_budget);
+      if (res == l_False) {
+        inCore.clear();
+        for (int i = 0; i < S->conflict.size(); i++)
+          inCore.insert(toInt(S->conflict[i]));
+        int j = 0;
+        for (int i = 0; i < candidates.size(); i++)
+          if (inCore.count(toInt(candidates[i])))
+            candidates[j++] = candidates[i];
+        candidates.shrink(candidates.size() - j);
+      } else
+        kept.push(removed);
+    }
+    kept.copyTo(core);
+  }
+
+  nbReducedCores++;
+  sumSizeReduced += core.size();
+  core.copyTo(S->conflict);
+}
+
+// In a portfolio the call is split in slices of conflicts, like in
+// 'searchSATSolver', so that a cancelled engine stops during the reduction.
+// A budget set by the caller on 'S' also ends the call and is restored
+// afterwards. The call is recorded like those of the search, and a model that
+// satisfies the core but not the soft clauses outside it may be a better
+// predecessor.
+lbool MaxSAT::reductionCall(Solver *S, vec<Lit> &assumptions, int64_t budget) {
+  nbReductionCalls++;
+  SATCallStart start;
+  startSATCall(S, start);
+  Progress::get().publish(start.lb, start.ub, model.size() > 0,
+                          trace_node_parts);
+  lbool res = l_Undef;
+  int64_t callerBudget = S->confBudget();
+  for (;;) {
+    int64_t slice = budget;
+    if (shared_bounds != NULL) {
+      if (shared_bounds->cancelled())
+        throw MaxSATException(__FILE__, __LINE__, "Search cancelled");
+      if (slice < 0 || slice > SharedBounds::slice_conflicts)
+        slice = SharedBounds::slice_conflicts;
+    }
+    if (callerBudget >= 0 &&
+        (slice < 0 || callerBudget - (int64_t)S->conflicts < slice))
+      slice = std::max<int64_t>(0, callerBudget - (int64_t)S->conflicts);
+    if (slice >= 0)
+      S->setConfBudget(slice);
+    res = S->solveLimited(assumptions);
+    if (res != l_Undef || shared_bounds == NULL)
+      break;
+    if (budget >= 0 && (budget -= slice) <= 0)
+      break;
+    if (callerBudget >= 0 && S->conflicts >= (uint64_t)callerBudget)
+      break;
+  }
+  S->budgetOff();
+  if (callerBudget >= 0)
+    S->setConfBudget(callerBudget - (int64_t)S->conflicts);
+  recordSATCall(S, start, res, assumptions.size());
+
+  if (res == l_True) {
+    uint64_t newCost = computeCostModel(S->model);
+    if (newCost < ubCost) {
+      saveModel(S->model);
+      printBound(newCost);
+      ubCost = newCost;
+    }
+    if (shared_bounds != NULL)
+      shared_bounds->publishModel(S->model, newCost);
+  }
+  return res;
+}
+
+// Prints the sizes of the cores before and after their reduction.
+void MaxSAT::printCoreReduction() {
+  if (core_trim == 0 && core_min_budget == 0)
+    return;
+  printf("c core-reduction cores %d literals %" PRIu64 " -> %" PRIu64
+         " sat-calls %d\n",
+         nbReducedCores, sumSizeUnreduced, sumSizeReduced, nbReductionCalls);
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  findDisjointCores : (S : Solver *) (cores : std::vector<std::vector<int>>&)
+  |                      ->  [lbool]
+  |
+  |  Description:
+  |
+  |    Solves under the assumptions of the soft clauses that are not in a
+  |    previous core until the SAT call is satisfiable. Each core is over soft
+  |    clauses that are not in the other cores, hence every core increases the
+  |    lower bound by the smallest weight of its soft clauses. No soft clause
+  |    is relaxed: the algorithm encodes the cores afterwards.
+  |
+  |  Pre-conditions:
+  |    * 'coreSoft' maps the assumption literals of the soft clauses.
+  |
+  |  Post-conditions:
+  |    * If it returns l_True, the model of the last SAT call is saved,
+  |      'cores' contains the indexes of the soft clauses of each core and
+  |      'disjointLB' is their lower bound.
+  |    * Returns l_False if a core has no soft clauses, i.e. the hard clauses
+  |      are unsatisfiable under the user assumptions.
+  |    * Returns l_Undef if a SAT call was interrupted (e.g. the search of a
+  |      portfolio was cancelled or a budget was spent).
+  |
+  |________________________________________________________________________________________________@*/
+lbool MaxSAT::findDisjointCores(Solver *S,
+                                std::vector<std::vector<int> > &cores) {
+  vec<bool> inCore(maxsat_formula->nSoft(), false);
+  vec<Lit> assumptions;
+  int calls = 0;
+
+  for (;;) {
+    assumptions.clear();
+    for (int i = 0; i < maxsat_formula->nSoft(); i++)
+      if (!inCore[i])
+        assumptions.push(~getAssumptionLit(i));
+
+    lbool res = searchSATSolver(S, withUserAssumptions(S, assumptions));
+    calls++;
+    if (res == l_True) {
+      nbSatisfiable++;
+      uint64_t newCost = computeCostModel(S->model);
+      if (nbSatisfiable == 1 || newCost < ubCost) {
+        saveModel(S->model);
+        printBound(newCost);
+        ubCost = newCost;
+      }
+      disjointLB = lbCost;
+      if (verbosity > 0)
+        printf("c Disjoint cores : %d in %d SAT calls\n", (int)cores.size(),
+               calls);
+      return l_True;
+    }
+    if (res == l_Undef)
+      return l_Undef;
+
+    reduceCore(S);
+    std::vector<int> core;
+    uint64_t weight = 0;
+    for (int i = 0; i < S->conflict.size(); i++) {
+      int soft_index = coreSoft(S->conflict[i]);
+      if (soft_index == -1)
+        continue;
+      core.push_back(soft_index);
+      inCore[soft_index] = true;
+      if (weight == 0 || maxsat_formula->getSoftWeight(soft_index) < weight)
+        weight = maxsat_formula->getSoftWeight(soft_index);
+    }
+    if (core.empty())
+      return l_False;
+
+    cores.push_back(core);
+    lbCost += weight;
+    nbCores++;
+    sumSizeCores += S->conflict.size();
+    if (verbosity > 0)
+      printf("c LB : %-12" PRIu64 "\n", lbCost);
+  }
+}
+
+/************************************************************************************************
+ //
+ // Weighted MSU3
+ //
+ ************************************************************************************************/
+
+/*_________________________________________________________________________________________________
+  |
+  |  nextStratum : (weight : uint64_t)  ->  [uint64_t]
+  |
+  |  Description:
+  |
+  |    Next weight level of the stratification, below 'weight'. As in
+  |    'OLL::findNextWeightDiversity', the level goes down while the soft
+  |    clauses above it have too few clauses per distinct weight, so that a
+  |    level is not spent on a handful of heavy clauses.
+  |
+  |  Post-conditions:
+  |    * Returns 'weight' if no soft clause has a smaller weight.
+  |
+  |________________________________________________________________________________________________@*/
+uint64_t MaxSAT::nextStratum(uint64_t weight) {
+  const float alpha = 1.25;
+  uint64_t next = weight;
+
+  for (;;) {
+    uint64_t lower = 0;
+    for (int i = 0; i < maxsat_formula->nSoft(); i++) {
+      uint64_t w = maxsat_formula->getSoftWeight(i);
+      if (w < next && w > lower)
+        lower = w;
+    }
+    if (lower == 0)
+      return next;
+    next = lower;
+
+    int nbClauses = 0;
+    std::set<uint64_t> nbWeights;
+    for (int i = 0; i < maxsat_formula->nSoft(); i++) {
+      if (maxsat_formula->getSoftWeight(i) >= next) {
+        nbClauses++;
+        nbWeights.insert(maxsat_formula->getSoftWeight(i));
+      }
+    }
+    if ((float)nbClauses / nbWeights.size() > alpha ||
+        nbClauses == maxsat_formula->nSoft())
+      return next;
+  }
+}
+
+// Sums of subsets of the weights of the relaxed soft clauses, up to 'limit'.
+// Above the limit every value is assumed to be a sum.
+namespace {
+struct SubsetSums {
+  std::vector<char> reach;
+
+  void init(uint64_t limit) {
+    reach.assign(limit + 1, 0);
+    reach[0] = 1;
+  }
+  void add(uint64_t weight) {
+    for (uint64_t v = reach.size(); v-- > weight;)
+      if (reach[v - weight])
+        reach[v] = 1;
+  }
+  // Smallest sum that is not smaller than 'value'.
+  uint64_t atLeast(uint64_t value) {
+    while (value < reach.size() && !reach[value])
+      value++;
+    return value;
+  }
+};
+} // namespace
+
+/*_________________________________________________________________________________________________
+  |
+  |  weightedMSU3 : (S : Solver *)  ->  [StatusCode]
+  |
+  |  Description:
+  |
+  |    Stratified MSU3 for weighted formulas. The soft clauses are assumed by
+  |    decreasing weight levels (see 'nextStratum'); a level is added when the
+  |    previous ones are satisfiable. The soft clauses of each core are
+  |    relaxed and the relaxed ones are bounded by sum w_i r_i <= 'lbCost'.
+  |
+  |    Every model falsifies soft clauses of weight at least 'lbCost' among
+  |    the relaxed ones. A core without the bound shows that one of its new
+  |    soft clauses is also falsified, so the bound grows by their smallest
+  |    weight; with the bound, either that happens or the weight of the
+  |    relaxed ones exceeds 'lbCost', i.e. it reaches the next sum of their
+  |    weights. The bound is raised to a sum of the weights of the relaxed
+  |    soft clauses, since only those can be reached.
+  |
+  |    A soft clause that is not relaxed and whose weight is at least
+  |    'ubCost' - 'lbCost' is hardened: a model that falsifies it is not
+  |    better than the best one. A core with no soft clause to relax then
+  |    proves the best model optimal.
+  |
+  |    While the relaxed soft clauses have the same weight the bound is a
+  |    totalizer on their number; when weights differ the incremental SWC
+  |    encoding replaces it.
+  |
+  |  Pre-conditions:
+  |    * The relaxation literal of each soft clause is its assumption literal
+  |      and 'S' contains the relaxed soft clauses.
+  |
+  |  Post-conditions:
+  |    * 'ubCost', 'lbCost', 'nbSatisfiable' and 'nbCores' are updated.
+  |
+  |________________________________________________________________________________________________@*/
+StatusCode MaxSAT::weightedMSU3(Solver *S) {
+  int nSoft = maxsat_formula->nSoft();
+  vec<bool> relaxed(nSoft, false);
+  vec<bool> hardened(nSoft, false);
+  for (int i = 0; i < nSoft; i++)
+    mapCore(getAssumptionLit(i), i);
+
+  Encoder totalizer(_INCREMENTAL_ITERATIVE_, _CARD_TOTALIZER_);
+  Encoder pb(_INCREMENTAL_ITERATIVE_, _CARD_TOTALIZER_, _AMO_LADDER_,
+             _PB_SWC_);
+  vec<Lit> objLits, joinLits, encodingAssumptions, assumptions;
+  vec<uint64_t> objCoeffs, joinCoeffs;
+  uint64_t unitWeight = 0; // Weight of the relaxed ones while it is uniform.
+  bool usePB = false, pbStarted = false;
+  std::set<Lit> boundLits; // Assumptions of the bound.
+
+  // Sums above 2^24 are not tracked: the next sum is then the next integer.
+  SubsetSums sums;
+  sums.init(std::min(ubCost, (uint64_t)1 << 24));
+
+  uint64_t level = nextStratum(UINT64_MAX);
+  for (;;) {
+    assumptions.clear();
+    for (int i = 0; i < encodingAssumptions.size(); i++)
+      assumptions.push(encodingAssumptions[i]);
+    for (int i = 0; i < nSoft; i++)
+      if (!relaxed[i] && !hardened[i] && getSoftWeight(i) >= level)
+        assumptions.push(~getAssumptionLit(i));
+
+    lbool res = searchSATSolver(S, withUserAssumptions(S, assumptions));
+    if (res == l_Undef) {
+      printAnswer(_UNKNOWN_);
+      return _UNKNOWN_;
+    }
+
+    if (res == l_True) {
+      nbSatisfiable++;
+      uint64_t newCost = computeCostModel(S->model);
+      vec<lbool> &newModel = improveModel(S->model, newCost);
+      if (nbSatisfiable == 1 || newCost < ubCost) {
+        saveModel(newModel);
+        printBound(newCost);
+        ubCost = newCost;
+      }
+
+      // The soft clauses below the level are the only ones whose cost is
+      // not bounded by 'lbCost'.
+      bool below = false;
+      for (int i = 0; i < nSoft && !below; i++)
+        below = !hardened[i] && getSoftWeight(i) < level;
+      if (!below || currentLB() >= ubCost) {
+        printAnswer(_OPTIMUM_);
+        return _OPTIMUM_;
+      }
+      level = nextStratum(level);
+      if (verbosity > 0)
+        printf("c Weight level : %-12" PRIu64 "\n", level);
+    } else {
+      nbCores++;
+      reduceCore(S);
+      sumSizeCores += S->conflict.size();
+
+      bool bounded = false;
+      uint64_t minWeight = 0;
+      joinLits.clear();
+      joinCoeffs.clear();
+      for (int i = 0; i < S->conflict.size(); i++) {
+        // Relaxed soft clauses are only assumed by the SWC encoding, when
+        // their weight exceeds the bound.
+        int soft_index = coreSoft(S->conflict[i]);
+        if (soft_index == -1 || relaxed[soft_index]) {
+          bounded = bounded || boundLits.count(~S->conflict[i]) > 0;
+          continue;
+        }
+        uint64_t w = getSoftWeight(soft_index);
+        if (minWeight == 0 || w < minWeight)
+          minWeight = w;
+        relaxed[soft_index] = true;
+        joinLits.push(getRelaxationLit(soft_index));
+        joinCoeffs.push(w);
+      }
+
+      // Without soft clauses to relax and without the bound, the core comes
+      // from the hard clauses and the hardened soft clauses. The hardened
+      // ones are only falsified by models that are not better than the best
+      // one, so that model is optimal.
+      if (joinLits.size() == 0 && !bounded) {
+        if (nbSatisfiable > 0) {
+          printAnswer(_OPTIMUM_);
+          return _OPTIMUM_;
+        }
+        printAnswer(_UNSATISFIABLE_);
+        return _UNSATISFIABLE_;
+      }
+
+      uint64_t lb = lbCost + minWeight;
+      if (bounded) {
+        uint64_t next = sums.atLeast(lbCost + 1);
+        lb = joinLits.size() == 0 ? next : std::min(lb, next);
+      }
+      for (int i = 0; i < joinCoeffs.size(); i++)
+        sums.add(joinCoeffs[i]);
+      lbCost = std::min(sums.atLeast(lb), ubCost);
+      if (verbosity > 0)
+        printf("c LB : %-12" PRIu64 "\n", lbCost);
+
+      if (nbSatisfiable > 0 && currentLB() >= ubCost) {
+        printAnswer(_OPTIMUM_);
+        return _OPTIMUM_;
+      }
+
+      for (int i = 0; i < joinLits.size(); i++) {
+        objLits.push(joinLits[i]);
+        objCoeffs.push(joinCoeffs[i]);
+        if (unitWeight == 0)
+          unitWeight = joinCoeffs[i];
+        else if (joinCoeffs[i] != unitWeight)
+          usePB = true;
+      }
+
+      encodingAssumptions.clear();
+      if (!usePB) {
+        int64_t rhs = lbCost / unitWeight;
+        if (!totalizer.hasCardEncoding()) {
+          if (rhs < objLits.size()) {
+            totalizer.buildCardinality(S, objLits, rhs);
+            totalizer.incUpdateCardinality(S, objLits, rhs,
+                                           encodingAssumptions);
+          }
+        } else {
+          if (joinLits.size() > 0)
+            totalizer.joinEncoding(S, joinLits, rhs);
+          totalizer.incUpdateCardinality(S, objLits, rhs, encodingAssumptions);
+        }
+      } else if (!pb.hasPBEncoding()) {
+        // The SWC encoding starts with every relaxed soft clause. It is only
+        // built with two literals below the bound; until then it keeps the
+        // literals it was given.
+        if (!pbStarted)
+          pb.incEncodePB(S, objLits, objCoeffs, lbCost, encodingAssumptions,
+                         nSoft);
+        else
+          pb.incEncodePB(S, joinLits, joinCoeffs, lbCost, encodingAssumptions,
+                         nSoft);
+        pbStarted = true;
+      } else {
+        pb.incUpdatePB(S, joinLits, joinCoeffs, lbCost, encodingAssumptions);
+        pb.incUpdatePBAssumptions(S, encodingAssumptions);
+      }
+      boundLits.clear();
+      for (int i = 0; i < encodingAssumptions.size(); i++)
+        boundLits.insert(encodingAssumptions[i]);
+    }
+
+    // Hardening. Only 'lbCost' bounds the weight of the relaxed soft
+    // clauses, the other lower bounds do not.
+    for (int i = 0; i < nSoft; i++) {
+      if (nbSatisfiable == 0 || relaxed[i] || hardened[i] ||
+          lbCost + getSoftWeight(i) < ubCost)
+        continue;
+      S->addClause(~getAssumptionLit(i));
+      hardened[i] = true;
+    }
+  }
+}
+
+/************************************************************************************************
+ //
+ // Checkpoints
+ //
+ ************************************************************************************************/
+
+static inline void hashWord(uint64_t &hash, uint64_t word) {
+  for (int i = 0; i < 8; i++, word >>= 8) {
+    hash ^= word & 0xff;
+    hash *= 1099511628211ULL;
+  }
+}
+
+// FNV-1a hash of the hard clauses, the soft clauses with their weights and
+// the constraints of the formula. A checkpoint can only be resumed with the
+// same formula.
+uint64_t MaxSAT::formulaFingerprint() {
+  uint64_t hash = 14695981039346656037ULL;
+  hashWord(hash, maxsat_formula->nInitialVars());
+  for (int i = 0; i < maxsat_formula->nHard(); i++) {
+    LitSpan clause = maxsat_formula->getHardClause(i);
+    for (int j = 0; j < clause.size(); j++)
+      hashWord(hash, toInt(clause[j]));
+    hashWord(hash, UINT64_MAX);
+  }
+  for (int i = 0; i < maxsat_formula->nSoft(); i++) {
+    LitSpan clause = maxsat_formula->getSoftClause(i);
+    hashWord(hash, maxsat_formula->getSoftWeight(i));
+    for (int j = 0; j < clause.size(); j++)
+      hashWord(hash, toInt(clause[j]));
+    hashWord(hash, UINT64_MAX);
+  }
+  for (int i = 0; i < maxsat_formula->nCard(); i++) {
+    Card *card = maxsat_formula->getCardinalityConstraint(i);
+    hashWord(hash, card->_rhs);
+    for (int j = 0; j < card->_lits.size(); j++)
+      hashWord(hash, toInt(card->_lits[j]));
+    hashWord(hash, UINT64_MAX);
+  }
+  for (int i = 0; i < maxsat_formula->nPB(); i++) {
+    PB *pb = maxsat_formula->getPBConstraint(i);
+    hashWord(hash, pb->_rhs);
+    for (int j = 0; j < pb->_lits.size(); j++) {
+      hashWord(hash, toInt(pb->_lits[j]));
+      hashWord(hash, pb->_coeffs[j]);
+    }
+    hashWord(hash, UINT64_MAX);
+  }
+  return hash;
+}
+
+void MaxSAT::setCheckpoint(const char *file, double interval) {
+  checkpoint_file = file;
+  checkpoint_interval = interval;
+  checkpoint_time = NSPACE::realTime();
+  checkpoint_fingerprint = formulaFingerprint();
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  takeCheckpoint : (force : bool)  ->  [void]
+  |
+  |  Description:
+  |
+  |    Saves the bounds, the best model and the state of the algorithm. If the
+  |    search has not found a model better than the one of the resumed
+  |    checkpoint, the model of the resumed checkpoint is kept. Copying the
+  |    model and the state before every SAT call would cost more than many
+  |    short SAT calls, so unless 'force' is set the state is only taken when
+  |    the bounds (hence the best model) changed since the last one; the
+  |    expiry of the interval forces it before the file is written.
+  |
+  |    The state is built aside and then swapped in under 'checkpoint_lock',
+  |    so that 'writeCheckpoint' from another thread always sees a whole one.
+  |
+  |________________________________________________________________________________________________@*/
+void MaxSAT::takeCheckpoint(bool force) {
+  uint64_t lb = searchStatus == _OPTIMUM_ ? ubCost : currentLB();
+  if (!force && checkpoint_taken && lb == checkpoint.lb &&
+      lbCost == checkpoint.cores && ubCost == checkpoint_ub)
+    return;
+
+  Checkpoint ck;
+  ck.fingerprint = checkpoint_fingerprint;
+  ck.nVars = maxsat_formula->nInitialVars();
+  ck.nSoft = maxsat_formula->nSoft();
+  ck.lb = lb;
+  ck.cores = lbCost;
+  ck.ub = ubCost;
+  if (!resume_state.model.empty() &&
+      (model.size() == 0 || resume_state.ub < ubCost)) {
+    ck.model = resume_state.model;
+    ck.ub = resume_state.ub;
+  } else {
+    for (int i = 0; i < model.size(); i++)
+      ck.model.push_back(model[i] == l_True);
+  }
+  saveState(ck);
+  checkpoint_ub = ubCost;
+
+  std::lock_guard<std::mutex> guard(checkpoint_lock);
+  std::swap(checkpoint, ck);
+  checkpoint_taken = true;
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  writeCheckpoint : (update : bool)  ->  [bool]
+  |
+  |  Description:
+  |
+  |    Writes the last checkpoint. Without 'update' it can be called from
+  |    another thread while the search runs (e.g. by the exit handler when
+  |    the time limit exceeds): it writes the state taken before the running
+  |    SAT call and never reads the state of the search. 'checkpoint_lock'
+  |    keeps the writes of the two threads from mixing in the temporary file.
+  |
+  |________________________________________________________________________________________________@*/
+bool MaxSAT::writeCheckpoint(bool update) {
+  if (checkpoint_file.empty())
+    return false;
+  if (update)
+    takeCheckpoint(true);
+  std::lock_guard<std::mutex> guard(checkpoint_lock);
+  if (!checkpoint_taken)
+    return false;
+  return checkpoint.save(checkpoint_file.c_str());
+}
+
+bool MaxSAT::resumeFrom(Checkpoint &ck) {
+  if (ck.fingerprint != formulaFingerprint() ||
+      ck.nVars != maxsat_formula->nInitialVars() ||
+      ck.nSoft != maxsat_formula->nSoft())
+    return false;
+
+  // The model must satisfy the hard clauses and have the saved cost.
+  if (!ck.model.empty()) {
+    vec<lbool> saved;
+    for (size_t i = 0; i < ck.model.size(); i++)
+      saved.push(ck.model[i] ? l_True : l_False);
+    for (int i = 0; i < maxsat_formula->nHard(); i++) {
+      LitSpan clause = maxsat_formula->getHardClause(i);
+      int j = 0;
+      while (j < clause.size() && var(clause[j]) < saved.size() &&
+             (saved[var(clause[j])] == l_True) == sign(clause[j]))
+        j++;
+      if (j == clause.size())
+        return false;
+    }
+    if (computeCostModel(saved) != ck.ub || ck.lb > ck.ub)
+      return false;
+  }
+
+  setInitialLB(ck.lb);
+  resume_state = ck;
+  resuming = true;
+  return true;
+}
+
+// Restores the best model and 'lbCost' of the resumed checkpoint. The search
+// continues as if the first model had been found, hence 'nbSatisfiable' is 1.
+bool MaxSAT::restoreSearch(const char *algorithm) {
+  if (!resuming)
+    return false;
+  resuming = false;
+  if (resume_state.algorithm != algorithm || resume_state.model.empty())
+    return false;
+
+  {
+    std::lock_guard<std::mutex> guard(model_lock);
+    model.clear();
+    for (size_t i = 0; i < resume_state.model.size(); i++)
+      model.push(resume_state.model[i] ? l_True : l_False);
+  }
+  ubCost = resume_state.ub;
+  lbCost = resume_state.cores;
+  nbSatisfiable = 1;
+  firstModelTime = cpuTime() - initialTime;
+  if (print)
+    printf("c Resumed %s with LB %" PRIu64 " and UB %" PRIu64 "\n", algorithm,
+           currentLB(), ubCost);
+  printBound(ubCost);
+  return true;
+}
+
 // Solve the formula without assumptions.
 lbool MaxSAT::searchSATSolver(Solver *S, bool pre) {
   vec<Lit> dummy; // Empty set of assumptions.
   return searchSATSolver(S, dummy, pre);
 }
 
+/*_________________________________________________________________________________________________
+  |
+  |  newRelaxationLit : (soft : int)  ->  [Lit]
+  |
+  |  Description:
+  |
+  |    Returns the literal that relaxes soft clause 'soft'. The relaxation
+  |    literal is true if the soft clause may be unsatisfied and its negation
+  |    is used as assumption. For a unit soft clause (l) the literal ~l is
+  |    already true exactly when the soft clause is unsatisfied. It is used
+  |    directly instead of a fresh variable and the clause (l v r) is not
+  |    needed. Each variable is only used once, so two unit soft clauses over
+  |    the same variable still get different relaxation literals.
+  |
+  |  Post-conditions:
+  |    * A fresh variable is added to the MaxSAT formula if 'soft' is not a
+  |      unit soft clause.
+  |
+  |________________________________________________________________________________________________@*/
+Lit MaxSAT::newRelaxationLit(int soft) {
+  LitSpan clause = maxsat_formula->getSoftClause(soft);
+
+  if (unit_relaxation && clause.size() == 1 &&
+      maxsat_formula->getRelaxationVars(soft).size() == 0) {
+    if (unitRelaxed.size() < maxsat_formula->nVars())
+      unitRelaxed.growTo(maxsat_formula->nVars(), false);
+    if (!unitRelaxed[var(clause[0])]) {
+      unitRelaxed[var(clause[0])] = true;
+      return ~clause[0];
+    }
+  }
+
+  return maxsat_formula->newLiteral();
+}
+
+// Tests if a soft clause is relaxed by the negation of its unit literal. The
+// relaxed soft clause is a tautology and is not added to the SAT solver.
+bool MaxSAT::isUnitRelaxed(int soft) {
+  LitSpan clause = getSoftClause(soft);
+  LitSpan relaxation = maxsat_formula->getRelaxationVars(soft);
+  return clause.size() == 1 && relaxation.size() == 1 &&
+         relaxation[0] == ~clause[0];
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  enumerateModels : (S : Solver *) (limit : int) (optimal_only : bool)
+  |                    (callback : ModelCallback)  ->  [int]
+  |
+  |  Description:
+  |
+  |    Enumerates models in non-decreasing order of cost. The number of
+  |    relaxed soft clauses is bounded by a totalizer over the relaxation
+  |    variables that starts at the optimum and is only increased when all
+  |    models with the current cost have been blocked. Models are blocked on
+  |    the original variables only, so each projected model is found once.
+  |    The SAT solver of the search is reused together with its learnt
+  |    clauses. The blocking clauses are guarded by a selector that is
+  |    disabled at the end, so the solver can be reused by later searches.
+  |
+  |  Pre-conditions:
+  |    * Assumes that the search found the optimum with solver 'S' and that
+  |      each soft clause has a relaxation variable.
+  |
+  |  Post-conditions:
+  |    * 'model' is updated to the last model found.
+  |
+  |________________________________________________________________________________________________@*/
+int MaxSAT::enumerateModels(Solver *S, int limit, bool optimal_only,
+                            ModelCallback callback) {
+  if (S == NULL || searchStatus != _OPTIMUM_) {
+    if(print) {
+      printf("Error: Enumeration requires an optimal solution.\n");
+      printf("s UNKNOWN\n");
+    }
+    throw MaxSATException(__FILE__, __LINE__, "Enumeration without optimum");
+  }
+
+  if (maxsat_formula->getProblemType() == _WEIGHTED_) {
+    if(print) {
+      printf("Error: Currently enumeration does not support weighted MaxSAT "
+             "instances.\n");
+      printf("s UNKNOWN\n");
+    }
+    throw MaxSATException(__FILE__, __LINE__,
+                          "Enumeration does not support weighted");
+  }
+
+  vec<Lit> objective;
+  for (int i = 0; i < maxsat_formula->nSoft(); i++)
+    objective.push(getRelaxationLit(i));
+
+  Encoder encoder(_INCREMENTAL_ITERATIVE_, _CARD_TOTALIZER_);
+  vec<Lit> assumptions;
+  vec<Lit> encodingAssumptions;
+  uint64_t bound = ubCost;
+  int nbModels = 0;
+
+  newSATVariable(S);
+  Lit selector = mkLit(S->nVars() - 1);
+
+  for (;;) {
+    assumptions.clear();
+    assumptions.push(~selector);
+    if (bound == 0) {
+      // The totalizer adds permanent unit clauses for a zero rhs.
+      for (int i = 0; i < objective.size(); i++)
+        assumptions.push(~objective[i]);
+    } else if (bound < (uint64_t)objective.size()) {
+      if (!encoder.hasCardEncoding())
+        encoder.buildCardinality(S, objective, bound);
+      encoder.incUpdateCardinality(S, objective, bound, encodingAssumptions);
+      for (int i = 0; i < encodingAssumptions.size(); i++)
+        assumptions.push(encodingAssumptions[i]);
+    }
+
+    lbool res = searchSATSolver(S, withUserAssumptions(S, assumptions));
+    if (res == l_True) {
+      nbModels++;
+      saveModel(S->model);
+      if (callback != NULL)
+        callback(this, computeCostModel(S->model));
+      if (limit != 0 && nbModels == limit)
+        break;
+      blockModel(S, selector);
+    } else if (res == l_False) {
+      // All models with cost 'bound' have been blocked.
+      if (optimal_only || bound >= (uint64_t)objective.size())
+        break;
+      bound++;
+    } else
+      break;
+  }
+
+  S->addClause(selector);
+  return nbModels;
+}
+
 /************************************************************************************************
  //
  // Utils for model management
@@ -137,11 +1197,64 @@ void MaxSAT::saveModel(vec<lbool> &currentModel) {
   assert(maxsat_formula->nInitialVars() != 0);
   assert(currentModel.size() != 0);
 
+  if (firstModelTime < 0)
+    firstModelTime = cpuTime() - initialTime;
+
+  std::lock_guard<std::mutex> guard(model_lock);
   model.clear();
   // Only store the value of the variables that belong to the
   // original MaxSAT formula.
   for (int i = 0; i < maxsat_formula->nInitialVars(); i++)
     model.push(currentModel[i]);
+  if (preprocessor != NULL)
+    preprocessor->extendModel(model);
+}
+
+void MaxSAT::copyModel(vec<lbool> &copy) {
+  std::lock_guard<std::mutex> guard(model_lock);
+  model.copyTo(copy);
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  improveModel : (currentModel : vec<lbool>&) (cost : uint64_t&)  ->
+  |                 [vec<lbool>&]
+  |
+  |  Description:
+  |
+  |    Runs 'local_search_flips' flips of local search from a model of cost
+  |    'cost' of the SAT solver. The variables of the user assumptions are
+  |    not flipped, so the model still answers the query. The snapshot of the
+  |    clauses is taken again if the formula grew since the last call, and a
+  |    cheaper model is published to the shared bounds of a portfolio.
+  |
+  |  Post-conditions:
+  |    * Returns 'currentModel' if no cheaper model was found; otherwise
+  |      returns that model and 'cost' is its cost.
+  |
+  |________________________________________________________________________________________________@*/
+vec<lbool> &MaxSAT::improveModel(vec<lbool> &currentModel, uint64_t &cost) {
+  if (local_search_flips == 0 || cost == 0)
+    return currentModel;
+  if (local_search == NULL)
+    local_search = new LocalSearch(maxsat_formula);
+  else if (!local_search->isSnapshotOf(maxsat_formula))
+    local_search->load(maxsat_formula);
+  if (!local_search->improve(currentModel, user_assumptions,
+                             local_search_flips, cost, improved_model))
+    return currentModel;
+  // 'cost' keeps no state, unlike 'computeCostModel'.
+  assert(maxsat_formula->getObjective().cost(improved_model) == cost);
+  if (shared_bounds != NULL)
+    shared_bounds->publishModel(improved_model, cost);
+  return improved_model;
+}
+
+void MaxSAT::printLocalSearch() {
+  if (local_search == NULL)
+    return;
+  printf("c local-search flips %" PRIu64 " improved %" PRIu64 "\n",
+         local_search->getFlips(), local_search->getImprovements());
 }
 
 /*_________________________________________________________________________________________________
@@ -155,6 +1268,8 @@ void MaxSAT::saveModel(vec<lbool> &currentModel) {
   |    the weights of the unsatisfied soft clauses.
   |    If a weight is specified, then it only considers the sum of the weights
   |    of the unsatisfied soft clauses with the specified weight.
+  |    The cost is computed from the flat index of the soft clauses of the
+  |    formula, incrementally from the previous model when possible.
   |
   |  Pre-conditions:
   |    * Assumes that 'currentModel' is not empty.
@@ -163,37 +1278,11 @@ void MaxSAT::saveModel(vec<lbool> &currentModel) {
 uint64_t MaxSAT::computeCostModel(vec<lbool> &currentModel, uint64_t weight) {
 
   assert(currentModel.size() != 0);
-  uint64_t currentCost = 0;
-
-  for (int i = 0; i < maxsat_formula->nSoft(); i++) {
-    bool unsatisfied = true;
-    for (int j = 0; j < maxsat_formula->getSoftClause(i).clause.size(); j++) {
-
-      if (weight != UINT64_MAX &&
-          maxsat_formula->getSoftClause(i).weight != weight) {
-        unsatisfied = false;
-        continue;
-      }
-
-      assert(var(maxsat_formula->getSoftClause(i).clause[j]) <
-             currentModel.size());
-      if ((sign(maxsat_formula->getSoftClause(i).clause[j]) &&
-           currentModel[var(maxsat_formula->getSoftClause(i).clause[j])] ==
-               l_False) ||
-          (!sign(maxsat_formula->getSoftClause(i).clause[j]) &&
-           currentModel[var(maxsat_formula->getSoftClause(i).clause[j])] ==
-               l_True)) {
-        unsatisfied = false;
-        break;
-      }
-    }
-
-    if (unsatisfied) {
-      currentCost += maxsat_formula->getSoftClause(i).weight;
-    }
-  }
-
-  return currentCost;
+  ObjectiveIndex &objective = maxsat_formula->getObjective();
+  if (weight != UINT64_MAX)
+    return objective.cost(currentModel, weight);
+  // Consecutive models usually differ in a few soft clauses.
+  return objective.updateCost(currentModel, objective_state);
 }
 
 /*_________________________________________________________________________________________________
@@ -221,8 +1310,8 @@ bool MaxSAT::isBMO(bool cache) {
   std::map<uint64_t, uint64_t> nbPartitionWeights;
 
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
-    partitionWeights.insert(maxsat_formula->getSoftClause(i).weight);
-    nbPartitionWeights[maxsat_formula->getSoftClause(i).weight]++;
+    partitionWeights.insert(maxsat_formula->getSoftWeight(i));
+    nbPartitionWeights[maxsat_formula->getSoftWeight(i)]++;
   }
 
   for (std::set<uint64_t>::iterator iter = partitionWeights.begin();
@@ -322,25 +1411,31 @@ void MaxSAT::print_Card_configuration(int encoding) {
   }
 }
 
-void MaxSAT::blockModel(Solver *solver) {
+// Blocks the current model on the original variables. If a selector is given
+// the blocking clause is only active while the selector is assumed false.
+void MaxSAT::blockModel(Solver *solver, Lit selector) {
   assert(model.size() != 0);
 
   vec<Lit> blocking;
 
-  printf("v ");
-  for (int i = 0; i < model.size(); i++) {
-    indexMap::const_iterator iter = maxsat_formula->getIndexToName().find(i);
-    if (iter != maxsat_formula->getIndexToName().end()) {
-      if (model[i] == l_False)
-        printf("-");
-      printf("%s ", iter->second.c_str());
+  if (print) {
+    printf("v ");
+    for (int i = 0; i < model.size(); i++) {
+      indexMap::const_iterator iter = maxsat_formula->getIndexToName().find(i);
+      if (iter != maxsat_formula->getIndexToName().end()) {
+        if (model[i] == l_False)
+          printf("-");
+        printf("%s ", iter->second.c_str());
+      }
     }
+    printf("\n");
   }
-  printf("\n");
 
   for (int i = 0; i < model.size(); i++) {
     blocking.push((model[i] == l_True) ? ~mkLit(i) : mkLit(i));
   }
+  if (selector != lit_Undef)
+    blocking.push(selector);
 
   solver->addClause(blocking);
 }
@@ -386,12 +1481,12 @@ std::string MaxSAT::printSoftClause(int id){
   assert (id < maxsat_formula->nSoft());
 
   std::stringstream ss;
-  ss << maxsat_formula->getSoftClause(id).weight << " ";
+  ss << maxsat_formula->getSoftWeight(id) << " ";
 
-  for (int j = 0; j < maxsat_formula->getSoftClause(id).clause.size(); j++){
-    if (sign(maxsat_formula->getSoftClause(id).clause[j]))
+  for (int j = 0; j < maxsat_formula->getSoftClause(id).size(); j++){
+    if (sign(maxsat_formula->getSoftClause(id)[j]))
       ss << "-";
-    ss << (var(maxsat_formula->getSoftClause(id).clause[j])+1) << " ";
+    ss << (var(maxsat_formula->getSoftClause(id)[j])+1) << " ";
   }
   ss << "0\n";
   return ss.str();
@@ -405,15 +1500,15 @@ void MaxSAT::printUnsatisfiedSoftClauses() {
   
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
     bool unsatisfied = true;
-    for (int j = 0; j < maxsat_formula->getSoftClause(i).clause.size(); j++) {
+    for (int j = 0; j < maxsat_formula->getSoftClause(i).size(); j++) {
 
-      assert(var(maxsat_formula->getSoftClause(i).clause[j]) <
+      assert(var(maxsat_formula->getSoftClause(i)[j]) <
              model.size());
-      if ((sign(maxsat_formula->getSoftClause(i).clause[j]) &&
-           model[var(maxsat_formula->getSoftClause(i).clause[j])] ==
+      if ((sign(maxsat_formula->getSoftClause(i)[j]) &&
+           model[var(maxsat_formula->getSoftClause(i)[j])] ==
                l_False) ||
-          (!sign(maxsat_formula->getSoftClause(i).clause[j]) &&
-           model[var(maxsat_formula->getSoftClause(i).clause[j])] ==
+          (!sign(maxsat_formula->getSoftClause(i)[j]) &&
+           model[var(maxsat_formula->getSoftClause(i)[j])] ==
                l_True)) {
         unsatisfied = false;
         break;
@@ -447,9 +1542,26 @@ void MaxSAT::printStats() {
   printf("c  Nb UNSAT calls:         %12d\n", nbCores);
   printf("c  Average core size:      %12.2f\n", avgCoreSize);
   printf("c  Nb symmetry clauses:    %12d\n", nbSymmetryClauses);
+  if (nbReducedCores > 0)
+    printf("c  Average reduced core:   %12.2f -> %.2f\n",
+           (float)sumSizeUnreduced / nbReducedCores,
+           (float)sumSizeReduced / nbReducedCores);
+  printProfile();
   printf("c\n");
 }
 
+void MaxSAT::printMemory(bool sample) {
+  if (sample)
+    sampleMemory();
+  memory.print(stdout, "c memory ");
+}
+
+void MaxSAT::printProfile() {
+#ifdef GLUCOSE_PROFILE
+  profile.print(stdout, "c profile ");
+#endif
+}
+
 // Prints the corresponding answer.
 void MaxSAT::printAnswer(int type) {
   if (verbosity > 0 && print)
@@ -501,17 +1613,16 @@ uint64_t MaxSAT::getUB() {
   for (int i = 0; i < maxsat_formula->nVars() + maxsat_formula->nSoft(); i++)
     newSATVariable(solver);
 
-  for (int i = 0; i < maxsat_formula->nHard(); i++)
-    solver->addClause(maxsat_formula->getHardClause(i).clause);
+  loadHardClauses(solver);
 
   vec<Lit> clause;
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
     clause.clear();
-    maxsat_formula->getSoftClause(i).clause.copyTo(clause);
+    maxsat_formula->getSoftClause(i).copyTo(clause);
 
-    for (int j = 0; j < maxsat_formula->getSoftClause(i).relaxation_vars.size();
-         j++)
-      clause.push(maxsat_formula->getSoftClause(i).relaxation_vars[j]);
+    LitSpan relaxation = maxsat_formula->getRelaxationVars(i);
+    for (int j = 0; j < relaxation.size(); j++)
+      clause.push(relaxation[j]);
 
     clause.push(relaxation_vars[i]);
 
@@ -547,13 +1658,12 @@ std::pair<uint64_t, int> MaxSAT::getLB() {
   for (int i = 0; i < maxsat_formula->nVars() + maxsat_formula->nSoft(); i++)
     newSATVariable(solver);
 
-  for (int i = 0; i < maxsat_formula->nHard(); i++)
-    solver->addClause(maxsat_formula->getHardClause(i).clause);
+  loadHardClauses(solver);
 
   vec<Lit> clause;
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
     clause.clear();
-    maxsat_formula->getSoftClause(i).clause.copyTo(clause);
+    maxsat_formula->getSoftClause(i).copyTo(clause);
 
     clause.push(relaxation_vars[i]);
 
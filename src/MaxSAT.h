@@ -36,11 +36,17 @@
 #include "core/Solver.h"
 #endif
 
+#include "Checkpoint.h"
+#include "Instrumentation.h"
 #include "MaxSATFormula.h"
+#include "LocalSearch.h"
 #include "MaxTypes.h"
+#include "Preprocessor.h"
+#include "SearchTrace.h"
 #include "utils/System.h"
 #include <algorithm>
 #include <map>
+#include <mutex>
 #include <set>
 #include <utility>
 #include <vector>
@@ -55,6 +61,28 @@ using NSPACE::cpuTime;
 
 namespace openwbo {
 
+class MaxSAT;
+
+// Called for every model found during the enumeration of models.
+typedef void (*ModelCallback)(MaxSAT *solver, uint64_t cost);
+
+// Bounds and best model shared by the engines of a portfolio. The methods are
+// called by the engines from their own threads (see Portfolio).
+class SharedBounds {
+public:
+  virtual ~SharedBounds() {}
+
+  // Conflicts of a slice of a SAT call. An engine checks 'cancelled' between
+  // two slices.
+  static const int64_t slice_conflicts = 10000;
+
+  virtual bool cancelled() = 0;      // Another engine ended the search.
+  virtual uint64_t lowerBound() = 0; // Best lower bound of all engines.
+  virtual uint64_t upperBound() = 0; // Cost of the best model of all engines.
+  virtual void publishLB(uint64_t lb) = 0;
+  virtual void publishModel(vec<lbool> &model, uint64_t cost) = 0;
+};
+
 class MaxSAT {
 
 public:
@@ -68,6 +96,9 @@ public:
     //  during the parsing of the MaxSAT formula.
     ubCost = 0;
     lbCost = 0;
+    initialLB = 0;
+    unit_relaxation = true;
+    firstModelTime = -1;
 
     off_set = 0;
 
@@ -81,6 +112,29 @@ public:
     print_soft = false;
     print = false;
     unsat_soft_file = NULL;
+    trace = NULL;
+    preprocessor = NULL;
+    memory_interval = 0;
+    memory_time = 0;
+    trace_node_first = -1;
+    trace_node_parts = 0;
+    checkpoint_interval = 0;
+    checkpoint_time = 0;
+    checkpoint_fingerprint = 0;
+    checkpoint_taken = false;
+    checkpoint_ub = 0;
+    resuming = false;
+    shared_bounds = NULL;
+    core_trim = 0;
+    core_min_budget = 0;
+    nbReductionCalls = 0;
+    nbReducedCores = 0;
+    sumSizeUnreduced = 0;
+    sumSizeReduced = 0;
+    disjoint_cores = false;
+    local_search = NULL;
+    local_search_flips = 0;
+    disjointLB = 0;
   }
 
   MaxSAT() {
@@ -92,6 +146,9 @@ public:
     //  during the parsing of the MaxSAT formula.
     ubCost = 0;
     lbCost = 0;
+    initialLB = 0;
+    unit_relaxation = true;
+    firstModelTime = -1;
 
     off_set = 0;
 
@@ -105,14 +162,40 @@ public:
     print_soft = false;
     print = false;
     unsat_soft_file = NULL;
+    trace = NULL;
+    preprocessor = NULL;
+    memory_interval = 0;
+    memory_time = 0;
+    trace_node_first = -1;
+    trace_node_parts = 0;
+    checkpoint_interval = 0;
+    checkpoint_time = 0;
+    checkpoint_fingerprint = 0;
+    checkpoint_taken = false;
+    checkpoint_ub = 0;
+    resuming = false;
+    shared_bounds = NULL;
+    core_trim = 0;
+    core_min_budget = 0;
+    nbReductionCalls = 0;
+    nbReducedCores = 0;
+    sumSizeUnreduced = 0;
+    sumSizeReduced = 0;
+    disjoint_cores = false;
+    local_search = NULL;
+    local_search_flips = 0;
+    disjointLB = 0;
   }
 
   virtual ~MaxSAT() {
     if (maxsat_formula != NULL)
       delete maxsat_formula;
+    if (local_search != NULL)
+      delete local_search;
   }
 
   void setInitialTime(double initial); // Set initial time.
+  void setInitialLB(uint64_t lb);      // Set an admissible lower bound.
 
   // Print configuration of the MaxSAT solver.
   // virtual void printConfiguration();
@@ -127,6 +210,11 @@ public:
   void print_Incremental_configuration(int incremental);
 
   virtual StatusCode search();      // MaxSAT search.
+
+  // Enumerates up to 'limit' models (0 = no limit) in non-decreasing order of
+  // cost after the search has proven the optimum. If 'optimal_only' is set
+  // only optimal models are enumerated. Returns the number of models found.
+  virtual int enumerate(int limit, bool optimal_only, ModelCallback callback);
   void printAnswer(int type); // Print the answer.
 
   // Tests if a MaxSAT formula has a lexicographical optimization criterion.
@@ -144,19 +232,76 @@ public:
     ubCost = maxsat_formula->getSumWeights();
   }
 
-  void blockModel(Solver *solver);
+  void blockModel(Solver *solver, Lit selector = lit_Undef);
+
+  // Extra assumptions that are added to the SAT calls of the next searches,
+  // e.g. variables that are fixed by a what-if query.
+  void setUserAssumptions(vec<Lit> &lits) {
+    clearUserAssumptions();
+    lits.copyTo(user_assumptions);
+    for (int i = 0; i < lits.size(); i++) {
+      if (toInt(~lits[i]) >= userConflict.size())
+        userConflict.growTo(toInt(~lits[i]) + 1, false);
+      userConflict[toInt(~lits[i])] = true;
+    }
+  }
+  void clearUserAssumptions() {
+    for (int i = 0; i < user_assumptions.size(); i++)
+      userConflict[toInt(~user_assumptions[i])] = false;
+    user_assumptions.clear();
+  }
+  bool isUserAssumption(Lit l) {
+    return toInt(~l) < userConflict.size() && userConflict[toInt(~l)];
+  }
 
   // Get bounds methods
   uint64_t getUB();
   std::pair<uint64_t, int> getLB();
 
-  Soft &getSoftClause(int i) { return maxsat_formula->getSoftClause(i); }
-  Hard &getHardClause(int i) { return maxsat_formula->getHardClause(i); }
+  // Adds the bytes used by the formula, the encoders and the SAT solver of
+  // the algorithm to 'mem'.
+  virtual void memoryUsage(MemoryUsage &mem);
+  // Samples the memory between two SAT calls at most once every 'interval'
+  // seconds to keep the peak of each component (0 = only when it is printed).
+  // A sample walks the clauses and the watches of the SAT solver.
+  void setMemoryInterval(double interval) { memory_interval = interval; }
+  // Takes a sample (unless 'sample' is false) and prints the current and the
+  // peak memory of each component.
+  void printMemory(bool sample = true);
+
+  // Saves the state of the search to 'file' at most once every 'interval'
+  // seconds. The state is taken before a SAT call when the bounds changed
+  // or the interval expired, hence it can be written at any time with
+  // 'writeCheckpoint'.
+  void setCheckpoint(const char *file, double interval);
+  // Writes the last state of the search to the checkpoint file. If 'update'
+  // is set, the state is taken first (e.g. at the end of the search), which
+  // only the thread of the search may do; other threads write the state
+  // taken before the running SAT call.
+  bool writeCheckpoint(bool update = false);
+  // Continues the search from the checkpoint of a previous run. The lower
+  // bound is used by every algorithm, while the algorithm that saved the
+  // checkpoint also restores its cores and its best model. Returns false if
+  // the checkpoint belongs to another formula.
+  bool resumeFrom(Checkpoint &ck);
+
+  // Prints the cycles of the hot functions of the SAT solver spent in the
+  // SAT calls of the solver (only with GLUCOSE_PROFILE).
+  void printProfile();
+
+  // Cost of the best model of the last search.
+  uint64_t getBestCost() { return ubCost; }
+  // CPU time of the first model of the last search (< 0 if none was found).
+  double getFirstModelTime() { return firstModelTime; }
+
+  LitSpan getSoftClause(int i) { return maxsat_formula->getSoftClause(i); }
+  LitSpan getHardClause(int i) { return maxsat_formula->getHardClause(i); }
+  uint64_t getSoftWeight(int i) { return maxsat_formula->getSoftWeight(i); }
   Lit getAssumptionLit(int soft) {
-    return maxsat_formula->getSoftClause(soft).assumption_var;
+    return maxsat_formula->getAssumptionVar(soft);
   }
   Lit getRelaxationLit(int soft, int i = 0) {
-    return maxsat_formula->getSoftClause(soft).relaxation_vars[i];
+    return maxsat_formula->getRelaxationVars(soft)[i];
   }
 
   int64_t getOffSet() { return off_set; }
@@ -167,6 +312,39 @@ public:
   bool getPrintModel() { return print_model; }
 
   void setPrint(bool doPrint) { print = doPrint; }
+
+  void setUnitRelaxation(bool unit) { unit_relaxation = unit; }
+
+  // Records every SAT call in 'tr' (not owned by the solver).
+  void setTrace(SearchTrace *tr) { trace = tr; }
+
+  // The formula was simplified by 'pre' (not owned by the solver): the saved
+  // models are extended to the variables it eliminated.
+  void setPreprocessor(Preprocessor *pre) { preprocessor = pre; }
+
+  // Reduces every core of the MSU3 algorithms: trims it by re-solving under
+  // its assumptions at most 'trim' times and minimises it by removing one
+  // soft clause at a time under a budget of 'budget' conflicts (0 = off).
+  void setCoreReduction(int trim, int64_t budget) {
+    core_trim = trim;
+    core_min_budget = budget;
+  }
+  // Prints the sizes of the cores before and after their reduction.
+  void printCoreReduction();
+
+  // Starts PartMSU3 (binary merging) and OLL (unweighted) with a phase that
+  // finds disjoint cores, which are then encoded before the search.
+  void setDisjointCores(bool disjoint) { disjoint_cores = disjoint; }
+
+  // Improves each model of PartMSU3, OLL and the weighted MSU3 with at most
+  // 'flips' flips of local search (0 = off).
+  void setLocalSearch(int flips) { local_search_flips = flips; }
+  // Prints the flips and the models improved by the local search.
+  void printLocalSearch();
+
+  // Shares the bounds and the models with the other engines of a portfolio.
+  // The search throws a MaxSATException when it is cancelled.
+  void setSharedBounds(SharedBounds *shared) { shared_bounds = shared; }
   bool getPrint() { return print; }
 
   void setPrintSoft(const char* file) { 
@@ -200,6 +378,10 @@ public:
     return -(int)v - 1;
   }
 
+  // Copies the best model to 'copy'. Unlike 'getValue', it can be called
+  // while the search runs in another thread.
+  void copyModel(vec<lbool> &copy);
+
 protected:
   // Interface with the SAT solver
   //
@@ -208,13 +390,118 @@ protected:
   lbool searchSATSolver(Solver *S, vec<Lit> &assumptions, bool pre = false);
   lbool searchSATSolver(Solver *S, bool pre = false);
 
+  // Counters of the SAT solver and bounds at the start of a SAT call.
+  struct SATCallStart {
+    uint64_t conflicts;
+    uint64_t decisions;
+    uint64_t propagations;
+    uint64_t lb;
+    uint64_t ub;
+    Instrumentation::Clock::time_point time;
+#ifdef GLUCOSE_PROFILE
+    NSPACE::SolverProfile profile;
+#endif
+  };
+  void startSATCall(Solver *S, SATCallStart &start);
+  // Adds a finished SAT call to the progress counters, the instrumentation,
+  // the profile and the trace. Threads that share the algorithm call it (and
+  // 'startSATCall') under a lock.
+  void recordSATCall(Solver *S, const SATCallStart &start, lbool res,
+                     int assumptions);
+
   void newSATVariable(Solver *S); // Creates a new variable in the SAT solver.
 
   void reserveSATVariables(Solver *S, unsigned maxVariable); // Reserve space for multiple variables in the SAT solver.
 
+  void loadHardClauses(Solver *S); // Adds the hard clauses to the SAT solver.
+
+  // Adds the bytes of the clause arena, watch lists and learnt clauses.
+  void solverMemoryUsage(Solver *S, MemoryUsage &mem);
+  void sampleMemory(); // Updates the peaks of 'memory'.
+
+  // Returns 'assumptions' extended with the user assumptions.
+  vec<Lit> &withUserAssumptions(Solver *S, vec<Lit> &assumptions);
+  // Writes to 'merged' the user assumptions followed by 'assumptions',
+  // without those that would open a needless decision level in 'S'.
+  void mergeUserAssumptions(Solver *S, vec<Lit> &assumptions,
+                            vec<Lit> &merged);
+
+  // Sets the node of the partition tree that is reported in the trace.
+  void setTraceNode(int first, int parts) {
+    trace_node_first = first;
+    trace_node_parts = parts;
+  }
+
+  // Clears the bounds and the model of a previous search.
+  void resetSearch();
+
+  // Lowers 'ubCost' to the upper bound shared by a portfolio between two
+  // slices of a SAT call on 'S'.
+  void sharedUpperBound(Solver *S);
+  // Called when 'sharedUpperBound' lowered 'ubCost'. Algorithms that bound
+  // the cost of their models with an encoding tighten it.
+  virtual void tightenUpperBound(Solver *S) {}
+
+  // Reduces the core of the last SAT call in 'S->conflict'.
+  void reduceCore(Solver *S);
+  // SAT call of 'reduceCore' with at most 'budget' conflicts (-1 = none).
+  lbool reductionCall(Solver *S, vec<Lit> &assumptions, int64_t budget);
+  // Finds cores over disjoint sets of soft clauses until the remaining soft
+  // clauses are satisfiable.
+  lbool findDisjointCores(Solver *S, std::vector<std::vector<int> > &cores);
+
+  // Next weight level of the stratification below 'weight'.
+  uint64_t nextStratum(uint64_t weight);
+  // Stratified MSU3 search for weighted formulas (used by MSU3 and
+  // PartMSU3), with a pseudo-Boolean bound on the relaxed soft clauses.
+  StatusCode weightedMSU3(Solver *S);
+
+  // Checkpoints
+  //
+  uint64_t formulaFingerprint(); // Hash of the clauses of the formula.
+  // Saves the state before a SAT call if the bounds changed or if 'force'.
+  void takeCheckpoint(bool force);
+  // Adds the state of the algorithm to 'ck' (the bounds and the model are
+  // saved by 'takeCheckpoint').
+  virtual void saveState(Checkpoint &ck) {}
+  // Restores the best model and the lower bound of the cores of the resumed
+  // checkpoint if it was saved by 'algorithm'. The algorithm restores the
+  // rest of its state from 'resume_state'.
+  bool restoreSearch(const char *algorithm);
+
+  // Relaxation of soft clauses
+  //
+  // Returns a relaxation literal for soft clause 'soft'. A unit soft clause is
+  // relaxed by the negation of its literal, so neither a fresh variable nor a
+  // relaxed clause is needed.
+  Lit newRelaxationLit(int soft);
+  // Tests if soft clause 'soft' is relaxed by the negation of its literal.
+  bool isUnitRelaxed(int soft);
+
+  // Maps assumption literal 'p' to soft clause 'soft'.
+  void mapCore(Lit p, int soft) {
+    if (toInt(p) >= coreMapping.size())
+      coreMapping.growTo(toInt(p) + 1, -1);
+    coreMapping[toInt(p)] = soft;
+  }
+  // Returns the soft clause of assumption literal 'p' (-1 if there is none).
+  // A unit soft clause relaxed by its literal shares it with the user
+  // assumptions that fix its variable, and then 'p' is taken as the user
+  // assumption: it stays assumed after the soft clause is relaxed.
+  int coreSoft(Lit p) {
+    if (toInt(p) < userConflict.size() && userConflict[toInt(p)])
+      return -1;
+    return toInt(p) < coreMapping.size() ? coreMapping[toInt(p)] : -1;
+  }
+
+  // Enumerates models with the SAT solver that was used in the search.
+  int enumerateModels(Solver *S, int limit, bool optimal_only,
+                      ModelCallback callback);
+
   // Properties of the MaxSAT formula
   //
   vec<lbool> model; // Stores the best satisfying model.
+  std::mutex model_lock; // Held while 'model' is written and by 'copyModel'.
   StatusCode searchStatus; // Stores the current state of the formula
 
   // Statistics
@@ -228,22 +515,87 @@ protected:
   //
   uint64_t ubCost; // Upper bound value.
   uint64_t lbCost; // Lower bound value.
+  uint64_t initialLB; // Admissible lower bound known before the search.
   int64_t off_set; // Offset of the objective function for PB solving.
 
   MaxSATFormula *maxsat_formula;
+  ObjectiveState objective_state; // Last model given to 'computeCostModel'.
+
+  vec<int> coreMapping;     // Maps assumption literals to soft clauses.
+  vec<bool> unitRelaxed;    // Variables used to relax unit soft clauses.
+  bool unit_relaxation;     // Relax unit soft clauses by their literal.
+
+  vec<Lit> user_assumptions;   // Assumptions set by the user.
+  vec<bool> userConflict;      // Negations of the user assumptions.
+  vec<Lit> merged_assumptions; // Assumptions of the algorithm + user.
 
   // Others
   // int currentWeight;  // Initialized to the maximum weight of soft clauses.
   double initialTime; // Initial time.
+  double firstModelTime; // Time of the first model of the search.
   int verbosity;      // Controls the verbosity of the solver.
   bool print_model;   // Controls if the model is printed at the end.
   bool print;         // Controls if data should be printed at all
   bool print_soft;    // Controls if the unsatified soft clauses are printed at the end.
   char * unsat_soft_file;  // Name of the file where the unsatisfied soft clauses will be printed.
 
+#ifdef GLUCOSE_PROFILE
+  NSPACE::SolverProfile profile; // Profile of the SAT calls.
+#endif
+
+  double memory_interval; // Seconds between two samples of the memory.
+  double memory_time;     // Time of the last sample of the memory.
+  MemoryUsage memory; // Memory of each component (last sample and peak).
+
+  SearchTrace *trace;   // Trace of the SAT calls (NULL if disabled).
+  Preprocessor *preprocessor; // Simplification of the formula (or NULL).
+  int trace_node_first; // First partition of the node in the trace.
+  int trace_node_parts; // Number of partitions of the node in the trace.
+
+  std::string checkpoint_file; // Checkpoint of the search ("" if disabled).
+  double checkpoint_interval;  // Seconds between writes of the checkpoint.
+  double checkpoint_time;      // Time of the last write of the checkpoint.
+  uint64_t checkpoint_fingerprint; // Hash of the formula of the checkpoint.
+  Checkpoint checkpoint;     // Last state taken (see 'checkpoint_taken').
+  bool checkpoint_taken;     // 'checkpoint' holds a state of the search.
+  uint64_t checkpoint_ub;    // 'ubCost' when 'checkpoint' was taken.
+  std::mutex checkpoint_lock; // Held while 'checkpoint' is replaced or saved.
+  Checkpoint resume_state; // State of the checkpoint that is being resumed.
+  bool resuming;           // 'resume_state' was not restored yet.
+
+  SharedBounds *shared_bounds; // Portfolio of the engine (NULL if none).
+
+  int core_trim;             // Maximum number of trimming calls per core.
+  int64_t core_min_budget;   // Conflicts of a minimisation call (0 = off).
+  int nbReductionCalls;      // SAT calls of the core reduction.
+  int nbReducedCores;        // Cores with more than one literal.
+  uint64_t sumSizeUnreduced; // Sum of their sizes before the reduction.
+  uint64_t sumSizeReduced;   // Sum of their sizes after the reduction.
+
+  bool disjoint_cores; // Start the search with the disjoint-core phase.
+
+  // Returns 'currentModel', of cost 'cost', or a cheaper model found by the
+  // local search from it, whose cost is then stored in 'cost'.
+  vec<lbool> &improveModel(vec<lbool> &currentModel, uint64_t &cost);
+  LocalSearch *local_search; // Built on the first model (NULL if unused).
+  int local_search_flips;    // Flips from each model (0 = off).
+  vec<lbool> improved_model; // Last model improved by the local search.
+
+  // Lower bound of the disjoint cores, which is kept when an algorithm only
+  // encodes some of them (reset with the search).
+  uint64_t disjointLB;
+
   // Different weights that corresponds to each function in the BMO algorithm.
   std::vector<uint64_t> orderWeights;
 
+  // Best lower bound: either the one obtained from cores, the one of the
+  // disjoint cores of this search or the one that was provided before the
+  // search.
+  uint64_t currentLB() {
+    uint64_t lb = lbCost > initialLB ? lbCost : initialLB;
+    return lb > disjointLB ? lb : disjointLB;
+  }
+
   // Utils for model management
   //
   void saveModel(vec<lbool> &currentModel); // Saves a Model.
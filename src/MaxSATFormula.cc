@@ -40,11 +40,27 @@ MaxSATFormula *MaxSATFormula::copyMaxSATFormula() {
   for (int i = 0; i < nVars(); i++)
     copymx->newVar();
 
-  for (int i = 0; i < nSoft(); i++)
-    copymx->addSoftClause(getSoftClause(i).weight, getSoftClause(i).clause);
+  vec<Lit> clause;
+  for (int i = 0; i < nSoft(); i++) {
+    getSoftClause(i).copyTo(clause);
+    copymx->addSoftClause(getSoftWeight(i), clause);
+  }
 
-  for (int i = 0; i < nHard(); i++)
-    copymx->addHardClause(getHardClause(i).clause);
+  for (int i = 0; i < nHard(); i++) {
+    getHardClause(i).copyTo(clause);
+    copymx->addHardClause(clause);
+  }
+  copymx->trusted_hard = trusted_hard;
+
+  for (int i = 0; i < nCard(); i++)
+    copymx->addCardinalityConstraint(
+        new Card(cardinality_constraints[i]->_lits,
+                 cardinality_constraints[i]->_rhs));
+  for (int i = 0; i < nPB(); i++)
+    copymx->addPBConstraint(new PB(pb_constraints[i]->_lits,
+                                   pb_constraints[i]->_coeffs,
+                                   pb_constraints[i]->_rhs,
+                                   pb_constraints[i]->_sign));
 
   copymx->setProblemType(getProblemType());
   copymx->updateSumWeights(getSumWeights());
@@ -56,23 +72,23 @@ MaxSATFormula *MaxSATFormula::copyMaxSATFormula() {
 
 // Adds a new hard clause to the hard clause database.
 void MaxSATFormula::addHardClause(vec<Lit> &lits) {
-  hard_clauses.push();
-  vec<Lit> copy_lits;
-  lits.copyTo(copy_lits);
-  new (&hard_clauses[hard_clauses.size() - 1]) Hard(copy_lits);
+  hard_clauses.add(lits);
   n_hard++;
+  trusted_hard = false;
+}
+
+// Adds hard clauses from a flat buffer to the hard clause database.
+void MaxSATFormula::addHardClauses(const vec<int> &sizes,
+                                   const vec<Lit> &lits) {
+  hard_clauses.add(sizes, lits);
+  n_hard += sizes.size();
 }
 
 // Adds a new soft clause to the hard clause database.
 void MaxSATFormula::addSoftClause(uint64_t weight, vec<Lit> &lits) {
-  soft_clauses.push();
-  vec<Lit> vars;
-  Lit assump = lit_Undef;
-  vec<Lit> copy_lits;
-  lits.copyTo(copy_lits);
-
-  new (&soft_clauses[soft_clauses.size() - 1])
-      Soft(copy_lits, weight, assump, vars);
+  objective.add(weight, lits);
+  assumption_vars.push(lit_Undef);
+  relaxation_vars.add();
   n_soft++;
 }
 
@@ -80,13 +96,11 @@ void MaxSATFormula::addSoftClause(uint64_t weight, vec<Lit> &lits) {
 // variables.
 void MaxSATFormula::addSoftClause(uint64_t weight, vec<Lit> &lits,
                                   vec<Lit> &vars) {
-  soft_clauses.push();
-  Lit assump = lit_Undef;
-  vec<Lit> copy_lits;
-  lits.copyTo(copy_lits);
-
-  new (&soft_clauses[soft_clauses.size() - 1])
-      Soft(copy_lits, weight, assump, vars);
+  objective.add(weight, lits);
+  assumption_vars.push(lit_Undef);
+  relaxation_vars.add();
+  for (int i = 0; i < vars.size(); i++)
+    relaxation_vars.push(relaxation_vars.size() - 1, vars[i]);
   n_soft++;
 }
 
@@ -147,14 +161,8 @@ void MaxSATFormula::setHardWeight(uint64_t weight) {
   hard_weight = weight;
 } // Sets the weight of hard clauses.
 
-Soft &MaxSATFormula::getSoftClause(int pos) {
-  assert(pos < nSoft());
-  return soft_clauses[pos];
-}
-
-Hard &MaxSATFormula::getHardClause(int pos) {
-  assert(pos < nHard());
-  return hard_clauses[pos];
+void MaxSATFormula::addCardinalityConstraint(Card *card) {
+  cardinality_constraints.push(card);
 }
 
 void MaxSATFormula::addPBConstraint(PB *p) {
@@ -222,3 +230,20 @@ void MaxSATFormula::convertPBtoMaxSAT() {
   else
     setProblemType(_WEIGHTED_);
 }
+
+void MaxSATFormula::memoryUsage(MemoryUsage &mem) {
+  mem.add(_MEM_HARD_, hard_clauses.bytes());
+  mem.add(_MEM_SOFT_, vecBytes(assumption_vars) + relaxation_vars.bytes());
+  objective.memoryUsage(mem);
+
+  uint64_t bytes = vecBytes(cardinality_constraints) + vecBytes(pb_constraints);
+  for (int i = 0; i < cardinality_constraints.size(); i++)
+    bytes += sizeof(Card) + vecBytes(cardinality_constraints[i]->_lits);
+  for (int i = 0; i < pb_constraints.size(); i++)
+    bytes += sizeof(PB) + vecBytes(pb_constraints[i]->_lits) +
+             vecBytes(pb_constraints[i]->_coeffs);
+  if (objective_function != NULL)
+    bytes += sizeof(PBObjFunction) + vecBytes(objective_function->_lits) +
+             vecBytes(objective_function->_coeffs);
+  mem.add(_MEM_PB_CARD_, bytes);
+}
@@ -34,8 +34,11 @@
 #include "core/Solver.h"
 #endif
 
+#include "ClauseArena.h"
 #include "FormulaPB.h"
 #include "MaxTypes.h"
+#include "MemoryUsage.h"
+#include "ObjectiveIndex.h"
 
 #include <map>
 #include <string>
@@ -50,42 +53,6 @@ namespace openwbo {
 typedef std::map<std::string, int> nameMap;
 typedef std::map<int, std::string> indexMap;
 
-class Soft {
-
-public:
-  /*! The soft class is used to model the soft clauses in a MaxSAT formula. */
-  Soft(const vec<Lit> &soft, uint64_t soft_weight, Lit assump_var,
-       const vec<Lit> &relax) {
-    soft.copyTo(clause);
-    weight = soft_weight;
-    assumption_var = assump_var;
-    relax.copyTo(relaxation_vars);
-  }
-
-  Soft() {}
-  ~Soft() {
-    clause.clear();
-    relaxation_vars.clear();
-  }
-
-  vec<Lit> clause;    //!< Soft clause
-  uint64_t weight;    //!< Weight of the soft clause
-  Lit assumption_var; //!< Assumption variable used for retrieving the core
-  vec<Lit> relaxation_vars; //!< Relaxation variables that will be added to the
-                            //! soft clause
-};
-
-class Hard {
-  /*! The hard class is used to model the hard clauses in a MaxSAT formula. */
-public:
-  Hard(const vec<Lit> &hard) { hard.copyTo(clause); }
-
-  Hard() {}
-  ~Hard() { clause.clear(); }
-
-  vec<Lit> clause; //!< Hard clause
-};
-
 class MaxSATFormula {
   /*! This class contains the MaxSAT formula and methods for adding soft and
    * hard clauses. */
@@ -93,28 +60,24 @@ public:
   MaxSATFormula()
       : hard_weight(UINT64_MAX), problem_type(_UNWEIGHTED_), n_vars(0),
         n_soft(0), n_hard(0), n_initial_vars(0), sum_soft_weight(0),
-        max_soft_weight(0) {
+        max_soft_weight(0), trusted_hard(true) {
     objective_function = NULL;
     format = _FORMAT_MAXSAT_;
   }
 
-  ~MaxSATFormula() {
-    for (int i = 0; i < nSoft(); i++) {
-      soft_clauses[i].clause.clear();
-      soft_clauses[i].relaxation_vars.clear();
-    }
-    soft_clauses.clear();
-
-    for (int i = 0; i < nHard(); i++)
-      hard_clauses[i].clause.clear();
-    hard_clauses.clear();
-  }
-
   MaxSATFormula *copyMaxSATFormula();
 
   /*! Add a new hard clause. */
   void addHardClause(vec<Lit> &lits);
 
+  /*! Add hard clauses in bulk. 'lits' holds the literals of all clauses one
+   * after another and 'sizes' the number of literals of each clause. The
+   * clauses must not contain duplicate or complementary literals. */
+  void addHardClauses(const vec<int> &sizes, const vec<Lit> &lits);
+
+  /*! True if every hard clause was added with 'addHardClauses'. */
+  bool hasTrustedHard() { return trusted_hard; }
+
   /*! Add a new soft clause. */
   void addSoftClause(uint64_t weight, vec<Lit> &lits);
 
@@ -146,11 +109,40 @@ public:
   /*! Set initial number of variables. */
   void setInitialVars(int vars);
 
-  /*! Return i-soft clause. */
-  Soft &getSoftClause(int pos);
+  /*! Return the literals of the i-soft clause. The span is valid until the
+   * next soft clause is added. */
+  LitSpan getSoftClause(int pos) {
+    assert(pos < nSoft());
+    return objective.getClause(pos);
+  }
+
+  /*! Return the weight of the i-soft clause. */
+  uint64_t getSoftWeight(int pos) { return objective.getWeight(pos); }
 
-  /*! Return i-hard clause. */
-  Hard &getHardClause(int pos);
+  /*! Change the weight of the i-soft clause. */
+  void setSoftWeight(int pos, uint64_t weight) {
+    objective.setWeight(pos, weight);
+  }
+
+  /*! Assumption variable of the i-soft clause, used for retrieving the core.
+   */
+  Lit getAssumptionVar(int pos) { return assumption_vars[pos]; }
+  void setAssumptionVar(int pos, Lit l) { assumption_vars[pos] = l; }
+
+  /*! Relaxation variables that are added to the i-soft clause. The span is
+   * valid until the next relaxation variable is added. */
+  LitSpan getRelaxationVars(int pos) { return relaxation_vars[pos]; }
+  void addRelaxationVar(int pos, Lit l) { relaxation_vars.push(pos, l); }
+
+  /*! Return the flat index of the soft clauses. */
+  ObjectiveIndex &getObjective() { return objective; }
+
+  /*! Return the literals of the i-hard clause. The span is valid until the
+   * next hard clause is added. */
+  LitSpan getHardClause(int pos) {
+    assert(pos < nHard());
+    return hard_clauses[pos];
+  }
 
   /*! Add a new cardinality constraint. */
   void addCardinalityConstraint(Card *card);
@@ -187,11 +179,16 @@ public:
 
   indexMap &getIndexToName() { return _indexToName; }
 
+  /*! Add the bytes of the hard, soft, PB and cardinality storage. */
+  void memoryUsage(MemoryUsage &mem);
+
 protected:
   // MaxSAT database
   //
-  vec<Soft> soft_clauses; //<! Stores the soft clauses of the MaxSAT formula.
-  vec<Hard> hard_clauses; //<! Stores the hard clauses of the MaxSAT formula.
+  ClauseArena hard_clauses; //<! Stores the hard clauses of the MaxSAT formula.
+  ObjectiveIndex objective; //<! Literals and weights of the soft clauses.
+  vec<Lit> assumption_vars;  //<! Assumption variable of each soft clause.
+  LitLists relaxation_vars;  //<! Relaxation variables of each soft clause.
 
   // PB database
   //
@@ -209,6 +206,7 @@ protected:
   int n_initial_vars;   //<! Number of variables of the initial MaxSAT formula.
   uint64_t sum_soft_weight; //<! Sum of weights of soft clauses.
   uint64_t max_soft_weight; //<! Maximum weight of soft clauses.
+  bool trusted_hard; //<! No hard clause has duplicate/complementary literals.
 
   // Utils for PB formulas
   //
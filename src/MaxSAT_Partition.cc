@@ -28,6 +28,7 @@
 #include "core/SolverTypes.h"
 
 #include "MaxSAT_Partition.h"
+#include "Instrumentation.h"
 #include "graph/Graph.h"
 #include "graph/Graph_Communities.h"
 
@@ -67,8 +68,7 @@ void MaxSAT_Partition::init() {
   for (int i = 0; i < maxsat_formula->nVars(); i++)
     newSATVariable(_solver);
 
-  for (int i = 0; i < maxsat_formula->nHard(); i++)
-    _solver->addClause(maxsat_formula->getHardClause(i).clause);
+  loadHardClauses(_solver);
 
   _graphMappingVar.clear();
   _graphMappingHard.clear();
@@ -84,10 +84,13 @@ void MaxSAT_Partition::init() {
 }
 
 void MaxSAT_Partition::split(int mode, int graphType) {
+  INSTR_TIMER(_PHASE_SPLIT_);
   init();
 
   if (!_solver->okay()) {
+    buildEmptyPartition();
     delete _solver;
+    _solver = NULL;
     return;
   }
 
@@ -110,7 +113,38 @@ void MaxSAT_Partition::split(int mode, int graphType) {
     }
   }
 
+  if (_nPartitions == 0)
+    buildEmptyPartition();
   delete _solver;
+  _solver = NULL;
+}
+
+// Used when the hard clauses fix every soft clause (e.g. on a board with a
+// single row) or are unsatisfiable: a single partition without clauses keeps
+// the guide tree of PartMSU3 non-empty.
+void MaxSAT_Partition::buildEmptyPartition() {
+  _nPartitions = 1;
+  _partitions.clear(true);
+  _partitions.growTo(_nPartitions);
+  for (int i = 0; i < _graphMappingVar.size(); i++)
+    _graphMappingVar[i] = -1;
+  for (int i = 0; i < _graphMappingSoft.size(); i++)
+    _graphMappingSoft[i] = -1;
+  for (int i = 0; i < _graphMappingHard.size(); i++)
+    _graphMappingHard[i] = -1;
+}
+
+void MaxSAT_Partition::memoryUsage(MemoryUsage &mem) {
+  MaxSAT::memoryUsage(mem);
+  uint64_t bytes = vecBytes(_graphMappingVar) + vecBytes(_graphMappingHard) +
+                   vecBytes(_graphMappingSoft) + vecBytes(_partitions) +
+                   _gc.memoryUsage();
+  for (int i = 0; i < _partitions.size(); i++)
+    bytes += vecBytes(_partitions[i].vars) + vecBytes(_partitions[i].sclauses) +
+             vecBytes(_partitions[i].hclauses);
+  if (_graph != NULL)
+    bytes += _graph->memoryUsage();
+  mem.add(_MEM_PARTITION_, bytes);
 }
 
 void MaxSAT_Partition::splitRandom() {
@@ -119,7 +153,7 @@ void MaxSAT_Partition::splitRandom() {
 
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
     // Satisfied or unsatisfied clauses are not assigned a community
-    if (!unassignedLiterals(maxsat_formula->getSoftClause(i).clause))
+    if (!unassignedLiterals(maxsat_formula->getSoftClause(i)))
       _graphMappingSoft[i] = -1;
     else {
       int c = rand() % _nPartitions;
@@ -129,7 +163,7 @@ void MaxSAT_Partition::splitRandom() {
   }
 }
 
-int MaxSAT_Partition::unassignedLiterals(vec<Lit> &sc) {
+int MaxSAT_Partition::unassignedLiterals(LitSpan sc) {
   int u = 0;
   for (int i = 0; i < sc.size(); i++)
     if (_solver->value(sc[i]) == l_True)
@@ -139,14 +173,14 @@ int MaxSAT_Partition::unassignedLiterals(vec<Lit> &sc) {
   return u;
 }
 
-bool MaxSAT_Partition::isUnsatisfied(vec<Lit> &sc) {
+bool MaxSAT_Partition::isUnsatisfied(LitSpan sc) {
   for (int i = 0; i < sc.size(); i++)
     if (_solver->value(sc[i]) != l_False)
       return false;
   return true;
 }
 
-void MaxSAT_Partition::printClause(vec<Lit> &sc) {
+void MaxSAT_Partition::printClause(LitSpan sc) {
   for (int i = 0; i < sc.size(); i++)
     printf("%d ", (sign(sc[i]) ? -(var(sc[i]) + 1) : (var(sc[i]) + 1)));
 }
@@ -179,7 +213,7 @@ void MaxSAT_Partition::buildSinglePartition() {
 
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
     // Put all unresolved clauses in single partition
-    if (unassignedLiterals(maxsat_formula->getSoftClause(i).clause)) {
+    if (unassignedLiterals(maxsat_formula->getSoftClause(i))) {
       _graphMappingSoft[i] = 0;
       _partitions[0].sclauses.push(i);
     } else
@@ -188,7 +222,7 @@ void MaxSAT_Partition::buildSinglePartition() {
 
   for (int ci = 0; ci < maxsat_formula->nHard(); ci++) {
     // Put all unresolved clauses in single partition
-    if (unassignedLiterals(maxsat_formula->getHardClause(ci).clause)) {
+    if (unassignedLiterals(maxsat_formula->getHardClause(ci))) {
       _graphMappingHard[ci] = 0;
       _partitions[0].hclauses.push(ci);
     } else
@@ -213,12 +247,12 @@ void MaxSAT_Partition::buildVIGPartitions() {
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
     // Compute which partition the soft clause belongs to...
 
-    if (unassignedLiterals(maxsat_formula->getSoftClause(i).clause)) {
+    if (unassignedLiterals(maxsat_formula->getSoftClause(i))) {
       int d = 0;
-      for (int j = 0; j < maxsat_formula->getSoftClause(i).clause.size(); j++) {
-        if (_solver->value(maxsat_formula->getSoftClause(i).clause[j]) ==
+      for (int j = 0; j < maxsat_formula->getSoftClause(i).size(); j++) {
+        if (_solver->value(maxsat_formula->getSoftClause(i)[j]) ==
             l_Undef) {
-          int v = var(maxsat_formula->getSoftClause(i).clause[j]);
+          int v = var(maxsat_formula->getSoftClause(i)[j]);
           int p = _graphMappingVar[v];
           w[p]++;
           if (w[p] > d) {
@@ -236,7 +270,7 @@ void MaxSAT_Partition::buildVIGPartitions() {
 
   for (int ci = 0; ci < maxsat_formula->nHard(); ci++) {
     // Compute which partition the hard clause belongs to...
-    vec<Lit> &c = maxsat_formula->getHardClause(ci).clause;
+    LitSpan c = maxsat_formula->getHardClause(ci);
     if (unassignedLiterals(c) == 0)
       continue;
 
@@ -339,12 +373,12 @@ Graph *MaxSAT_Partition::buildVIGGraph(bool weighted) {
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
     // Only considers unresolved soft clauses
     int ul;
-    if (ul = unassignedLiterals(maxsat_formula->getSoftClause(i).clause)) {
-      for (int j = 0; j < maxsat_formula->getSoftClause(i).clause.size(); j++) {
-        if (_solver->value(maxsat_formula->getSoftClause(i).clause[j]) ==
+    if (ul = unassignedLiterals(maxsat_formula->getSoftClause(i))) {
+      for (int j = 0; j < maxsat_formula->getSoftClause(i).size(); j++) {
+        if (_solver->value(maxsat_formula->getSoftClause(i)[j]) ==
             l_Undef)
-          graphWeight[var(maxsat_formula->getSoftClause(i).clause[j])] +=
-              ((double)maxsat_formula->getSoftClause(i).weight) / ul;
+          graphWeight[var(maxsat_formula->getSoftClause(i)[j])] +=
+              ((double)maxsat_formula->getSoftWeight(i)) / ul;
       }
     }
     _graphMappingSoft[i] = -1;
@@ -358,7 +392,7 @@ Graph *MaxSAT_Partition::buildVIGGraph(bool weighted) {
 
   int nEdges = 0;
   for (int ci = 0; ci < maxsat_formula->nHard(); ci++) {
-    vec<Lit> &c = maxsat_formula->getHardClause(ci).clause;
+    LitSpan c = maxsat_formula->getHardClause(ci);
     int ul = unassignedLiterals(c); // returns 0 if c is satisfied
     if (ul == 0)
       continue;
@@ -391,23 +425,23 @@ Graph *MaxSAT_Partition::buildVIGGraph(bool weighted) {
 
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
     // Only adds soft clauses that are being considered in the working formula
-    int ul = unassignedLiterals(maxsat_formula->getSoftClause(i).clause);
+    int ul = unassignedLiterals(maxsat_formula->getSoftClause(i));
     if (ul == 0)
       continue;
 
     double w = (weighted ? (2.0 / (ul * (ul - 1))) : 1.0);
-    for (int j = 0; j < maxsat_formula->getSoftClause(i).clause.size(); j++) {
-      if (_solver->value(maxsat_formula->getSoftClause(i).clause[j]) != l_Undef)
+    for (int j = 0; j < maxsat_formula->getSoftClause(i).size(); j++) {
+      if (_solver->value(maxsat_formula->getSoftClause(i)[j]) != l_Undef)
         continue;
 
-      for (int k = j + 1; k < maxsat_formula->getSoftClause(i).clause.size();
+      for (int k = j + 1; k < maxsat_formula->getSoftClause(i).size();
            k++) {
-        if (_solver->value(maxsat_formula->getSoftClause(i).clause[k]) !=
+        if (_solver->value(maxsat_formula->getSoftClause(i)[k]) !=
             l_Undef)
           continue;
 
-        int u = var(maxsat_formula->getSoftClause(i).clause[j]),
-            v = var(maxsat_formula->getSoftClause(i).clause[k]);
+        int u = var(maxsat_formula->getSoftClause(i)[j]),
+            v = var(maxsat_formula->getSoftClause(i)[k]);
         g->addEdge(_graphMappingVar[u], _graphMappingVar[v],
                    graphWeight[u] * graphWeight[v] * w);
         g->addEdge(_graphMappingVar[v], _graphMappingVar[u],
@@ -446,13 +480,13 @@ Graph *MaxSAT_Partition::buildCVIGGraph(bool weighted) {
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
     // Only considers unresolved soft clauses
     int ul;
-    if (ul = unassignedLiterals(maxsat_formula->getSoftClause(i).clause)) {
+    if (ul = unassignedLiterals(maxsat_formula->getSoftClause(i))) {
       _graphMappingSoft[i] = gVars + sVars++;
-      for (int j = 0; j < maxsat_formula->getSoftClause(i).clause.size(); j++) {
-        if (_solver->value(maxsat_formula->getSoftClause(i).clause[j]) ==
+      for (int j = 0; j < maxsat_formula->getSoftClause(i).size(); j++) {
+        if (_solver->value(maxsat_formula->getSoftClause(i)[j]) ==
             l_Undef)
-          graphWeight[var(maxsat_formula->getSoftClause(i).clause[j])] +=
-              ((double)maxsat_formula->getSoftClause(i).weight) / ul;
+          graphWeight[var(maxsat_formula->getSoftClause(i)[j])] +=
+              ((double)maxsat_formula->getSoftWeight(i)) / ul;
       }
     } else {
       // if (isUnsatisfied(softClauses[i].clause))
@@ -463,7 +497,7 @@ Graph *MaxSAT_Partition::buildCVIGGraph(bool weighted) {
 
   // Initialize graphMappingHard
   for (int i = 0; i < maxsat_formula->nHard(); i++) {
-    int ul = unassignedLiterals(maxsat_formula->getHardClause(i).clause);
+    int ul = unassignedLiterals(maxsat_formula->getHardClause(i));
     if (ul == 0)
       _graphMappingHard[i] = -1;
     else
@@ -475,7 +509,7 @@ Graph *MaxSAT_Partition::buildCVIGGraph(bool weighted) {
 
   for (int ci = 0; ci < maxsat_formula->nHard(); ci++) {
     if (_graphMappingHard[ci] != -1) { // -1 if it is not unresolved
-      vec<Lit> &c = maxsat_formula->getHardClause(ci).clause;
+      LitSpan c = maxsat_formula->getHardClause(ci);
       int ul = unassignedLiterals(c);
 
       // printf("c Clause %d is unresolved\n", ci);
@@ -507,15 +541,15 @@ Graph *MaxSAT_Partition::buildCVIGGraph(bool weighted) {
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
     // Only adds unresolved soft clauses
     if (_graphMappingSoft[i] != -1) { // -1 if it is not unresolved
-      int ul = unassignedLiterals(maxsat_formula->getSoftClause(i).clause);
+      int ul = unassignedLiterals(maxsat_formula->getSoftClause(i));
       // double w = (weighted ? (2.0 / (ul * (ul-1))) : 1.0);
 
-      for (int j = 0; j < maxsat_formula->getSoftClause(i).clause.size(); j++) {
-        if (_solver->value(maxsat_formula->getSoftClause(i).clause[j]) !=
+      for (int j = 0; j < maxsat_formula->getSoftClause(i).size(); j++) {
+        if (_solver->value(maxsat_formula->getSoftClause(i)[j]) !=
             l_Undef)
           continue;
 
-        int u = var(maxsat_formula->getSoftClause(i).clause[j]);
+        int u = var(maxsat_formula->getSoftClause(i)[j]);
         g->addEdge(_graphMappingVar[u], _graphMappingSoft[i],
                    ((double)graphWeight[u]) / ul);
         g->addEdge(_graphMappingSoft[i], _graphMappingVar[u],
@@ -537,7 +571,7 @@ Graph *MaxSAT_Partition::buildCVIGGraph(bool weighted) {
   return g;
 }
 
-int MaxSAT_Partition::markUnassignedLiterals(vec<Lit> &c, int *markedLits,
+int MaxSAT_Partition::markUnassignedLiterals(LitSpan c, int *markedLits,
                                              bool v) {
   int u = 0;
   for (int i = 0; i < c.size(); i++) {
@@ -568,13 +602,13 @@ Graph *MaxSAT_Partition::buildRESGraph(bool weighted) {
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
     // Only considers unresolved soft clauses
     int ul;
-    if (ul = unassignedLiterals(maxsat_formula->getSoftClause(i).clause)) {
+    if (ul = unassignedLiterals(maxsat_formula->getSoftClause(i))) {
       _graphMappingSoft[i] = sVars++;
-      for (int j = 0; j < maxsat_formula->getSoftClause(i).clause.size(); j++) {
-        if (_solver->value(maxsat_formula->getSoftClause(i).clause[j]) ==
+      for (int j = 0; j < maxsat_formula->getSoftClause(i).size(); j++) {
+        if (_solver->value(maxsat_formula->getSoftClause(i)[j]) ==
             l_Undef)
-          graphWeight[var(maxsat_formula->getSoftClause(i).clause[j])] +=
-              ((double)maxsat_formula->getSoftClause(i).weight) / ul;
+          graphWeight[var(maxsat_formula->getSoftClause(i)[j])] +=
+              ((double)maxsat_formula->getSoftWeight(i)) / ul;
       }
     } else
       _graphMappingSoft[i] = -1;
@@ -582,7 +616,7 @@ Graph *MaxSAT_Partition::buildRESGraph(bool weighted) {
 
   // Initialize graphMappingHard
   for (int i = 0; i < maxsat_formula->nHard(); i++) {
-    int ul = unassignedLiterals(maxsat_formula->getHardClause(i).clause);
+    int ul = unassignedLiterals(maxsat_formula->getHardClause(i));
     if (ul == 0)
       _graphMappingHard[i] = -1;
     else
@@ -594,7 +628,7 @@ Graph *MaxSAT_Partition::buildRESGraph(bool weighted) {
 
   for (int ci = 0; ci < maxsat_formula->nHard(); ci++) {
     if (_graphMappingHard[ci] != -1) { // -1 if it is not unresolved
-      vec<Lit> &c = maxsat_formula->getHardClause(ci).clause;
+      LitSpan c = maxsat_formula->getHardClause(ci);
 
       for (int i = 0; i < c.size(); i++) {
         if (_solver->value(c[i]) != l_Undef)
@@ -606,7 +640,7 @@ Graph *MaxSAT_Partition::buildRESGraph(bool weighted) {
 
   for (int ci = 0; ci < maxsat_formula->nHard(); ci++) {
     if (_graphMappingHard[ci] != -1) { // -1 if it is not unresolved
-      vec<Lit> &c = maxsat_formula->getHardClause(ci).clause;
+      LitSpan c = maxsat_formula->getHardClause(ci);
 
       // Mark clause literals - returns number of unassigned literals
       int mrk = markUnassignedLiterals(c, markedLits, true);
@@ -621,7 +655,7 @@ Graph *MaxSAT_Partition::buildRESGraph(bool weighted) {
           if (ri <= ci)
             continue; // avoid duplication checks
 
-          vec<Lit> &rc = maxsat_formula->getHardClause(ri).clause;
+          LitSpan rc = maxsat_formula->getHardClause(ri);
           int rl = 0, ul = mrk - 1;
 
           for (int j = 0; j < rc.size(); j++) {
@@ -669,7 +703,7 @@ Graph *MaxSAT_Partition::buildRESGraph(bool weighted) {
   // Connect soft clauses with hard clauses!!!
   for (int ci = 0; ci < maxsat_formula->nSoft(); ci++) {
     if (_graphMappingSoft[ci] != -1) { // -1 if it is not unresolved
-      vec<Lit> &c = maxsat_formula->getSoftClause(ci).clause;
+      LitSpan c = maxsat_formula->getSoftClause(ci);
 
       // Mark clause literals
       int mrk = markUnassignedLiterals(c, markedLits, true);
@@ -683,7 +717,7 @@ Graph *MaxSAT_Partition::buildRESGraph(bool weighted) {
           int ri = litClauses[li][iter];
           // if (ri <= ci) continue; //avoid duplication checks
 
-          vec<Lit> &rc = maxsat_formula->getHardClause(ri).clause;
+          LitSpan rc = maxsat_formula->getHardClause(ri);
           int rl = 0, ul = mrk - 1;
 
           for (int j = 0; j < rc.size(); j++) {
@@ -104,6 +104,9 @@ public:
     return h_val_pointer;
   }
 
+  // Adds the memory of the partitions and of the graph.
+  void memoryUsage(MemoryUsage &mem);
+
   int nVertexes() { return _graph->nVertexes(); }
   int nEdges() { return _graph->nEdges(); }
 
@@ -114,6 +117,7 @@ protected:
 
   void buildPartitions(int graphType);
   void buildSinglePartition();
+  void buildEmptyPartition();
   void buildVIGPartitions();
   void buildCVIGPartitions();
   void buildRESPartitions();
@@ -123,12 +127,12 @@ protected:
   Graph *buildCVIGGraph(bool weighted);
   Graph *buildRESGraph(bool weighted);
 
-  int unassignedLiterals(vec<Lit> &sc);
-  bool isUnsatisfied(vec<Lit> &sc);
+  int unassignedLiterals(LitSpan sc);
+  bool isUnsatisfied(LitSpan sc);
 
-  int markUnassignedLiterals(vec<Lit> &c, int *markedLits, bool v);
+  int markUnassignedLiterals(LitSpan c, int *markedLits, bool v);
 
-  void printClause(vec<Lit> &sc);
+  void printClause(LitSpan sc);
 
 protected:
   Solver *_solver;
@@ -56,6 +56,9 @@ enum {
   _ALGORITHM_MSU3_,
   _ALGORITHM_PART_MSU3_,
   _ALGORITHM_OLL_,
+  _ALGORITHM_PORTFOLIO_,
+  _ALGORITHM_CORE_BOOSTED_,
+  _ALGORITHM_IHS_,
   _ALGORITHM_BEST_
 };
 enum StatusCode {
@@ -0,0 +1,115 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#ifndef MemoryUsage_h
+#define MemoryUsage_h
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <map>
+
+#include "mtl/Vec.h"
+
+using NSPACE::vec;
+
+namespace openwbo {
+
+// Components whose memory is accounted.
+enum {
+  _MEM_HARD_ = 0,    // Hard clauses of the MaxSAT formula.
+  _MEM_SOFT_,        // Soft clauses of the MaxSAT formula.
+  _MEM_PB_CARD_,     // PB and cardinality constraints of the MaxSAT formula.
+  _MEM_ENCODERS_,    // Auxiliary structures of the encoders.
+  _MEM_PARTITION_,   // Partitions and graph of the community detection.
+  _MEM_SAT_ARENA_,   // Clause arena of the SAT solver.
+  _MEM_SAT_WATCHES_, // Watch lists of the SAT solver.
+  _MEM_SAT_LEARNTS_, // Learnt clauses of the SAT solver (part of the arena).
+  _MEM_COUNT_
+};
+
+// Bytes reserved by each component in the last sample and the largest value
+// seen over all samples.
+class MemoryUsage {
+
+public:
+  MemoryUsage() {
+    for (int i = 0; i < _MEM_COUNT_; i++)
+      current[i] = peak[i] = 0;
+  }
+
+  void clear() {
+    for (int i = 0; i < _MEM_COUNT_; i++)
+      current[i] = 0;
+  }
+
+  void add(int component, uint64_t bytes) { current[component] += bytes; }
+
+  // Ends a sample and updates the peaks.
+  void commit() {
+    for (int i = 0; i < _MEM_COUNT_; i++)
+      if (current[i] > peak[i])
+        peak[i] = current[i];
+  }
+
+  uint64_t getCurrent(int component) { return current[component]; }
+  uint64_t getPeak(int component) { return peak[component]; }
+
+  void print(FILE *out, const char *prefix) {
+    static const char *names[_MEM_COUNT_] = {
+        "hard",     "soft",      "pb-card",     "encoders",
+        "partition", "sat-arena", "sat-watches", "sat-learnts"};
+    for (int i = 0; i < _MEM_COUNT_; i++)
+      fprintf(out, "%s%-12s current %10.2f MB peak %10.2f MB\n", prefix,
+              names[i], current[i] / 1048576.0, peak[i] / 1048576.0);
+  }
+
+protected:
+  uint64_t current[_MEM_COUNT_];
+  uint64_t peak[_MEM_COUNT_];
+};
+
+// Bytes reserved by a vector (and by the vectors it contains).
+template <class T> inline uint64_t vecBytes(const vec<T> &v) {
+  return (uint64_t)v.capacity() * sizeof(T);
+}
+
+template <class T> inline uint64_t vecBytes(const vec<vec<T>> &v) {
+  uint64_t bytes = (uint64_t)v.capacity() * sizeof(vec<T>);
+  for (int i = 0; i < v.size(); i++)
+    bytes += vecBytes(v[i]);
+  return bytes;
+}
+
+// Approximate bytes of a std::map (one tree node per entry).
+template <class K, class V> inline uint64_t mapBytes(const std::map<K, V> &m) {
+  return (uint64_t)m.size() * (sizeof(std::pair<const K, V>) + 4 * sizeof(void *));
+}
+
+} // namespace openwbo
+
+#endif
@@ -0,0 +1,199 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "ObjectiveIndex.h"
+
+#include <atomic>
+
+using namespace openwbo;
+
+// The kernels read the values of a model as bytes: a literal is true if the
+// value of its variable is 0 (l_True) and the literal is positive, or 1
+// (l_False) and it is negative, that is, if the byte is the sign of the
+// literal. Undefined values (2 and 3) satisfy no literal.
+static_assert(sizeof(lbool) == 1, "lbool must be a single byte");
+static_assert(sizeof(Lit) == sizeof(int), "Lit must be an int");
+
+static inline const uint8_t *modelBytes(const vec<lbool> &model) {
+  return model.size() > 0 ? reinterpret_cast<const uint8_t *>(&model[0]) : NULL;
+}
+
+uint64_t ObjectiveIndex::newVersion() {
+  static std::atomic<uint64_t> next(1);
+  return next++;
+}
+
+void ObjectiveIndex::add(uint64_t weight, const vec<Lit> &clause) {
+  for (int i = 0; i < clause.size(); i++)
+    if (var(clause[i]) >= nVars)
+      nVars = var(clause[i]) + 1;
+  clauses.add(clause);
+  weights.push(weight);
+  all_units = all_units && clause.size() == 1;
+  version = newVersion();
+}
+
+uint64_t ObjectiveIndex::cost(const vec<lbool> &model, uint64_t weight) {
+  assert(model.size() >= nVars);
+  const uint8_t *values = modelBytes(model);
+  const vec<int> &offsets = clauses.getOffsets();
+  const vec<Lit> &lits = clauses.getLits();
+  uint64_t total = 0;
+
+  // Branch-free loop over unit soft clauses.
+  if (all_units && weight == UINT64_MAX && size() > 0) {
+    const int *lit = reinterpret_cast<const int *>(&lits[0]);
+    for (int i = 0; i < weights.size(); i++)
+      total += values[lit[i] >> 1] != (lit[i] & 1) ? weights[i] : 0;
+    return total;
+  }
+
+  for (int i = 0; i < weights.size(); i++) {
+    if (weight != UINT64_MAX && weights[i] != weight)
+      continue;
+    bool satisfied = false;
+    for (int j = offsets[i]; j < offsets[i + 1] && !satisfied; j++)
+      satisfied = values[var(lits[j])] == (toInt(lits[j]) & 1);
+    if (!satisfied)
+      total += weights[i];
+  }
+  return total;
+}
+
+uint64_t ObjectiveIndex::track(const vec<lbool> &model,
+                               ObjectiveState &state) {
+  assert(model.size() >= nVars);
+  const uint8_t *values = modelBytes(model);
+  const vec<int> &offsets = clauses.getOffsets();
+  const vec<Lit> &lits = clauses.getLits();
+  state.values.clear();
+  for (int v = 0; v < nVars; v++)
+    state.values.push(values[v]);
+  state.true_count.clear();
+  state.cost = 0;
+  for (int i = 0; i < weights.size(); i++) {
+    int count = 0;
+    for (int j = offsets[i]; j < offsets[i + 1]; j++)
+      count += values[var(lits[j])] == (toInt(lits[j]) & 1);
+    state.true_count.push(count);
+    if (count == 0)
+      state.cost += weights[i];
+  }
+  state.version = version;
+  return state.cost;
+}
+
+void ObjectiveIndex::buildOccurrences() {
+  const vec<int> &offsets = clauses.getOffsets();
+  const vec<Lit> &lits = clauses.getLits();
+  occ_offsets.clear();
+  occ_offsets.growTo(2 * nVars + 1, 0);
+  for (int i = 0; i < lits.size(); i++)
+    occ_offsets[toInt(lits[i]) + 1]++;
+  for (int l = 0; l < 2 * nVars; l++)
+    occ_offsets[l + 1] += occ_offsets[l];
+  occ_softs.clear();
+  occ_softs.growTo(lits.size());
+  vec<int> next;
+  for (int l = 0; l < 2 * nVars; l++)
+    next.push(occ_offsets[l]);
+  for (int i = 0; i < weights.size(); i++)
+    for (int j = offsets[i]; j < offsets[i + 1]; j++)
+      occ_softs[next[toInt(lits[j])]++] = i;
+  occ_lits = lits.size();
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  update : (model : const vec<lbool>&) (changed : const vec<int>&)
+  |           (state : ObjectiveState&)  ->  [uint64_t]
+  |
+  |  Description:
+  |
+  |    Incremental cost of 'model'. For each variable of 'changed' whose value
+  |    differs from 'state', the true literals of the soft clauses of its two
+  |    literals are counted again, and a soft clause changes the cost when its
+  |    count becomes or stops being 0. A state of an older version of the
+  |    index (soft clauses added or reweighted) is evaluated again.
+  |
+  |________________________________________________________________________________________________@*/
+uint64_t ObjectiveIndex::update(const vec<lbool> &model,
+                                const vec<int> &changed,
+                                ObjectiveState &state) {
+  if (state.version != version)
+    return track(model, state);
+  if (occ_lits != clauses.nLits())
+    buildOccurrences();
+
+  const uint8_t *values = modelBytes(model);
+  for (int i = 0; i < changed.size(); i++) {
+    int v = changed[i];
+    uint8_t before = state.values[v];
+    uint8_t after = values[v];
+    if (before == after)
+      continue;
+    for (int sign = 0; sign < 2; sign++) {
+      bool was_true = before == sign;
+      bool is_true = after == sign;
+      if (was_true == is_true)
+        continue;
+      int l = 2 * v + sign;
+      for (int j = occ_offsets[l]; j < occ_offsets[l + 1]; j++) {
+        int soft = occ_softs[j];
+        if (is_true && state.true_count[soft]++ == 0)
+          state.cost -= weights[soft];
+        else if (!is_true && --state.true_count[soft] == 0)
+          state.cost += weights[soft];
+      }
+    }
+    state.values[v] = after;
+  }
+  return state.cost;
+}
+
+uint64_t ObjectiveIndex::updateCost(const vec<lbool> &model,
+                                    ObjectiveState &state) {
+  if (state.version != version)
+    return track(model, state);
+
+  // The bytes of the variables are compared in one pass; with many changes
+  // the cost is evaluated again.
+  const uint8_t *values = modelBytes(model);
+  changed.clear();
+  for (int v = 0; v < nVars; v++)
+    if (values[v] != state.values[v])
+      changed.push(v);
+  if (changed.size() > weights.size() / 4)
+    return track(model, state);
+  return update(model, changed, state);
+}
+
+void ObjectiveIndex::memoryUsage(MemoryUsage &mem) {
+  mem.add(_MEM_SOFT_, clauses.bytes() + vecBytes(weights) +
+                          vecBytes(occ_offsets) + vecBytes(occ_softs) +
+                          vecBytes(changed));
+}
@@ -0,0 +1,125 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#ifndef ObjectiveIndex_h
+#define ObjectiveIndex_h
+
+#ifdef SIMP
+#include "simp/SimpSolver.h"
+#else
+#include "core/Solver.h"
+#endif
+
+#include "ClauseArena.h"
+#include "MemoryUsage.h"
+
+using NSPACE::vec;
+using NSPACE::Lit;
+using NSPACE::lbool;
+
+namespace openwbo {
+
+// Cost of the last model evaluated by 'ObjectiveIndex::track' or 'update':
+// the values of the variables of the objective and the number of true
+// literals of each soft clause.
+class ObjectiveState {
+
+public:
+  ObjectiveState() : version(0), cost(0) {}
+
+  uint64_t getCost() { return cost; }
+
+protected:
+  friend class ObjectiveIndex;
+
+  uint64_t version; // Version of the index (0 = not evaluated).
+  uint64_t cost;
+  vec<uint8_t> values;
+  vec<int> true_count;
+};
+
+// The soft clauses of a formula as flat arrays (struct of arrays): the
+// literals of soft clause i are clause i of a clause arena and its weight is
+// weights[i]. The cost of a model is computed in one pass over
+// the bytes of the 'lbool' values, and the cost of a model that differs from
+// a tracked one in a few variables is updated from the soft clauses of those
+// variables only.
+class ObjectiveIndex {
+
+public:
+  ObjectiveIndex()
+      : version(newVersion()), all_units(true), nVars(0), occ_lits(-1) {}
+
+  void add(uint64_t weight, const vec<Lit> &clause);
+  void setWeight(int soft, uint64_t weight) {
+    weights[soft] = weight;
+    version = newVersion();
+  }
+
+  int size() { return weights.size(); }
+  LitSpan getClause(int soft) { return clauses[soft]; }
+  uint64_t getWeight(int soft) { return weights[soft]; }
+
+  // Sum of the weights of the soft clauses without a true literal in
+  // 'model'. Only soft clauses of weight 'weight' are counted unless it is
+  // UINT64_MAX.
+  uint64_t cost(const vec<lbool> &model, uint64_t weight = UINT64_MAX);
+
+  // Evaluates 'model' and saves it in 'state'. Returns its cost.
+  uint64_t track(const vec<lbool> &model, ObjectiveState &state);
+  // Cost of 'model', which differs from the model of 'state' at most in the
+  // variables of 'changed'. 'state' is then the state of 'model'.
+  uint64_t update(const vec<lbool> &model, const vec<int> &changed,
+                  ObjectiveState &state);
+  // Cost of 'model', updated from 'state' when few variables changed.
+  uint64_t updateCost(const vec<lbool> &model, ObjectiveState &state);
+
+  void memoryUsage(MemoryUsage &mem);
+
+protected:
+  void buildOccurrences();
+  // Versions are unique over all the indexes, so a state is never taken as
+  // the state of another formula.
+  static uint64_t newVersion();
+
+  uint64_t version; // Changed by every update of the soft clauses.
+  bool all_units;   // Every soft clause has one literal.
+  int nVars;        // Variables of the soft clauses.
+
+  ClauseArena clauses;
+  vec<uint64_t> weights;
+
+  // Soft clauses of each literal (occ_offsets[toInt(l)] ..).
+  int occ_lits; // Literals of the index when the lists were built.
+  vec<int> occ_offsets;
+  vec<int> occ_softs;
+  vec<int> changed; // Variables that differ from the tracked model.
+};
+
+} // namespace openwbo
+
+#endif
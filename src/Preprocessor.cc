@@ -0,0 +1,387 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "Preprocessor.h"
+#include "simp/SimpSolver.h"
+
+#include <map>
+
+using namespace openwbo;
+
+namespace openwbo {
+
+// SimpSolver with access to its clauses, to unit propagation and to the
+// reconstruction of the eliminated variables.
+class Simplifier : public NSPACE::SimpSolver {
+public:
+  // Propagates 'p' at a new decision level. Returns false on a conflict,
+  // otherwise 'implied' has the literals implied by 'p' (including 'p').
+  bool probe(Lit p, vec<Lit> &implied) {
+    implied.clear();
+    newDecisionLevel();
+    uncheckedEnqueue(p);
+    bool consistent = propagate() == NSPACE::CRef_Undef;
+    for (int i = trail_lim[0]; consistent && i < trail.size(); i++)
+      implied.push(trail[i]);
+    cancelUntil(0);
+    return consistent;
+  }
+
+  // Fixes 'p' at decision level 0. Returns false if the clauses become
+  // unsatisfiable.
+  bool fix(Lit p) {
+    if (value(p) == l_False)
+      ok = false;
+    if (!ok || value(p) == l_True)
+      return ok;
+    uncheckedEnqueue(p);
+    ok = propagate() == NSPACE::CRef_Undef;
+    return ok;
+  }
+
+  // Remaining clauses without the false literals, followed by the units.
+  void getClauses(vec<int> &sizes, vec<Lit> &lits) {
+    for (int i = 0; i < clauses.size(); i++) {
+      NSPACE::Clause &c = ca[clauses[i]];
+      if (c.mark() != 0 || satisfied(c))
+        continue;
+      int size = 0;
+      for (int j = 0; j < c.size(); j++)
+        if (value(c[j]) == l_Undef) {
+          lits.push(c[j]);
+          size++;
+        }
+      sizes.push(size);
+    }
+    for (int i = 0; i < trail.size(); i++) {
+      lits.push(trail[i]);
+      sizes.push(1);
+    }
+  }
+
+  void extend(vec<lbool> &m) {
+    m.copyTo(model);
+    extendModel();
+    model.copyTo(m);
+  }
+
+  // Adds to 'occurs' the unassigned literals of the remaining clauses.
+  void countOccurrences(vec<int> &occurs) {
+    for (int i = 0; i < clauses.size(); i++) {
+      NSPACE::Clause &c = ca[clauses[i]];
+      if (c.mark() != 0 || satisfied(c))
+        continue;
+      for (int j = 0; j < c.size(); j++)
+        if (value(c[j]) == l_Undef)
+          occurs[toInt(c[j])]++;
+    }
+  }
+
+  int nUnits() { return trail.size(); }
+  int nEliminated() { return eliminated_vars; }
+};
+
+} // namespace openwbo
+
+Preprocessor::~Preprocessor() {
+  if (simplifier != NULL)
+    delete simplifier;
+}
+
+void Preprocessor::clearStats() {
+  hard_before = hard_after = 0;
+  units = eliminated = equivalent = dominated = soft_removed = 0;
+}
+
+void Preprocessor::extendModel(vec<lbool> &model) {
+  if (simplifier != NULL)
+    simplifier->extend(model);
+}
+
+// Representative of the class of equivalent literals of 'l'.
+static Lit findRepresentative(vec<Lit> &representative, Lit l) {
+  int v = var(l);
+  if (representative[v] == mkLit(v))
+    return l;
+  Lit r = findRepresentative(representative, representative[v]);
+  representative[v] = r;
+  return sign(l) ? ~r : r;
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  probe : (formula : MaxSATFormula *) (soft_of_var : vec<int>&)
+  |          (representative : vec<Lit>&)  ->  [void]
+  |
+  |  Description:
+  |
+  |    Failed-literal probing on the variables left by the elimination. A
+  |    literal whose propagation fails is fixed to false and a literal implied
+  |    by both phases of a variable is fixed to true. For the variables of
+  |    unit soft clauses ('soft_of_var' >= 0) it also records in
+  |    'representative' the equivalences v <-> q given by v -> q and
+  |    ~v -> ~q. The probing stops after a number of propagations
+  |    proportional to the size of the formula.
+  |
+  |________________________________________________________________________________________________@*/
+void Preprocessor::probe(MaxSATFormula *formula, vec<int> &soft_of_var,
+                         vec<Lit> &representative) {
+  Simplifier &S = *simplifier;
+  vec<Lit> pos, neg;
+  vec<char> implied_neg(2 * S.nVars(), 0);
+  uint64_t budget = S.propagations;
+  for (int i = 0; i < formula->nHard(); i++)
+    budget += 20 * formula->getHardClause(i).size();
+
+  for (int v = 0; v < S.nVars() && S.okay(); v++) {
+    if (S.propagations > budget)
+      break;
+    if (S.value(v) != l_Undef || S.isEliminated(v))
+      continue;
+
+    if (!S.probe(mkLit(v), pos)) {
+      S.fix(~mkLit(v));
+      continue;
+    }
+    if (!S.probe(~mkLit(v), neg)) {
+      S.fix(mkLit(v));
+      continue;
+    }
+
+    for (int i = 0; i < neg.size(); i++)
+      implied_neg[toInt(neg[i])] = 1;
+    for (int i = 1; i < pos.size(); i++) {
+      Lit q = pos[i];
+      if (implied_neg[toInt(q)])
+        S.fix(q);
+      else if (implied_neg[toInt(~q)] && soft_of_var[v] >= 0 &&
+               soft_of_var[var(q)] >= 0) {
+        Lit a = findRepresentative(representative, mkLit(v));
+        Lit b = findRepresentative(representative, q);
+        if (var(a) == var(b))
+          continue;
+        if (var(a) < var(b))
+          representative[var(b)] = sign(b) ? ~a : a;
+        else
+          representative[var(a)] = sign(a) ? ~b : b;
+      }
+    }
+    for (int i = 0; i < neg.size(); i++)
+      implied_neg[toInt(neg[i])] = 0;
+  }
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  fixDominated : (formula : MaxSATFormula *)  ->  [void]
+  |
+  |  Description:
+  |
+  |    A unit soft clause (l) whose negation is in no remaining hard clause,
+  |    in no soft clause and in no cardinality/PB constraint dominates ~l:
+  |    setting l to true in a model falsifies no clause and does not
+  |    increase the cost. Such literals are fixed to true, which satisfies
+  |    more clauses, until no other literal is dominated. Assumed variables
+  |    are skipped, since a search may assume ~l.
+  |
+  |________________________________________________________________________________________________@*/
+void Preprocessor::fixDominated(MaxSATFormula *formula) {
+  Simplifier &S = *simplifier;
+  vec<bool> skip(S.nVars(), false);
+  for (int v = 0; v < S.nVars() && v < assumed.size(); v++)
+    skip[v] = assumed[v];
+  for (int i = 0; i < formula->nCard(); i++)
+    for (int j = 0; j < formula->getCardinalityConstraint(i)->_lits.size(); j++)
+      skip[var(formula->getCardinalityConstraint(i)->_lits[j])] = true;
+  for (int i = 0; i < formula->nPB(); i++)
+    for (int j = 0; j < formula->getPBConstraint(i)->_lits.size(); j++)
+      skip[var(formula->getPBConstraint(i)->_lits[j])] = true;
+
+  for (bool changed = true; changed && S.okay();) {
+    changed = false;
+    vec<int> occurs(2 * S.nVars(), 0);
+    S.countOccurrences(occurs);
+    for (int i = 0; i < formula->nSoft(); i++) {
+      LitSpan clause = formula->getSoftClause(i);
+      for (int j = 0; j < clause.size(); j++)
+        occurs[toInt(clause[j])]++;
+    }
+    for (int i = 0; i < formula->nSoft() && S.okay(); i++) {
+      LitSpan clause = formula->getSoftClause(i);
+      if (clause.size() != 1 || skip[var(clause[0])] ||
+          S.value(clause[0]) != l_Undef || occurs[toInt(~clause[0])] > 0)
+        continue;
+      S.fix(clause[0]);
+      dominated++;
+      changed = true;
+    }
+  }
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  simplify : (formula : MaxSATFormula *) (elimination : bool)
+  |             (probing : bool)  ->  [MaxSATFormula *]
+  |
+  |  Description:
+  |
+  |    Builds a simplified copy of 'formula'. The hard clauses are simplified
+  |    by the SimpSolver with the variables of the soft clauses and of the
+  |    cardinality/PB constraints frozen: subsumption and self-subsuming
+  |    resolution always, bounded variable elimination if 'elimination' is
+  |    set. With 'probing' the failed-literal probing fixes more variables.
+  |    The literals of dominated unit soft clauses are then fixed to true
+  |    (see 'fixDominated').
+  |
+  |    Soft clauses satisfied by the fixed variables are removed. In weighted
+  |    formulas the unit soft clauses whose literals are equivalent are
+  |    merged into one soft clause with the sum of their weights (this would
+  |    make an unweighted formula weighted, so it is not done there). The
+  |    cost of every model is the same in both formulas.
+  |
+  |  Post-conditions:
+  |    * Returns NULL if the hard clauses are unsatisfiable.
+  |    * 'extendModel' completes the models of the simplified formula.
+  |
+  |________________________________________________________________________________________________@*/
+MaxSATFormula *Preprocessor::simplify(MaxSATFormula *formula,
+                                      bool elimination, bool probing) {
+  assert(formula->getFormat() == _FORMAT_MAXSAT_);
+  clearStats();
+  if (simplifier != NULL)
+    delete simplifier;
+  simplifier = new Simplifier();
+  Simplifier &S = *simplifier;
+
+  for (int i = 0; i < formula->nVars(); i++)
+    S.newVar();
+
+  vec<int> soft_of_var(formula->nVars(), -1);
+  for (int i = 0; i < formula->nSoft(); i++) {
+    LitSpan clause = formula->getSoftClause(i);
+    for (int j = 0; j < clause.size(); j++) {
+      S.setFrozen(var(clause[j]), true);
+      if (clause.size() == 1)
+        soft_of_var[var(clause[j])] = i;
+    }
+  }
+  for (int i = 0; i < formula->nCard(); i++)
+    for (int j = 0; j < formula->getCardinalityConstraint(i)->_lits.size(); j++)
+      S.setFrozen(var(formula->getCardinalityConstraint(i)->_lits[j]), true);
+  for (int i = 0; i < formula->nPB(); i++)
+    for (int j = 0; j < formula->getPBConstraint(i)->_lits.size(); j++)
+      S.setFrozen(var(formula->getPBConstraint(i)->_lits[j]), true);
+
+  hard_before = formula->nHard();
+  vec<Lit> clause;
+  for (int i = 0; i < formula->nHard() && S.okay(); i++) {
+    formula->getHardClause(i).copyTo(clause);
+    S.addClause(clause);
+  }
+
+  if (!elimination)
+    for (int v = 0; v < S.nVars(); v++)
+      S.setFrozen(v, true);
+  if (S.okay())
+    S.eliminate(true);
+
+  vec<Lit> representative;
+  for (int v = 0; v < S.nVars(); v++)
+    representative.push(mkLit(v));
+  if (probing && S.okay())
+    probe(formula, soft_of_var, representative);
+  if (S.okay())
+    fixDominated(formula);
+  if (S.okay())
+    S.simplify();
+  if (!S.okay())
+    return NULL;
+
+  MaxSATFormula *simplified = new MaxSATFormula();
+  for (int i = 0; i < formula->nVars(); i++)
+    simplified->newVar();
+  simplified->setFormat(formula->getFormat());
+
+  vec<int> sizes;
+  vec<Lit> lits;
+  S.getClauses(sizes, lits);
+  simplified->addHardClauses(sizes, lits);
+
+  // Unit soft clauses with equivalent literals are merged into the first one.
+  bool merge = formula->getProblemType() == _WEIGHTED_;
+  std::map<int, int> first; // Representative -> soft clause.
+  vec<uint64_t> weights;
+  for (int i = 0; i < formula->nSoft(); i++) {
+    weights.push(formula->getSoftWeight(i));
+    LitSpan clause = formula->getSoftClause(i);
+    bool sat = false;
+    for (int j = 0; j < clause.size(); j++)
+      sat = sat || S.value(clause[j]) == l_True;
+    if (sat) {
+      weights[i] = 0;
+      soft_removed++;
+      continue;
+    }
+    if (!merge || clause.size() != 1)
+      continue;
+    int key = toInt(findRepresentative(representative, clause[0]));
+    std::map<int, int>::iterator it = first.find(key);
+    if (it == first.end())
+      first[key] = i;
+    else {
+      weights[it->second] += weights[i];
+      weights[i] = 0;
+      equivalent++;
+      soft_removed++;
+    }
+  }
+  for (int i = 0; i < formula->nSoft(); i++) {
+    if (weights[i] == 0)
+      continue;
+    simplified->setMaximumWeight(weights[i]);
+    simplified->updateSumWeights(weights[i]);
+    formula->getSoftClause(i).copyTo(clause);
+    simplified->addSoftClause(weights[i], clause);
+  }
+
+  for (int i = 0; i < formula->nCard(); i++)
+    simplified->addCardinalityConstraint(
+        new Card(formula->getCardinalityConstraint(i)->_lits,
+                 formula->getCardinalityConstraint(i)->_rhs));
+  for (int i = 0; i < formula->nPB(); i++)
+    simplified->addPBConstraint(new PB(formula->getPBConstraint(i)->_lits,
+                                       formula->getPBConstraint(i)->_coeffs,
+                                       formula->getPBConstraint(i)->_rhs,
+                                       formula->getPBConstraint(i)->_sign));
+  simplified->setProblemType(formula->getProblemType());
+  simplified->setHardWeight(formula->getHardWeight());
+
+  hard_after = simplified->nHard();
+  units = S.nUnits();
+  eliminated = S.nEliminated();
+  return simplified;
+}
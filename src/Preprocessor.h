@@ -0,0 +1,99 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#ifndef Preprocessor_h
+#define Preprocessor_h
+
+#include "MaxSATFormula.h"
+
+using NSPACE::lbool;
+
+namespace openwbo {
+
+class Simplifier;
+
+// Simplifies the hard clauses of a MaxSAT formula before the search with the
+// SimpSolver of the SAT solver (subsumption, self-subsuming resolution and
+// bounded variable elimination) and failed-literal probing. The variables of
+// the soft clauses and of the cardinality/PB constraints are frozen, so the
+// cost of a model is the same in both formulas. Equivalent soft literals of
+// weighted formulas are merged into one soft clause; an unweighted formula
+// keeps them, since the merged clause would need the sum of their weights.
+// A unit soft clause whose literal is never falsified by another clause
+// dominates its negation and is satisfied by a hard unit.
+class Preprocessor {
+
+public:
+  Preprocessor() : simplifier(NULL) { clearStats(); }
+  ~Preprocessor();
+
+  // Returns the simplified formula (the original one is not changed), or
+  // NULL if the hard clauses are unsatisfiable.
+  MaxSATFormula *simplify(MaxSATFormula *formula, bool elimination,
+                          bool probing);
+
+  // Variable that a search may assume (e.g. a cell of a mask), so its soft
+  // clause is never replaced by a hard unit.
+  void setAssumed(int v) {
+    if (v >= assumed.size())
+      assumed.growTo(v + 1, false);
+    assumed[v] = true;
+  }
+
+  // Extends a model of the simplified formula to the eliminated variables.
+  void extendModel(vec<lbool> &model);
+
+  // Statistics of the last call to 'simplify'.
+  int nHardBefore() { return hard_before; }
+  int nHardAfter() { return hard_after; }
+  int nUnits() { return units; }
+  int nEliminated() { return eliminated; }
+  int nEquivalent() { return equivalent; }
+  int nDominated() { return dominated; }
+  int nSoftRemoved() { return soft_removed; }
+
+protected:
+  void clearStats();
+  void probe(MaxSATFormula *formula, vec<int> &soft_of_var,
+             vec<Lit> &representative);
+  void fixDominated(MaxSATFormula *formula);
+
+  Simplifier *simplifier;
+  vec<bool> assumed;
+
+  int hard_before;
+  int hard_after;
+  int units;
+  int eliminated;
+  int equivalent;
+  int dominated;
+  int soft_removed;
+};
+
+} // namespace openwbo
+
+#endif
@@ -0,0 +1,184 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "Progress.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+
+using namespace openwbo;
+
+int Progress::pipe_fds[2] = {-1, -1};
+void (*Progress::exit_handler)() = NULL;
+
+Progress::Progress()
+    : lb(0), ub(UINT64_MAX), sat_calls(0), cores(0), node_parts(0),
+      begin(std::chrono::steady_clock::now()), interval(0), out(stderr) {}
+
+// The instance is never destroyed, so that the exit handler can end the
+// process from the thread.
+Progress &Progress::get() {
+  static Progress *instance = new Progress();
+  return *instance;
+}
+
+void Progress::onSignal(int signum) {
+  int saved = errno;
+  char c = 'd';
+  if (write(pipe_fds[1], &c, 1) < 0) {
+    // Nothing to do: the pipe is full and a dump is already pending.
+  }
+  errno = saved;
+}
+
+void Progress::onExitSignal(int signum) {
+  int saved = errno;
+  char c = 'x';
+  if (write(pipe_fds[1], &c, 1) < 0) {
+    // Nothing to do: the pipe is full and the thread will read it.
+  }
+  errno = saved;
+}
+
+bool Progress::start(int interval, FILE *out) {
+  if (thread.joinable())
+    return true;
+  if (pipe(pipe_fds) != 0)
+    return false;
+  // The signal handler must never block on a full pipe.
+  fcntl(pipe_fds[1], F_SETFL, fcntl(pipe_fds[1], F_GETFL) | O_NONBLOCK);
+  this->interval = interval;
+  this->out = out;
+
+  if (interval >= 0) {
+    struct sigaction sa;
+    sa.sa_handler = onSignal;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = SA_RESTART;
+    sigaction(SIGUSR1, &sa, NULL);
+  }
+
+  thread = std::thread(&Progress::run, this);
+  return true;
+}
+
+void Progress::onExit(int signum, void (*handler)()) {
+  exit_handler = handler;
+  struct sigaction sa;
+  sa.sa_handler = onExitSignal;
+  sigemptyset(&sa.sa_mask);
+  sa.sa_flags = SA_RESTART;
+  sigaction(signum, &sa, NULL);
+}
+
+void Progress::stop() {
+  if (!thread.joinable())
+    return;
+  char c = 'q';
+  if (write(pipe_fds[1], &c, 1) == 1)
+    thread.join();
+  else
+    thread.detach();
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  run : [void]
+  |
+  |  Description:
+  |
+  |    Body of the reporting thread. Waits on the pipe with a timeout of
+  |    'interval' seconds: a timeout prints a heartbeat, a 'd' from the signal
+  |    handler prints a dump, an 'x' calls the exit handler and a 'q' from
+  |    'stop' ends the thread.
+  |
+  |________________________________________________________________________________________________@*/
+void Progress::run() {
+  std::chrono::steady_clock::time_point next =
+      std::chrono::steady_clock::now() + std::chrono::seconds(interval);
+  for (;;) {
+    int timeout = -1;
+    if (interval > 0) {
+      timeout = (int)std::chrono::duration_cast<std::chrono::milliseconds>(
+                    next - std::chrono::steady_clock::now())
+                    .count();
+      if (timeout < 0)
+        timeout = 0;
+    }
+
+    struct pollfd pfd = {pipe_fds[0], POLLIN, 0};
+    int ret = poll(&pfd, 1, timeout);
+    if (ret < 0 && errno == EINTR)
+      continue;
+
+    if (ret == 0) {
+      dump("heartbeat");
+      next += std::chrono::seconds(interval);
+      continue;
+    }
+
+    char buf[64];
+    ssize_t n = read(pipe_fds[0], buf, sizeof(buf));
+    bool quit = false, requested = false, exiting = false;
+    for (ssize_t i = 0; i < n; i++) {
+      if (buf[i] == 'q')
+        quit = true;
+      else if (buf[i] == 'x')
+        exiting = true;
+      else
+        requested = true;
+    }
+    if (requested)
+      dump("signal");
+    if (exiting && exit_handler != NULL)
+      exit_handler();
+    if (quit)
+      return;
+  }
+}
+
+void Progress::dump(const char *reason) {
+  double elapsed =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - begin)
+          .count();
+  uint64_t upper = ub.load(std::memory_order_relaxed);
+  char ub_str[32] = "-";
+  if (upper != UINT64_MAX)
+    snprintf(ub_str, sizeof(ub_str), "%" PRIu64, upper);
+  fprintf(out,
+          "c progress %s elapsed %.1f lb %" PRIu64 " ub %s sat-calls %" PRIu64
+          " cores %" PRIu64 " node-partitions %d\n",
+          reason, elapsed, lb.load(std::memory_order_relaxed), ub_str,
+          sat_calls.load(std::memory_order_relaxed),
+          cores.load(std::memory_order_relaxed),
+          node_parts.load(std::memory_order_relaxed));
+  fflush(out);
+}
@@ -0,0 +1,97 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#ifndef Progress_h
+#define Progress_h
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace openwbo {
+
+// Reports the progress of the search while it runs. The search publishes a
+// snapshot (bounds, SAT calls, cores and the partitions of the active node)
+// through atomics, so it never blocks. A background thread prints the
+// snapshot every 'interval' seconds and whenever the process receives
+// SIGUSR1; the signal handler only writes to a pipe that wakes the thread.
+// The thread also runs the handler of the signals that end the process, so
+// that it can print and allocate memory like any other thread.
+class Progress {
+
+public:
+  static Progress &get();
+
+  // Starts the reporting thread. With 'interval' = 0 there is no heartbeat
+  // and the snapshot is only printed on SIGUSR1; with 'interval' < 0 the
+  // snapshot is never printed.
+  bool start(int interval, FILE *out);
+  // Stops the reporting thread.
+  void stop();
+  // Calls 'handler' on the reporting thread when the process receives
+  // 'signum'. The handler usually ends the process with '_exit'.
+  void onExit(int signum, void (*handler)());
+
+  // Snapshot published by the search.
+  void publish(uint64_t lb, uint64_t ub, bool has_model, int node_parts) {
+    this->lb.store(lb, std::memory_order_relaxed);
+    this->ub.store(has_model ? ub : UINT64_MAX, std::memory_order_relaxed);
+    this->node_parts.store(node_parts, std::memory_order_relaxed);
+    sat_calls.fetch_add(1, std::memory_order_relaxed);
+  }
+  void addCore() { cores.fetch_add(1, std::memory_order_relaxed); }
+
+  // Prints the snapshot.
+  void dump(const char *reason);
+
+protected:
+  Progress();
+
+  void run();
+  static void onSignal(int signum);
+  static void onExitSignal(int signum);
+
+  std::atomic<uint64_t> lb;
+  std::atomic<uint64_t> ub;
+  std::atomic<uint64_t> sat_calls;
+  std::atomic<uint64_t> cores;
+  std::atomic<int> node_parts;
+
+  std::chrono::steady_clock::time_point begin;
+  int interval;
+  FILE *out;
+  std::thread thread;
+  static int pipe_fds[2]; // Written by the signal handler, read by the thread.
+  static void (*exit_handler)();
+};
+
+} // namespace openwbo
+
+#endif
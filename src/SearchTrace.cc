@@ -0,0 +1,61 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "SearchTrace.h"
+
+#include <inttypes.h>
+
+using namespace openwbo;
+
+SearchTrace::SearchTrace(FILE *out)
+    : out(out), search(0), start(std::chrono::steady_clock::now()) {
+  fprintf(out, "time,search,seconds,result,assumptions,core,lb,ub,cost,conflicts,"
+               "decisions,propagations,learnts,node_first,node_parts\n");
+}
+
+SearchTrace::~SearchTrace() { fclose(out); }
+
+SearchTrace *SearchTrace::open(const char *file) {
+  FILE *out = fopen(file, "w");
+  if (out == NULL)
+    return NULL;
+  return new SearchTrace(out);
+}
+
+void SearchTrace::write(const TraceRow &row) {
+  double time = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+  fprintf(out,
+          "%.6f,%d,%.6f,%s,%d,%d,%" PRIu64 ",%" PRIu64 ",%" PRId64 ",%" PRIu64
+          ",%" PRIu64 ",%" PRIu64 ",%d,%d,%d\n",
+          time, search, row.seconds,
+          row.result == 1 ? "SAT" : (row.result == 0 ? "UNSAT" : "UNKNOWN"),
+          row.assumptions, row.core, row.lb, row.ub, row.cost, row.conflicts,
+          row.decisions, row.propagations, row.learnts, row.node_first,
+          row.node_parts);
+}
@@ -0,0 +1,79 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#ifndef SearchTrace_h
+#define SearchTrace_h
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <chrono>
+
+namespace openwbo {
+
+// One row of the trace, i.e. the state of the search after a SAT call.
+struct TraceRow {
+  double seconds;      // Wall time of the call.
+  int result;          // 1 = SAT, 0 = UNSAT, -1 = interrupted.
+  int assumptions;     // Number of assumptions of the call.
+  int core;            // Size of the core (UNSAT calls only).
+  uint64_t lb;         // Lower bound before the call.
+  uint64_t ub;         // Upper bound before the call.
+  int64_t cost;        // Cost of the model (SAT calls only).
+  uint64_t conflicts;  // Conflicts of the call.
+  uint64_t decisions;  // Decisions of the call.
+  uint64_t propagations; // Propagations of the call.
+  int learnts;         // Learnt clauses in the database after the call.
+  int node_first;      // First partition of the active node of PartMSU3.
+  int node_parts;      // Partitions merged in the active node of PartMSU3.
+};
+
+// Writes a CSV time series with one row per SAT call of the MaxSAT
+// algorithms. Rows of different searches (e.g. the queries of a mask file)
+// are told apart by the 'search' column. The timestamp is the wall time since
+// the trace was created.
+class SearchTrace {
+
+public:
+  SearchTrace(FILE *out);
+  ~SearchTrace();
+
+  // Opens 'file' and writes the header. Returns NULL on error.
+  static SearchTrace *open(const char *file);
+
+  void newSearch() { search++; }
+  void write(const TraceRow &row);
+
+protected:
+  FILE *out;
+  int search;
+  std::chrono::steady_clock::time_point start;
+};
+
+} // namespace openwbo
+
+#endif
@@ -0,0 +1,166 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "Alg_CoreBoosted.h"
+
+using namespace openwbo;
+
+bool CoreBoosted::stopCoreGuided() {
+  if (boost_seconds > 0 && NSPACE::realTime() - start_time >= boost_seconds)
+    return true;
+  return boost_conflicts > 0 && solver->conflicts >= (uint64_t)boost_conflicts;
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  reformulatedObjective : (objective : vec<Lit>&)  ->  [void]
+  |
+  |  Description:
+  |
+  |    Each core of OLL added 1 to the lower bound and replaced its literals
+  |    by the outputs of a totalizer above its bound, hence the cost of a
+  |    model is 'lbCost' plus the number of true literals in the soft clauses
+  |    that are not in a core and in the outputs that are not bounded yet.
+  |    The totalizers of OLL only count up to their bound, so they are first
+  |    extended to count all their literals.
+  |
+  |  Post-conditions:
+  |    * 'objective' contains the literals of the reformulated objective.
+  |
+  |________________________________________________________________________________________________@*/
+void CoreBoosted::reformulatedObjective(vec<Lit> &objective) {
+  objective.clear();
+  for (int i = 0; i < maxsat_formula->nSoft(); i++)
+    if (!activeSoft[i])
+      objective.push(maxsat_formula->getAssumptionVar(i));
+
+  vec<Lit> assumptions;
+  for (std::set<Lit>::iterator it = core_outputs.begin();
+       it != core_outputs.end(); ++it) {
+    int id = boundMapping[*it].first.first;
+    int bound = boundMapping[*it].first.second;
+    Encoder *e = soft_cardinality[id];
+    if (e->lits().size() > bound + 1)
+      e->incUpdateCardinality(solver, e->lits(), e->lits().size() - 1,
+                              assumptions);
+    for (int i = bound; i < e->outputs().size(); i++)
+      objective.push(e->outputs()[i]);
+  }
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  linearSearch : [void] ->  [StatusCode]
+  |
+  |  Description:
+  |
+  |    SAT-UNSAT linear search over the reformulated objective. Every model
+  |    must be better than the best one, i.e. the objective is at most
+  |    'ubCost' - 1 - 'lbCost'; the search is optimal when no such model
+  |    exists. The phases of the variables are set to the last model.
+  |
+  |  Pre-conditions:
+  |    * The core-guided phase stopped after a model was found.
+  |
+  |________________________________________________________________________________________________@*/
+StatusCode CoreBoosted::linearSearch() {
+  vec<Lit> objective;
+  reformulatedObjective(objective);
+  if (verbosity > 0)
+    printf("c Linear search over %d literals (LB %" PRIu64 ", UB %" PRIu64
+           ")\n",
+           objective.size(), lbCost, ubCost);
+
+  vec<Lit> assumptions;
+  for (;;) {
+    if (ubCost == currentLB()) {
+      printAnswer(_OPTIMUM_);
+      return _OPTIMUM_;
+    }
+
+    uint64_t rhs = ubCost - 1 - lbCost;
+    if (rhs < (uint64_t)objective.size()) {
+      if (!linear_encoder.hasCardEncoding())
+        linear_encoder.encodeCardinality(solver, objective, rhs);
+      else
+        linear_encoder.updateCardinality(solver, rhs);
+    }
+
+    lbool res =
+        searchSATSolver(solver, withUserAssumptions(solver, assumptions));
+    if (res == l_False) {
+      nbCores++;
+      printAnswer(_OPTIMUM_);
+      return _OPTIMUM_;
+    }
+    if (res == l_Undef) {
+      printAnswer(_UNKNOWN_);
+      return _UNKNOWN_;
+    }
+
+    nbSatisfiable++;
+    uint64_t newCost = computeCostModel(solver->model);
+    assert(newCost < ubCost);
+    saveModel(solver->model);
+    printBound(newCost + off_set);
+    ubCost = newCost;
+    for (int i = 0; i < maxsat_formula->nInitialVars(); i++)
+      solver->setPolarity(i, solver->model[i] == l_False);
+  }
+}
+
+// The core-guided phase has no bound on the cost; the linear search has one
+// once it is encoded.
+void CoreBoosted::tightenUpperBound(Solver *S) {
+  if (S == solver && linear_encoder.hasCardEncoding())
+    linear_encoder.updateCardinality(solver, ubCost - 1 - lbCost);
+}
+
+StatusCode CoreBoosted::search() {
+  if (maxsat_formula->getProblemType() == _WEIGHTED_) {
+    if(print) {
+      printf("Error: Currently algorithm CoreBoosted does not support "
+             "weighted MaxSAT instances.\n");
+      printf("s UNKNOWN\n");
+    }
+    throw MaxSATException(__FILE__, __LINE__,
+                          "CoreBoosted does not support weighted");
+    return _UNKNOWN_;
+  }
+
+  printConfiguration();
+
+  start_time = NSPACE::realTime();
+  StatusCode status = unweighted();
+  if (status != _UNKNOWN_)
+    return status;
+
+  if (verbosity > 0)
+    printf("c Core-guided phase stopped after %.2f s\n",
+           NSPACE::realTime() - start_time);
+  return linearSearch();
+}
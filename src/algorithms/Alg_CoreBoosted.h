@@ -0,0 +1,105 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#ifndef Alg_CoreBoosted_h
+#define Alg_CoreBoosted_h
+
+#ifdef SIMP
+#include "simp/SimpSolver.h"
+#else
+#include "core/Solver.h"
+#endif
+
+#include "../Encoder.h"
+#include "Alg_OLL.h"
+
+namespace openwbo {
+
+//=================================================================================================
+// Core-boosted linear search: the unweighted OLL search finds cores until a
+// budget of time or conflicts is spent, then a SAT-UNSAT linear search
+// minimises the objective that OLL reformulated with the totalizers of its
+// cores, in the same SAT solver.
+class CoreBoosted : public OLL {
+
+public:
+  CoreBoosted(int verb = _VERBOSITY_MINIMAL_, double seconds = 5,
+              int64_t conflicts = 0)
+      : OLL(verb, _CARD_TOTALIZER_), boost_seconds(seconds),
+        boost_conflicts(conflicts), start_time(0) {}
+
+  StatusCode search();
+
+  // Adds the memory of the encoder of the linear search.
+  void memoryUsage(MemoryUsage &mem) {
+    OLL::memoryUsage(mem);
+    mem.add(_MEM_ENCODERS_, linear_encoder.memoryUsage());
+  }
+
+  // The models of the linear search are restricted by its last bound.
+  int enumerate(int limit, bool optimal_only, ModelCallback callback) {
+    return MaxSAT::enumerate(limit, optimal_only, callback);
+  }
+
+  // Print solver configuration.
+  void printConfiguration() {
+
+    if(!print) return;
+
+    printf("c ==========================================[ Solver Settings "
+           "]============================================\n");
+    printf("c |                                                                "
+           "                                       |\n");
+    printf("c |  Algorithm: %23s                                             "
+           "                      |\n",
+           "CoreBoosted");
+    print_Card_configuration(encoding);
+    printf("c |                                                                "
+           "                                       |\n");
+  }
+
+protected:
+  // Stops the core-guided phase when its budget is spent.
+  bool stopCoreGuided();
+
+  // Linear search over the reformulated objective.
+  StatusCode linearSearch();
+  // Bounds the reformulated objective by the upper bound of a portfolio.
+  void tightenUpperBound(Solver *S);
+  // Literals of the reformulated objective: the soft clauses that are not in
+  // a core and the outputs of each core above its bound.
+  void reformulatedObjective(vec<Lit> &objective);
+
+  Encoder linear_encoder; // Upper bound of the linear search.
+
+  double boost_seconds;    // Time of the core-guided phase (0 = no limit).
+  int64_t boost_conflicts; // Conflicts of the core-guided phase (0 = no limit).
+  double start_time;       // Start of the search.
+};
+} // namespace openwbo
+
+#endif
@@ -0,0 +1,342 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#include "Alg_IHS.h"
+
+#include <cmath>
+
+using namespace openwbo;
+
+/*_________________________________________________________________________________________________
+  |
+  |  extractCores : (hs : std::vector<int>&)  ->  [int]
+  |
+  |  Description:
+  |
+  |    Solves under the assumptions of the soft clauses that are neither in
+  |    'hs' nor fixed. The soft clauses of each core are added to 'hs', so the
+  |    cores of one call are disjoint, until the SAT call is satisfiable.
+  |
+  |  Post-conditions:
+  |    * The cores are added to the hitting set solver and the model of the
+  |      last SAT call is saved if it is the best one.
+  |    * Returns the number of cores, or -1 if a core has no soft clauses,
+  |      i.e. no model is better than the best one, or -2 if a SAT call was
+  |      interrupted.
+  |
+  |________________________________________________________________________________________________@*/
+int IHS::extractCores(std::vector<int> &hs) {
+  vec<bool> inSet(maxsat_formula->nSoft(), false);
+  for (size_t i = 0; i < hs.size(); i++)
+    inSet[hs[i]] = true;
+
+  vec<Lit> assumptions;
+  int found = 0;
+  for (;;) {
+    assumptions.clear();
+    for (int i = 0; i < maxsat_formula->nSoft(); i++)
+      if (!inSet[i] && !hitting_set.isForbidden(i))
+        assumptions.push(~getAssumptionLit(i));
+
+    lbool res =
+        searchSATSolver(solver, withUserAssumptions(solver, assumptions));
+    if (res == l_Undef)
+      return -2;
+    if (res == l_True) {
+      nbSatisfiable++;
+      uint64_t newCost = computeCostModel(solver->model);
+      if (newCost < ubCost) {
+        saveModel(solver->model);
+        printBound(newCost);
+        ubCost = newCost;
+      }
+      return found;
+    }
+
+    reduceCore(solver);
+    nbCores++;
+    sumSizeCores += solver->conflict.size();
+    std::vector<int> core;
+    for (int i = 0; i < solver->conflict.size(); i++) {
+      int soft_index = coreSoft(solver->conflict[i]);
+      if (soft_index != -1)
+        core.push_back(soft_index);
+    }
+    if (core.empty())
+      return -1;
+
+    hitting_set.addCore(core);
+    for (size_t i = 0; i < core.size(); i++)
+      inSet[core[i]] = true;
+    found++;
+  }
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  fixSoftClauses : [void]  ->  [uint64_t]
+  |
+  |  Description:
+  |
+  |    Reduced-cost fixing. The Lagrangian bound of the cores is a lower bound
+  |    and a model that falsifies soft clause i costs at least the bound plus
+  |    the reduced cost of i. If that is not smaller than 'ubCost' the soft
+  |    clause is hardened, since no better model falsifies it. Costs are
+  |    integers, so the bounds are rounded up after a tolerance for the
+  |    floating point error.
+  |
+  |  Post-conditions:
+  |    * The fixed soft clauses are unit clauses of the SAT solver and are
+  |      forbidden in the hitting sets.
+  |    * Returns the Lagrangian bound, or UINT64_MAX if the fixed soft
+  |      clauses leave a core without soft clauses. 'hs' is the hitting set
+  |      of the Lagrangian heuristic and 'cost' its cost.
+  |
+  |________________________________________________________________________________________________@*/
+uint64_t IHS::fixSoftClauses(std::vector<int> &hs, uint64_t &cost) {
+  std::vector<double> reduced;
+  double bound = hitting_set.lagrangian(ubCost, reduced, hs, cost);
+  if (std::isinf(bound))
+    return UINT64_MAX;
+  double eps = 1e-6 * std::max(1.0, bound);
+
+  for (int i = 0; i < maxsat_formula->nSoft(); i++) {
+    if (hitting_set.isForbidden(i) ||
+        std::ceil(bound + reduced[i] - eps) < (double)ubCost)
+      continue;
+    solver->addClause(~getAssumptionLit(i));
+    hitting_set.forbid(i);
+    nbFixed++;
+  }
+  return (uint64_t)std::ceil(bound - eps);
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  search : [void] ->  [StatusCode]
+  |
+  |  Description:
+  |
+  |    Implicit hitting set algorithm. After a phase of disjoint cores, each
+  |    iteration finds the minimum-cost hitting set of the cores, which is a
+  |    lower bound, and extracts the cores of the soft clauses that are not
+  |    in it. If there are none the model of the SAT call is optimal. The
+  |    cores of the exact hitting set are followed by up to 'greedy_rounds'
+  |    greedy hitting sets while they find new cores, since the exact one is
+  |    the most expensive step. The exact solver stops after 'node_limit'
+  |    nodes in a component, and then only its root bound is a lower bound.
+  |    The SAT solver is incremental: only the assumptions change.
+  |
+  |  For further details see:
+  |    *  Jessica Davies, Fahiem Bacchus: Solving MAXSAT by Solving a Sequence
+  |       of Simpler SAT Instances. CP 2011: 225-239
+  |
+  |  Post-conditions:
+  |    * 'ubCost', 'lbCost', 'nbSatisfiable' and 'nbCores' are updated.
+  |
+  |________________________________________________________________________________________________@*/
+StatusCode IHS::search() {
+  printConfiguration();
+
+  initRelaxation();
+  solver = rebuildSolver();
+
+  std::vector<uint64_t> weights(maxsat_formula->nSoft());
+  for (int i = 0; i < maxsat_formula->nSoft(); i++) {
+    mapCore(getAssumptionLit(i), i);
+    weights[i] = getSoftWeight(i);
+  }
+  hitting_set.init(weights);
+
+  std::vector<std::vector<int> > cores;
+  lbool res = findDisjointCores(solver, cores);
+  if (res == l_False) {
+    printAnswer(_UNSATISFIABLE_);
+    return _UNSATISFIABLE_;
+  }
+  if (res == l_Undef) {
+    printAnswer(_UNKNOWN_);
+    return _UNKNOWN_;
+  }
+  for (size_t i = 0; i < cores.size(); i++)
+    hitting_set.addCore(cores[i]);
+
+  std::vector<int> hs, lagrangian_hs;
+  uint64_t cost = 0, lb = 0, lagrangian_cost = 0;
+  uint64_t limit = node_limit;
+  for (;;) {
+    if (currentLB() >= ubCost)
+      break;
+
+    uint64_t lagrangian = fixSoftClauses(lagrangian_hs, lagrangian_cost);
+    if (lagrangian > lbCost)
+      lbCost = lagrangian > ubCost ? ubCost : lagrangian;
+    if (currentLB() >= ubCost)
+      break;
+    hitting_set.setNodeLimit(limit);
+    if (!hitting_set.solve(ubCost, hs, cost, lb)) {
+      lbCost = ubCost;
+      break;
+    }
+    if (lb > lbCost)
+      lbCost = lb;
+    if (lb < cost && lagrangian_cost < cost) {
+      hs.swap(lagrangian_hs);
+      cost = lagrangian_cost;
+    }
+    if (verbosity > 0)
+      printf("c LB : %-12" PRIu64 " (%d cores, hitting set %" PRIu64
+             ", %" PRIu64 " nodes, %d fixed)\n",
+             lbCost, hitting_set.nCores(), cost, hitting_set.getNodes(),
+             nbFixed);
+    if (currentLB() >= ubCost)
+      break;
+
+    int found = extractCores(hs);
+    // A hitting set that is not minimum has no new cores: the node limit
+    // is doubled so that the next one is closer to the minimum.
+    if (found == 0 && lb < cost)
+      limit *= 2;
+    for (int r = 0; r < greedy_rounds && found > 0 && currentLB() < ubCost;
+         r++) {
+      if (hitting_set.greedy(hs) == UINT64_MAX) {
+        found = -1;
+        break;
+      }
+      found = extractCores(hs);
+    }
+    if (found == -2) {
+      printAnswer(_UNKNOWN_);
+      return _UNKNOWN_;
+    }
+    if (found == -1)
+      lbCost = ubCost;
+  }
+
+  if (verbosity > 0)
+    printf("c IHS: %d cores, %" PRIu64 " nodes, %d fixed\n",
+           hitting_set.nCores(), hitting_set.getNodes(), nbFixed);
+  printAnswer(_OPTIMUM_);
+  return _OPTIMUM_;
+}
+
+/************************************************************************************************
+ //
+ // Rebuild MaxSAT solver
+ //
+ ************************************************************************************************/
+
+/*_________________________________________________________________________________________________
+  |
+  |  rebuildSolver : [void]  ->  [Solver *]
+  |
+  |  Description:
+  |
+  |    Rebuilds a SAT solver with the current MaxSAT formula.
+  |
+  |________________________________________________________________________________________________@*/
+Solver *IHS::rebuildSolver() {
+
+  Solver *S = newSATSolver();
+
+  reserveSATVariables(S, maxsat_formula->nVars());
+
+  for (int i = 0; i < maxsat_formula->nVars(); i++)
+    newSATVariable(S);
+
+  loadHardClauses(S);
+
+  vec<Lit> clause;
+  for (int i = 0; i < maxsat_formula->nSoft(); i++) {
+    if (isUnitRelaxed(i))
+      continue;
+
+    clause.clear();
+    getSoftClause(i).copyTo(clause);
+    LitSpan relaxation = maxsat_formula->getRelaxationVars(i);
+    for (int j = 0; j < relaxation.size(); j++)
+      clause.push(relaxation[j]);
+
+    S->addClause(clause);
+  }
+
+  for (int i = 0; i < maxsat_formula->nPB(); i++) {
+    Encoder *enc = new Encoder(_INCREMENTAL_NONE_, _CARD_MTOTALIZER_,
+                               _AMO_LADDER_, _PB_GTE_);
+
+    // Make sure the PB is on the form <=
+    if (!maxsat_formula->getPBConstraint(i)->_sign)
+      maxsat_formula->getPBConstraint(i)->changeSign();
+
+    enc->encodePB(S, maxsat_formula->getPBConstraint(i)->_lits,
+                  maxsat_formula->getPBConstraint(i)->_coeffs,
+                  maxsat_formula->getPBConstraint(i)->_rhs);
+
+    delete enc;
+  }
+
+  for (int i = 0; i < maxsat_formula->nCard(); i++) {
+    Encoder *enc = new Encoder(_INCREMENTAL_NONE_, _CARD_MTOTALIZER_,
+                               _AMO_LADDER_, _PB_GTE_);
+
+    if (maxsat_formula->getCardinalityConstraint(i)->_rhs == 1) {
+      enc->encodeAMO(S, maxsat_formula->getCardinalityConstraint(i)->_lits);
+    } else {
+      enc->encodeCardinality(S,
+                             maxsat_formula->getCardinalityConstraint(i)->_lits,
+                             maxsat_formula->getCardinalityConstraint(i)->_rhs);
+    }
+
+    delete enc;
+  }
+
+  return S;
+}
+
+/************************************************************************************************
+ //
+ // Other protected methods
+ //
+ ************************************************************************************************/
+
+/*_________________________________________________________________________________________________
+  |
+  |  initRelaxation : [void] ->  [void]
+  |
+  |  Description:
+  |
+  |    Initializes the relaxation variables by adding a relaxation literal to
+  |    the 'relaxationVars' of each soft clause (see 'newRelaxationLit'). The
+  |    relaxation literal is also the assumption literal of the soft clause.
+  |
+  |________________________________________________________________________________________________@*/
+void IHS::initRelaxation() {
+  for (int i = 0; i < maxsat_formula->nSoft(); i++) {
+    Lit l = newRelaxationLit(i);
+    maxsat_formula->addRelaxationVar(i, l);
+    maxsat_formula->setAssumptionVar(i, l);
+  }
+}
@@ -0,0 +1,108 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef Alg_IHS_h
+#define Alg_IHS_h
+
+#ifdef SIMP
+#include "simp/SimpSolver.h"
+#else
+#include "core/Solver.h"
+#endif
+
+#include "../Encoder.h"
+#include "../HittingSet.h"
+#include "../MaxSAT.h"
+
+namespace openwbo {
+
+//=================================================================================================
+// Implicit hitting set search: the SAT solver finds cores under the
+// assumptions of the soft clauses that are not in a hitting set of the
+// previous cores, and the hitting set solver finds the minimum-cost hitting
+// set, which is a lower bound. No cardinality constraint is encoded.
+class IHS : public MaxSAT {
+
+public:
+  IHS(int verb = _VERBOSITY_MINIMAL_, int threads = 1)
+      : solver(NULL), nbFixed(0), node_limit(100000), greedy_rounds(10) {
+    verbosity = verb;
+    hitting_set.setThreads(threads);
+  }
+  ~IHS() {
+    if (solver != NULL)
+      delete solver;
+  }
+
+  StatusCode search();
+
+  // Adds the memory of the SAT solver.
+  void memoryUsage(MemoryUsage &mem) {
+    MaxSAT::memoryUsage(mem);
+    solverMemoryUsage(solver, mem);
+  }
+
+  // Print solver configuration.
+  void printConfiguration() {
+
+    if(!print) return;
+
+    printf("c ==========================================[ Solver Settings "
+           "]============================================\n");
+    printf("c |                                                                "
+           "                                       |\n");
+    printf("c |  Algorithm: %23s                                             "
+           "                      |\n",
+           "IHS");
+    printf("c |                                                                "
+           "                                       |\n");
+  }
+
+protected:
+  // Rebuild MaxSAT solver
+  //
+  Solver *rebuildSolver(); // Rebuild MaxSAT solver.
+
+  // Other
+  void initRelaxation(); // Relaxes soft clauses.
+
+  // Finds cores under the assumptions of the soft clauses that are not in
+  // 'hs' until the SAT call is satisfiable.
+  int extractCores(std::vector<int> &hs);
+  // Hardens the soft clauses that cannot be falsified by a better model and
+  // returns the Lagrangian bound of the cores and its hitting set.
+  uint64_t fixSoftClauses(std::vector<int> &hs, uint64_t &cost);
+
+  Solver *solver;         // SAT Solver used as a black box.
+  HittingSet hitting_set; // Cores and hitting set solver.
+  int nbFixed;            // Soft clauses fixed by their reduced cost.
+
+  uint64_t node_limit; // Initial node limit of the exact hitting set solver.
+  int greedy_rounds;   // Greedy hitting sets after each exact one.
+};
+} // namespace openwbo
+
+#endif
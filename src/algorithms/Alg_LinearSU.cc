@@ -235,6 +235,11 @@ StatusCode LinearSU::normalSearch() {
           return _OPTIMUM_;
         }
 
+      } else if (newCost == currentLB()) {
+        // The model meets the lower bound that was known before the search.
+        ubCost = newCost;
+        printAnswer(_OPTIMUM_);
+        return _OPTIMUM_;
       } else {
         if (maxsat_formula->getProblemType() == _WEIGHTED_) {
           if (!encoder.hasPBEncoding()){
@@ -279,6 +284,18 @@ StatusCode LinearSU::normalSearch() {
 }
 
 // Public search method
+// Only the classic linear search has a bound on the whole cost, which exists
+// once it found a model.
+void LinearSU::tightenUpperBound(Solver *S) {
+  if (S != solver || (bmoMode && is_bmo))
+    return;
+  if (maxsat_formula->getProblemType() == _WEIGHTED_) {
+    if (encoder.hasPBEncoding())
+      encoder.updatePB(solver, ubCost - 1);
+  } else if (encoder.hasCardEncoding())
+    encoder.updateCardinality(solver, ubCost - 1);
+}
+
 StatusCode LinearSU::search() {
 
   if (maxsat_formula->getProblemType() == _WEIGHTED_)
@@ -325,8 +342,7 @@ Solver *LinearSU::rebuildSolver(uint64_t min_weight) {
   for (int i = 0; i < maxsat_formula->nVars(); i++)
     newSATVariable(S);
 
-  for (int i = 0; i < maxsat_formula->nHard(); i++)
-    S->addClause(maxsat_formula->getHardClause(i).clause);
+  loadHardClauses(S);
 
   for (int i = 0; i < maxsat_formula->nPB(); i++) {
     Encoder *enc = new Encoder(_INCREMENTAL_NONE_, _CARD_MTOTALIZER_,
@@ -362,16 +378,16 @@ Solver *LinearSU::rebuildSolver(uint64_t min_weight) {
 
   vec<Lit> clause;
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
-    if (maxsat_formula->getSoftClause(i).weight < min_weight)
+    if (maxsat_formula->getSoftWeight(i) < min_weight ||
+        isUnitRelaxed(i))
       continue;
 
     clause.clear();
-    maxsat_formula->getSoftClause(i).clause.copyTo(clause);
+    maxsat_formula->getSoftClause(i).copyTo(clause);
 
-    for (int j = 0; j < maxsat_formula->getSoftClause(i).relaxation_vars.size();
-         j++) {
-      clause.push(maxsat_formula->getSoftClause(i).relaxation_vars[j]);
-    }
+    LitSpan relaxation = maxsat_formula->getRelaxationVars(i);
+    for (int j = 0; j < relaxation.size(); j++)
+      clause.push(relaxation[j]);
 
     S->addClause(clause);
   }
@@ -402,9 +418,9 @@ Solver *LinearSU::rebuildBMO(vec<vec<Lit>> &functions, vec<int> &rhs,
   objFunction.clear();
   coeffs.clear();
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
-    if (maxsat_formula->getSoftClause(i).weight == currentWeight) {
-      objFunction.push(maxsat_formula->getSoftClause(i).relaxation_vars[0]);
-      coeffs.push(maxsat_formula->getSoftClause(i).weight);
+    if (maxsat_formula->getSoftWeight(i) == currentWeight) {
+      objFunction.push(maxsat_formula->getRelaxationVars(i)[0]);
+      coeffs.push(maxsat_formula->getSoftWeight(i));
     }
   }
 
@@ -426,8 +442,8 @@ Solver *LinearSU::rebuildBMO(vec<vec<Lit>> &functions, vec<int> &rhs,
   |
   |  Description:
   |
-  |    Initializes the relaxation variables by adding a fresh variable to the
-  |    'relaxationVars' of each soft clause.
+  |    Initializes the relaxation variables by adding a relaxation literal to
+  |    the 'relaxationVars' of each soft clause (see 'newRelaxationLit').
   |
   |  Post-conditions:
   |    * 'objFunction' contains all relaxation variables that were added to soft
@@ -437,10 +453,10 @@ Solver *LinearSU::rebuildBMO(vec<vec<Lit>> &functions, vec<int> &rhs,
   |________________________________________________________________________________________________@*/
 void LinearSU::initRelaxation() {
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
-    Lit l = maxsat_formula->newLiteral();
-    maxsat_formula->getSoftClause(i).relaxation_vars.push(l);
+    Lit l = newRelaxationLit(i);
+    maxsat_formula->addRelaxationVar(i, l);
     objFunction.push(l);
-    coeffs.push(maxsat_formula->getSoftClause(i).weight);
+    coeffs.push(maxsat_formula->getSoftWeight(i));
   }
 }
 
@@ -486,9 +502,9 @@ void LinearSU::print_LinearSU_configuration() {
 
   // save the polarity of the relaxation variables
   for (int i = 0; i < maxsat_formula->nSoft(); i++){
-    assert (maxsat_formula->getSoftClause(i).relaxation_vars.size() == 1);
-    maxsat_formula->getSoftClause(i).relaxation_vars[0];
-    int v = var(maxsat_formula->getSoftClause(i).relaxation_vars[0]);
+    assert (maxsat_formula->getRelaxationVars(i).size() == 1);
+    maxsat_formula->getRelaxationVars(i)[0];
+    int v = var(maxsat_formula->getRelaxationVars(i)[0]);
     assert (v < solver->model.size());
     solver->setPolarity(v, solver->model[v] == l_False);
   }
@@ -70,6 +70,13 @@ public:
 
   StatusCode search(); // Linear search.
 
+  // Adds the memory of the SAT solver and of the encoder.
+  void memoryUsage(MemoryUsage &mem) {
+    MaxSAT::memoryUsage(mem);
+    solverMemoryUsage(solver, mem);
+    mem.add(_MEM_ENCODERS_, encoder.memoryUsage());
+  }
+
   // Print solver configuration.
   void printConfiguration(bool bmo, int ptype) {
 
@@ -101,6 +108,9 @@ protected:
   StatusCode normalSearch(); // Classic linear search algorithm.
   StatusCode bmoSearch();    // Linear search algorithm with lexicographical order.
 
+  // Bounds the cost of the models by the upper bound of a portfolio.
+  void tightenUpperBound(Solver *S);
+
   // Greater than comparator.
   bool static greaterThan(uint64_t i, uint64_t j) { return (i > j); }
 
@@ -79,7 +79,31 @@ StatusCode MSU3::MSU3_iterative() {
 
   activeSoft.growTo(maxsat_formula->nSoft(), false);
   for (int i = 0; i < maxsat_formula->nSoft(); i++)
-    coreMapping[getAssumptionLit(i)] = i;
+    mapCore(getAssumptionLit(i), i);
+
+  // Resume from a checkpoint: relax the soft clauses of the saved cores and
+  // encode them at the saved lower bound.
+  if (restoreSearch("msu3")) {
+    if (currentLB() == ubCost) {
+      printAnswer(_OPTIMUM_);
+      return _OPTIMUM_;
+    }
+    for (size_t i = 0; i < resume_state.relaxed.size(); i++)
+      activeSoft[resume_state.relaxed[i]] = true;
+    for (int i = 0; i < maxsat_formula->nSoft(); i++) {
+      if (activeSoft[i])
+        currentObjFunction.push(getRelaxationLit(i));
+      else
+        assumptions.push(~getAssumptionLit(i));
+    }
+    if (lbCost != (unsigned)currentObjFunction.size()) {
+      encoder.buildCardinality(solver, currentObjFunction, lbCost);
+      encoder.incUpdateCardinality(solver, currentObjFunction, lbCost,
+                                   encodingAssumptions);
+    }
+    for (int i = 0; i < encodingAssumptions.size(); i++)
+      assumptions.push(encodingAssumptions[i]);
+  }
 
   for (;;) {
 
@@ -93,6 +117,11 @@ StatusCode MSU3::MSU3_iterative() {
       ubCost = newCost;
 
       if (nbSatisfiable == 1) {
+        if (newCost == currentLB()) {
+          printAnswer(_OPTIMUM_);
+          return _OPTIMUM_;
+        }
+
         for (int i = 0; i < objFunction.size(); i++)
           assumptions.push(~objFunction[i]);
       } else {
@@ -113,7 +142,9 @@ StatusCode MSU3::MSU3_iterative() {
         return _UNSATISFIABLE_;
       }
 
-      if (lbCost == ubCost) {
+      reduceCore(solver);
+
+      if (currentLB() == ubCost) {
         assert(nbSatisfiable > 0);
         if (verbosity > 0)
           printf("c LB = UB\n");
@@ -130,11 +161,11 @@ StatusCode MSU3::MSU3_iterative() {
 
       joinObjFunction.clear();
       for (int i = 0; i < solver->conflict.size(); i++) {
-        if (coreMapping.find(solver->conflict[i]) != coreMapping.end()) {
-          assert(!activeSoft[coreMapping[solver->conflict[i]]]);
-          activeSoft[coreMapping[solver->conflict[i]]] = true;
-          joinObjFunction.push(
-              getRelaxationLit(coreMapping[solver->conflict[i]]));
+        int soft_index = coreSoft(solver->conflict[i]);
+        if (soft_index != -1) {
+          assert(!activeSoft[soft_index]);
+          activeSoft[soft_index] = true;
+          joinObjFunction.push(getRelaxationLit(soft_index));
         }
       }
 
@@ -175,17 +206,26 @@ StatusCode MSU3::MSU3_iterative() {
   return _ERROR_;
 }
 
+// The state of the search are the soft clauses that were relaxed by the
+// cores.
+void MSU3::saveState(Checkpoint &ck) {
+  if (nbSatisfiable == 0)
+    return;
+  ck.algorithm = "msu3";
+  for (int i = 0; i < activeSoft.size(); i++)
+    if (activeSoft[i])
+      ck.relaxed.push_back(i);
+}
+
 // Public search method
 StatusCode MSU3::search() {
 
+  // Weighted formulas are solved by stratification on the weights.
   if (maxsat_formula->getProblemType() == _WEIGHTED_) {
-    if(print) {
-      printf("Error: Currently algorithm MSU3 does not support weighted "
-             "MaxSAT instances.\n");
-      printf("s UNKNOWN\n");
-    }
-    throw MaxSATException(__FILE__, __LINE__, "MSU3 does not support weighted");
-    return _UNKNOWN_;
+    printConfiguration();
+    initRelaxation();
+    solver = rebuildSolver();
+    return weightedMSU3(solver);
   }
 
   if (incremental_strategy == _INCREMENTAL_ITERATIVE_) {
@@ -228,16 +268,18 @@ Solver *MSU3::rebuildSolver() {
   for (int i = 0; i < maxsat_formula->nVars(); i++)
     newSATVariable(S);
 
-  for (int i = 0; i < maxsat_formula->nHard(); i++)
-    S->addClause(getHardClause(i).clause);
+  loadHardClauses(S);
 
   vec<Lit> clause;
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
+    if (isUnitRelaxed(i))
+      continue;
+
     clause.clear();
-    Soft &s = getSoftClause(i);
-    s.clause.copyTo(clause);
-    for (int j = 0; j < s.relaxation_vars.size(); j++)
-      clause.push(s.relaxation_vars[j]);
+    getSoftClause(i).copyTo(clause);
+    LitSpan relaxation = maxsat_formula->getRelaxationVars(i);
+    for (int j = 0; j < relaxation.size(); j++)
+      clause.push(relaxation[j]);
 
     S->addClause(clause);
   }
@@ -291,8 +333,8 @@ Solver *MSU3::rebuildSolver() {
   |
   |  Description:
   |
-  |    Initializes the relaxation variables by adding a fresh variable to the
-  |    'relaxationVars' of each soft clause.
+  |    Initializes the relaxation variables by adding a relaxation literal to
+  |    the 'relaxationVars' of each soft clause (see 'newRelaxationLit').
   |
   |  Post-conditions:
   |    * 'objFunction' contains all relaxation variables that were added to soft
@@ -301,10 +343,9 @@ Solver *MSU3::rebuildSolver() {
   |________________________________________________________________________________________________@*/
 void MSU3::initRelaxation() {
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
-    Lit l = maxsat_formula->newLiteral();
-    Soft &s = getSoftClause(i);
-    s.relaxation_vars.push(l);
-    s.assumption_var = l;
+    Lit l = newRelaxationLit(i);
+    maxsat_formula->addRelaxationVar(i, l);
+    maxsat_formula->setAssumptionVar(i, l);
     objFunction.push(l);
   }
 }
@@ -60,6 +60,18 @@ public:
 
   StatusCode search(); // MSU3 search.
 
+  // Adds the memory of the SAT solver and of the encoder.
+  void memoryUsage(MemoryUsage &mem) {
+    MaxSAT::memoryUsage(mem);
+    solverMemoryUsage(solver, mem);
+    mem.add(_MEM_ENCODERS_, encoder.memoryUsage());
+  }
+
+  // Enumerates models with the SAT solver that was used in the search.
+  int enumerate(int limit, bool optimal_only, ModelCallback callback) {
+    return enumerateModels(solver, limit, optimal_only, callback);
+  }
+
   // Print solver configuration.
   void printConfiguration() {
 
@@ -87,6 +99,9 @@ protected:
   StatusCode MSU3_weakening(); // Incremental Weakening MSU3.
   StatusCode MSU3_iterative(); // Incremental Iterative Encoding MSU3.
 
+  // Saves the relaxed soft clauses.
+  void saveState(Checkpoint &ck);
+
   // Other
   void initRelaxation(); // Relaxes soft clauses.
 
@@ -103,9 +118,6 @@ protected:
   vec<int> coeffs; // Coefficients of the literals that are used in the
                    // constraint that excludes models.
 
-  std::map<Lit, int> coreMapping; // Mapping between the assumption literal and
-                                  // the respective soft clause.
-
   // Soft clauses that are currently in the MaxSAT formula.
   vec<bool> activeSoft;
 };
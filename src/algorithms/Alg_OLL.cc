@@ -34,9 +34,9 @@ uint64_t OLL::findNextWeight(uint64_t weight,
 
   uint64_t nextWeight = 1;
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
-    if (maxsat_formula->getSoftClause(i).weight > nextWeight &&
-        maxsat_formula->getSoftClause(i).weight < weight)
-      nextWeight = maxsat_formula->getSoftClause(i).weight;
+    if (maxsat_formula->getSoftWeight(i) > nextWeight &&
+        maxsat_formula->getSoftWeight(i) < weight)
+      nextWeight = maxsat_formula->getSoftWeight(i);
   }
 
   for (std::set<Lit>::iterator it = cardinality_assumptions.begin();
@@ -69,9 +69,9 @@ uint64_t OLL::findNextWeightDiversity(uint64_t weight,
     nbClauses = 0;
     nbWeights.clear();
     for (int i = 0; i < maxsat_formula->nSoft(); i++) {
-      if (maxsat_formula->getSoftClause(i).weight >= nextWeight) {
+      if (maxsat_formula->getSoftWeight(i) >= nextWeight) {
         nbClauses++;
-        nbWeights.insert(maxsat_formula->getSoftClause(i).weight);
+        nbWeights.insert(maxsat_formula->getSoftWeight(i));
       }
     }
 
@@ -102,7 +102,12 @@ StatusCode OLL::unweighted() {
 
   // nbInitialVariables = nVars();
   lbool res = l_True;
-  initRelaxation();
+  // The cores of a previous search were found under other user assumptions,
+  // so a new search keeps only the relaxation variables.
+  if (solver == NULL)
+    initRelaxation();
+  else
+    clearCores();
   solver = rebuildSolver();
 
   vec<Lit> assumptions;
@@ -113,18 +118,46 @@ StatusCode OLL::unweighted() {
 
   activeSoft.growTo(maxsat_formula->nSoft(), false);
   for (int i = 0; i < maxsat_formula->nSoft(); i++)
-    coreMapping[maxsat_formula->getSoftClause(i).assumption_var] = i;
+    mapCore(maxsat_formula->getAssumptionVar(i), i);
 
-  std::set<Lit> cardinality_assumptions;
-  vec<Encoder *> soft_cardinality;
+  core_outputs.clear();
+  soft_cardinality.clear();
+
+  if (disjoint_cores && maxsat_formula->nSoft() > 0) {
+    std::vector<std::vector<int> > cores;
+    res = findDisjointCores(solver, cores);
+    if (res == l_False) {
+      printAnswer(_UNSATISFIABLE_);
+      return _UNSATISFIABLE_;
+    }
+    if (res == l_Undef) {
+      printAnswer(_UNKNOWN_);
+      return _UNKNOWN_;
+    }
+    if (currentLB() == ubCost) {
+      printAnswer(_OPTIMUM_);
+      return _OPTIMUM_;
+    }
+
+    encodeDisjointCores(cores);
+    for (int i = 0; i < maxsat_formula->nSoft(); i++)
+      if (!activeSoft[i])
+        assumptions.push(~maxsat_formula->getAssumptionVar(i));
+    for (std::set<Lit>::iterator it = core_outputs.begin();
+         it != core_outputs.end(); ++it)
+      assumptions.push(~(*it));
+  }
 
   for (;;) {
 
-    res = searchSATSolver(solver, assumptions);
+    if (nbSatisfiable > 0 && stopCoreGuided())
+      return _UNKNOWN_;
+
+    res = searchSATSolver(solver, withUserAssumptions(solver, assumptions));
     if (res == l_True) {
       nbSatisfiable++;
       uint64_t newCost = computeCostModel(solver->model);
-      saveModel(solver->model);
+      saveModel(improveModel(solver->model, newCost));
       if (maxsat_formula->getFormat() == _FORMAT_PB_) {
         // optimization problem
         if (maxsat_formula->getObjFunction() != NULL) {
@@ -147,8 +180,13 @@ StatusCode OLL::unweighted() {
           }
         }
 
+        if (newCost == currentLB()) {
+          printAnswer(_OPTIMUM_);
+          return _OPTIMUM_;
+        }
+
         for (int i = 0; i < maxsat_formula->nSoft(); i++)
-          assumptions.push(~maxsat_formula->getSoftClause(i).assumption_var);
+          assumptions.push(~maxsat_formula->getAssumptionVar(i));
       } else {
         assert(lbCost == newCost);
         printAnswer(_OPTIMUM_);
@@ -167,7 +205,7 @@ StatusCode OLL::unweighted() {
         return _UNSATISFIABLE_;
       }
 
-      if (lbCost == ubCost) {
+      if (currentLB() == ubCost) {
         assert(nbSatisfiable > 0);
         if (verbosity > 0)
           printf("c LB = UB\n");
@@ -182,20 +220,19 @@ StatusCode OLL::unweighted() {
 
       for (int i = 0; i < solver->conflict.size(); i++) {
         Lit p = solver->conflict[i];
-        if (coreMapping.find(p) != coreMapping.end()) {
-          assert(!activeSoft[coreMapping[p]]);
-          activeSoft[coreMapping[solver->conflict[i]]] = true;
-          assert(p ==
-                 maxsat_formula->getSoftClause(coreMapping[solver->conflict[i]])
-                     .relaxation_vars[0]);
+        int soft_index = coreSoft(p);
+        if (soft_index != -1) {
+          assert(!activeSoft[soft_index]);
+          activeSoft[soft_index] = true;
+          assert(p == maxsat_formula->getRelaxationVars(soft_index)[0]);
           soft_relax.push(p);
         }
 
         if (boundMapping.find(p) != boundMapping.end()) {
           std::set<Lit>::iterator it;
-          it = cardinality_assumptions.find(p);
-          assert(it != cardinality_assumptions.end());
-          cardinality_assumptions.erase(it);
+          it = core_outputs.find(p);
+          assert(it != core_outputs.end());
+          core_outputs.erase(it);
           cardinality_relax.push(p);
 
           // this is a soft cardinality -- bound must be increased
@@ -223,7 +260,7 @@ StatusCode OLL::unweighted() {
             boundMapping[out] = std::make_pair(
                 std::make_pair(soft_id.first.first, soft_id.first.second + 1),
                 1);
-            cardinality_assumptions.insert(out);
+            core_outputs.insert(out);
           }
         }
       }
@@ -268,7 +305,7 @@ StatusCode OLL::unweighted() {
         Lit out = e->outputs()[1];
         boundMapping[out] =
             std::make_pair(std::make_pair(soft_cardinality.size() - 1, 1), 1);
-        cardinality_assumptions.insert(out);
+        core_outputs.insert(out);
       }
 
       // reset the assumptions
@@ -276,13 +313,13 @@ StatusCode OLL::unweighted() {
       int active_soft = 0;
       for (int i = 0; i < maxsat_formula->nSoft(); i++) {
         if (!activeSoft[i])
-          assumptions.push(~maxsat_formula->getSoftClause(i).assumption_var);
+          assumptions.push(~maxsat_formula->getAssumptionVar(i));
         else
           active_soft++;
       }
 
-      for (std::set<Lit>::iterator it = cardinality_assumptions.begin();
-           it != cardinality_assumptions.end(); ++it) {
+      for (std::set<Lit>::iterator it = core_outputs.begin();
+           it != core_outputs.end(); ++it) {
         assumptions.push(~(*it));
       }
 
@@ -308,22 +345,23 @@ StatusCode OLL::weighted() {
 
   activeSoft.growTo(maxsat_formula->nSoft(), false);
   for (int i = 0; i < maxsat_formula->nSoft(); i++)
-    coreMapping[maxsat_formula->getSoftClause(i).assumption_var] = i;
+    mapCore(maxsat_formula->getAssumptionVar(i), i);
 
   std::set<Lit> cardinality_assumptions;
-  vec<Encoder *> soft_cardinality;
+  soft_cardinality.clear();
 
   min_weight = maxsat_formula->getMaximumWeight();
   // printf("current weight %d\n",maxsat_formula->getMaximumWeight());
 
   for (;;) {
 
-    res = searchSATSolver(solver, assumptions);
+    res = searchSATSolver(solver, withUserAssumptions(solver, assumptions));
     if (res == l_True) {
       nbSatisfiable++;
       uint64_t newCost = computeCostModel(solver->model);
+      vec<lbool> &newModel = improveModel(solver->model, newCost);
       if (newCost < ubCost || nbSatisfiable == 1) {
-        saveModel(solver->model);
+        saveModel(newModel);
         if (maxsat_formula->getFormat() == _FORMAT_PB_) {
           // optimization problem
           if (maxsat_formula->getObjFunction() != NULL) {
@@ -334,19 +372,24 @@ StatusCode OLL::weighted() {
         ubCost = newCost;
       }
 
+      if (ubCost == currentLB()) {
+        printAnswer(_OPTIMUM_);
+        return _OPTIMUM_;
+      }
+
       if (nbSatisfiable == 1) {
         min_weight =
             findNextWeightDiversity(min_weight, cardinality_assumptions);
         // printf("current weight %d\n",min_weight);
 
         for (int i = 0; i < maxsat_formula->nSoft(); i++)
-          if (maxsat_formula->getSoftClause(i).weight >= min_weight)
-            assumptions.push(~maxsat_formula->getSoftClause(i).assumption_var);
+          if (maxsat_formula->getSoftWeight(i) >= min_weight)
+            assumptions.push(~maxsat_formula->getAssumptionVar(i));
       } else {
         // compute min weight in soft
         int not_considered = 0;
         for (int i = 0; i < maxsat_formula->nSoft(); i++) {
-          if (maxsat_formula->getSoftClause(i).weight < min_weight)
+          if (maxsat_formula->getSoftWeight(i) < min_weight)
             not_considered++;
         }
 
@@ -372,9 +415,8 @@ StatusCode OLL::weighted() {
           int active_soft = 0;
           for (int i = 0; i < maxsat_formula->nSoft(); i++) {
             if (!activeSoft[i] &&
-                maxsat_formula->getSoftClause(i).weight >= min_weight) {
-              assumptions.push(
-                  ~maxsat_formula->getSoftClause(i).assumption_var);
+                maxsat_formula->getSoftWeight(i) >= min_weight) {
+              assumptions.push(~maxsat_formula->getAssumptionVar(i));
               // printf("s assumption
               // %d\n",var(softClauses[i].assumptionVar)+1);
             } else
@@ -406,13 +448,11 @@ StatusCode OLL::weighted() {
       uint64_t min_core = UINT64_MAX;
       for (int i = 0; i < solver->conflict.size(); i++) {
         Lit p = solver->conflict[i];
-        if (coreMapping.find(p) != coreMapping.end()) {
-          assert(!activeSoft[coreMapping[p]]);
-          if (maxsat_formula->getSoftClause(coreMapping[solver->conflict[i]])
-                  .weight < min_core)
-            min_core =
-                maxsat_formula->getSoftClause(coreMapping[solver->conflict[i]])
-                    .weight;
+        int soft_index = coreSoft(p);
+        if (soft_index != -1) {
+          assert(!activeSoft[soft_index]);
+          if (maxsat_formula->getSoftWeight(soft_index) < min_core)
+            min_core = maxsat_formula->getSoftWeight(soft_index);
         }
 
         if (boundMapping.find(p) != boundMapping.end()) {
@@ -435,7 +475,7 @@ StatusCode OLL::weighted() {
         return _UNSATISFIABLE_;
       }
 
-      if (lbCost == ubCost) {
+      if (currentLB() == ubCost) {
         assert(nbSatisfiable > 0);
         if (verbosity > 0)
           printf("c LB = UB\n");
@@ -450,22 +490,24 @@ StatusCode OLL::weighted() {
 
       for (int i = 0; i < solver->conflict.size(); i++) {
         Lit p = solver->conflict[i];
-        if (coreMapping.find(p) != coreMapping.end()) {
-          if (maxsat_formula->getSoftClause(coreMapping[p]).weight > min_core) {
+        int soft_index = coreSoft(p);
+        if (soft_index != -1) {
+          if (maxsat_formula->getSoftWeight(soft_index) > min_core) {
             // printf("SPLIT THE CLAUSE\n");
-            assert(!activeSoft[coreMapping[p]]);
+            assert(!activeSoft[soft_index]);
             // SPLIT THE CLAUSE
-            int indexSoft = coreMapping[p];
-            assert(maxsat_formula->getSoftClause(indexSoft).weight - min_core >
-                   0);
+            int indexSoft = soft_index;
+            assert(maxsat_formula->getSoftWeight(indexSoft) - min_core > 0);
 
             // Update the weight of the soft clause.
-            maxsat_formula->getSoftClause(indexSoft).weight -= min_core;
+            maxsat_formula->setSoftWeight(
+                indexSoft,
+                maxsat_formula->getSoftWeight(indexSoft) - min_core);
 
             vec<Lit> clause;
             vec<Lit> vars;
 
-            maxsat_formula->getSoftClause(indexSoft).clause.copyTo(clause);
+            maxsat_formula->getSoftClause(indexSoft).copyTo(clause);
             // Since cardinality constraints are added the variables are not
             // in sync...
             while (maxsat_formula->nVars() < solver->nVars())
@@ -486,36 +528,31 @@ StatusCode OLL::weighted() {
             solver->addClause(clause);
 
             assert(clause.size() - 1 ==
-                   maxsat_formula->getSoftClause(indexSoft).clause.size());
-            assert(maxsat_formula->getSoftClause(maxsat_formula->nSoft() - 1)
-                       .relaxation_vars.size() == 1);
+                   maxsat_formula->getSoftClause(indexSoft).size());
+            int last = maxsat_formula->nSoft() - 1;
+            assert(maxsat_formula->getRelaxationVars(last).size() == 1);
 
             // Create a new assumption literal.
 
-            maxsat_formula->getSoftClause(maxsat_formula->nSoft() - 1)
-                .assumption_var = l;
-            assert(maxsat_formula->getSoftClause(maxsat_formula->nSoft() - 1)
-                       .assumption_var ==
-                   maxsat_formula->getSoftClause(maxsat_formula->nSoft() - 1)
-                       .relaxation_vars[0]);
-            coreMapping[l] =
-                maxsat_formula->nSoft() -
-                1; // Map the new soft clause to its assumption literal.
+            maxsat_formula->setAssumptionVar(last, l);
+            assert(maxsat_formula->getAssumptionVar(last) ==
+                   maxsat_formula->getRelaxationVars(last)[0]);
+            // Map the new soft clause to its assumption literal.
+            mapCore(l, maxsat_formula->nSoft() - 1);
 
             soft_relax.push(l);
-            assert(maxsat_formula->getSoftClause(coreMapping[l]).weight ==
+            assert(maxsat_formula->getSoftWeight(coreSoft(l)) ==
                    min_core);
             assert(activeSoft.size() == maxsat_formula->nSoft());
 
           } else {
             // printf("NOT SPLITTING\n");
-            assert(
-                maxsat_formula->getSoftClause(coreMapping[solver->conflict[i]])
-                    .weight == min_core);
+            assert(maxsat_formula->getSoftWeight(soft_index) ==
+                   min_core);
             soft_relax.push(p);
             // printf("ASSERT %d\n",var(p)+1);
-            assert(!activeSoft[coreMapping[p]]);
-            activeSoft[coreMapping[p]] = true;
+            assert(!activeSoft[soft_index]);
+            activeSoft[soft_index] = true;
           }
         }
 
@@ -728,8 +765,8 @@ StatusCode OLL::weighted() {
       int active_soft = 0;
       for (int i = 0; i < maxsat_formula->nSoft(); i++) {
         if (!activeSoft[i] &&
-            maxsat_formula->getSoftClause(i).weight >= min_weight) {
-          assumptions.push(~maxsat_formula->getSoftClause(i).assumption_var);
+            maxsat_formula->getSoftWeight(i) >= min_weight) {
+          assumptions.push(~maxsat_formula->getAssumptionVar(i));
           // printf("s assumption %d\n",var(softClauses[i].assumptionVar)+1);
         } else
           active_soft++;
@@ -783,6 +820,48 @@ StatusCode OLL::search() {
  //
  ************************************************************************************************/
 
+/*_________________________________________________________________________________________________
+  |
+  |  encodeDisjointCores : (cores : std::vector<std::vector<int>>&)  ->  [void]
+  |
+  |  Description:
+  |
+  |    Relaxes the soft clauses of the disjoint cores found before the first
+  |    model, as the unweighted search does with each new core: a unit core
+  |    hardens its relaxation variable and a larger core gets a cardinality
+  |    constraint whose bound 1 is enforced by assumption.
+  |
+  |  Post-conditions:
+  |    * 'activeSoft', 'soft_cardinality', 'boundMapping' and 'core_outputs'
+  |      contain the cores.
+  |
+  |________________________________________________________________________________________________@*/
+void OLL::encodeDisjointCores(std::vector<std::vector<int> > &cores) {
+  vec<Lit> soft_relax;
+  for (size_t i = 0; i < cores.size(); i++) {
+    soft_relax.clear();
+    for (size_t j = 0; j < cores[i].size(); j++) {
+      activeSoft[cores[i][j]] = true;
+      soft_relax.push(maxsat_formula->getRelaxationVars(cores[i][j])[0]);
+    }
+
+    if (soft_relax.size() == 1) {
+      solver->addClause(soft_relax[0]);
+      continue;
+    }
+
+    Encoder *e = new Encoder();
+    e->setIncremental(_INCREMENTAL_ITERATIVE_);
+    e->buildCardinality(solver, soft_relax, 1);
+    soft_cardinality.push(e);
+
+    Lit out = e->outputs()[1];
+    boundMapping[out] =
+        std::make_pair(std::make_pair(soft_cardinality.size() - 1, 1), 1);
+    core_outputs.insert(out);
+  }
+}
+
 /*_________________________________________________________________________________________________
   |
   |  rebuildSolver : [void]  ->  [Solver *]
@@ -801,8 +880,7 @@ Solver *OLL::rebuildSolver() {
   for (int i = 0; i < maxsat_formula->nVars(); i++)
     newSATVariable(S);
 
-  for (int i = 0; i < maxsat_formula->nHard(); i++)
-    S->addClause(maxsat_formula->getHardClause(i).clause);
+  loadHardClauses(S);
 
   // printf("c #PB: %d\n", maxsat_formula->nPB());
   for (int i = 0; i < maxsat_formula->nPB(); i++) {
@@ -840,11 +918,14 @@ Solver *OLL::rebuildSolver() {
 
   vec<Lit> clause;
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
+    if (isUnitRelaxed(i))
+      continue;
+
     clause.clear();
-    maxsat_formula->getSoftClause(i).clause.copyTo(clause);
-    for (int j = 0; j < maxsat_formula->getSoftClause(i).relaxation_vars.size();
-         j++)
-      clause.push(maxsat_formula->getSoftClause(i).relaxation_vars[j]);
+    maxsat_formula->getSoftClause(i).copyTo(clause);
+    LitSpan relaxation = maxsat_formula->getRelaxationVars(i);
+    for (int j = 0; j < relaxation.size(); j++)
+      clause.push(relaxation[j]);
 
     S->addClause(clause);
   }
@@ -864,8 +945,8 @@ Solver *OLL::rebuildSolver() {
   |
   |  Description:
   |
-  |    Initializes the relaxation variables by adding a fresh variable to the
-  |    'relaxationVars' of each soft clause.
+  |    Initializes the relaxation variables by adding a relaxation literal to
+  |    the 'relaxationVars' of each soft clause (see 'newRelaxationLit').
   |
   |  Post-conditions:
   |    * 'objFunction' contains all relaxation variables that were added to soft
@@ -874,8 +955,37 @@ Solver *OLL::rebuildSolver() {
   |________________________________________________________________________________________________@*/
 void OLL::initRelaxation() {
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
-    Lit l = maxsat_formula->newLiteral();
-    maxsat_formula->getSoftClause(i).relaxation_vars.push(l);
-    maxsat_formula->getSoftClause(i).assumption_var = l;
+    Lit l = newRelaxationLit(i);
+    maxsat_formula->addRelaxationVar(i, l);
+    maxsat_formula->setAssumptionVar(i, l);
   }
 }
+
+/*_________________________________________________________________________________________________
+  |
+  |  clearCores : [void] ->  [void]
+  |
+  |  Description:
+  |
+  |    Deletes the SAT solver and the encoders of the cores of a previous
+  |    unweighted search and clears its bounds. The weighted search adds the
+  |    outputs of its cores to the soft clauses of the formula and is only run
+  |    once.
+  |
+  |  Post-conditions:
+  |    * 'solver' is NULL and 'soft_cardinality', 'boundMapping',
+  |      'core_outputs' and 'activeSoft' are empty.
+  |
+  |________________________________________________________________________________________________@*/
+void OLL::clearCores() {
+  assert(maxsat_formula->getProblemType() == _UNWEIGHTED_);
+  delete solver;
+  solver = NULL;
+  for (int i = 0; i < soft_cardinality.size(); i++)
+    delete soft_cardinality[i];
+  soft_cardinality.clear();
+  boundMapping.clear();
+  core_outputs.clear();
+  activeSoft.clear();
+  resetSearch();
+}
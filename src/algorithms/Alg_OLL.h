@@ -60,6 +60,21 @@ public:
 
   StatusCode search();
 
+  // Adds the memory of the SAT solver and of the encoders of the cores.
+  void memoryUsage(MemoryUsage &mem) {
+    MaxSAT::memoryUsage(mem);
+    solverMemoryUsage(solver, mem);
+    uint64_t bytes = encoder.memoryUsage();
+    for (int i = 0; i < soft_cardinality.size(); i++)
+      bytes += soft_cardinality[i]->memoryUsage();
+    mem.add(_MEM_ENCODERS_, bytes);
+  }
+
+  // Enumerates models with the SAT solver that was used in the search.
+  int enumerate(int limit, bool optimal_only, ModelCallback callback) {
+    return enumerateModels(solver, limit, optimal_only, callback);
+  }
+
   // Print solver configuration.
   void printConfiguration() {
 
@@ -84,12 +99,18 @@ protected:
 
   // Other
   void initRelaxation(); // Relaxes soft clauses.
+  // Discards the SAT solver and the cores of a previous search.
+  void clearCores();
 
   StatusCode unweighted();
   StatusCode weighted();
 
+  // Relaxes the disjoint cores found before the first model.
+  void encodeDisjointCores(std::vector<std::vector<int> > &cores);
+
   Solver *solver;  // SAT Solver used as a black box.
   Encoder encoder; // Interface for the encoder of constraints to CNF.
+  vec<Encoder *> soft_cardinality; // Encoders of the cores.
 
   // Controls the incremental strategy used by MSU3 algorithms.
   int incremental_strategy;
@@ -101,9 +122,6 @@ protected:
   vec<uint64_t> coeffs; // Coefficients of the literals that are used in the
                         // constraint that excludes models.
 
-  std::map<Lit, int> coreMapping; // Mapping between the assumption literal and
-                                  // the respective soft clause.
-
   std::map<Lit, int>
       coreCardinality; // Mapping between the assumption literal and
                        // the respective soft clause.
@@ -114,6 +132,15 @@ protected:
   // Soft clauses that are currently in the MaxSAT formula.
   vec<bool> activeSoft;
 
+  // Outputs of the cardinality constraints of the cores whose bound is
+  // enforced by assumption in the unweighted search.
+  std::set<Lit> core_outputs;
+
+  // Checked before each SAT call of the unweighted search after the first
+  // model. If it returns true the search stops with _UNKNOWN_ and keeps the
+  // relaxation of the cores in the SAT solver.
+  virtual bool stopCoreGuided() { return false; }
+
   uint64_t findNextWeightDiversity(uint64_t weight,
                                    std::set<Lit> &cardinality_assumptions);
   uint64_t findNextWeight(uint64_t weight,
@@ -26,12 +26,15 @@
  */
 
 #include "Alg_PartMSU3.h"
+#include "../Instrumentation.h"
+#include "../Progress.h"
 
 #include <gmpxx.h>
 #include <iostream>
 
 #include <algorithm>
 #include <list>
+#include <thread>
 #include <unordered_map>
 
 #define NO_PAIR -1
@@ -105,6 +108,7 @@ int PartMSU3::chooseAlgorithm() {
  * WARNING: the output tree is not ordered
  */
 void PartMSU3::computeGuideTree(std::deque<TreeNode *> &out_tree) {
+  INSTR_TIMER(_PHASE_GUIDE_TREE_);
   assert(nPartitions() > 0);
   assert(out_tree.empty());
   out_tree.clear();
@@ -451,6 +455,9 @@ void PartMSU3::sortPartitions(vec<int> &out_parts) {
       best_max = weights[best_part];
     }
 
+    if (best_part < 0)
+      break; // No partition has soft clauses.
+
     // Add selected partition if it contains soft clauses
     if (nPartitionSoft(best_part) > 0 && old_best_part != best_part) {
       if (nPartitionSoft(best_part) == 1) {
@@ -476,7 +483,7 @@ StatusCode PartMSU3::PartMSU3_sequential() {
   vec<Lit> currentObjFunction;
   vec<Lit> encodingAssumptions;
 
-  Encoder *encoder = new Encoder();
+  encoder = new Encoder();
   encoder->setIncremental(incremental_strategy);
 
   // Initialize partitions
@@ -493,26 +500,41 @@ StatusCode PartMSU3::PartMSU3_sequential() {
     sortPartitions(parts);
   }
 
-  // Build solver
-  initRelaxation();
-  solver = rebuildSolver();
-
+  // Build solver. The solver of a previous search is reused, so that
+  // searches with different user assumptions share the learnt clauses.
+  if (solver == NULL) {
+    initRelaxation();
+    solver = rebuildSolver();
+    for (int i = 0; i < maxsat_formula->nSoft(); i++)
+      mapCore(getAssumptionLit(i), i);
+  } else
+    resetSearch();
+
+  activeSoft.clear();
   activeSoft.growTo(maxsat_formula->nSoft(), false);
-  for (int i = 0; i < maxsat_formula->nSoft(); i++)
-    coreMapping[getAssumptionLit(i)] = i;
 
   for (;;) {
 
-    res = searchSATSolver(solver, assumptions);
+    // Partitions whose soft clauses are already in the search
+    setTraceNode(0, part_index);
+    res = searchSATSolver(solver, withUserAssumptions(solver, assumptions));
     if (res == l_True) {
       nbSatisfiable++;
       uint64_t newCost = computeCostModel(solver->model);
+      vec<lbool> &newModel = improveModel(solver->model, newCost);
       if (nbSatisfiable == 1 || newCost < ubCost) {
-        saveModel(solver->model);
+        saveModel(newModel);
         printBound(newCost);
         ubCost = newCost;
       }
 
+      if (ubCost == currentLB()) {
+        if (verbosity > 0)
+          printf("c UB = LB\n");
+        printAnswer(_OPTIMUM_);
+        return _OPTIMUM_;
+      }
+
       if (merge_strategy == _PART_SEQUENTIAL_) {
         // Select next partition
         while (nPartitionSoft(part_index) < 2 && part_index < nPartitions()) {
@@ -573,7 +595,9 @@ StatusCode PartMSU3::PartMSU3_sequential() {
         return _UNSATISFIABLE_;
       }
 
-      if (lbCost == ubCost) {
+      reduceCore(solver);
+
+      if (currentLB() == ubCost) {
         assert(nbSatisfiable > 0);
         if (verbosity > 0)
           printf("c LB = UB\n");
@@ -590,11 +614,11 @@ StatusCode PartMSU3::PartMSU3_sequential() {
 
       joinObjFunction.clear();
       for (int i = 0; i < solver->conflict.size(); i++) {
-        if (coreMapping.find(solver->conflict[i]) != coreMapping.end()) {
-          assert(!activeSoft[coreMapping[solver->conflict[i]]]);
-          activeSoft[coreMapping[solver->conflict[i]]] = true;
-          joinObjFunction.push(
-              getRelaxationLit(coreMapping[solver->conflict[i]]));
+        int soft_index = coreSoft(solver->conflict[i]);
+        if (soft_index != -1) {
+          assert(!activeSoft[soft_index]);
+          activeSoft[soft_index] = true;
+          joinObjFunction.push(getRelaxationLit(soft_index));
         }
       }
 
@@ -675,8 +699,8 @@ StatusCode PartMSU3::PartMSU3_binary() {
   vec<Lit> currentObjFunction;
 
   // Initialize partitions, compute guide tree and create encoders
-  TreeNode *current_node = NULL;
-  std::deque<TreeNode *> guide_tree;
+  current_node = NULL;
+  guide_tree.clear();
 
   if (nPartitions() == 0) {
     split(UNFOLDING_MODE, graph_type);
@@ -691,26 +715,58 @@ StatusCode PartMSU3::PartMSU3_binary() {
     (*it)->setEncodingAssumptions(new vec<Lit>());
   }
 
-  // Build solver
-  initRelaxation();
-  solver = rebuildSolver();
+  // Build solver. The solver of a previous search is reused, so that
+  // searches with different user assumptions share the learnt clauses.
+  if (solver == NULL) {
+    initRelaxation();
+    solver = rebuildSolver();
+    for (int i = 0; i < maxsat_formula->nSoft(); i++)
+      mapCore(getAssumptionLit(i), i);
+  } else
+    resetSearch();
   // printf("solver vars %d\n",solver->nVars());
 
+  activeSoft.clear();
   activeSoft.growTo(maxsat_formula->nSoft(), false);
-  for (int i = 0; i < maxsat_formula->nSoft(); i++)
-    coreMapping[getAssumptionLit(i)] = i;
+
+  if (restoreGuideTree(assumptions) && currentLB() == ubCost) {
+    printAnswer(_OPTIMUM_);
+    return _OPTIMUM_;
+  }
+
+  StatusCode status;
+  if (current_node == NULL && disjoint_cores &&
+      startWithDisjointCores(assumptions, status)) {
+    printAnswer(status);
+    return status;
+  }
+  if (current_node == NULL && solveSubtreesInParallel(assumptions, status)) {
+    printAnswer(status);
+    return status;
+  }
 
   for (;;) {
-    res = searchSATSolver(solver, assumptions);
+    if (current_node != NULL)
+      setTraceNode(current_node->getPartitions()[0],
+                   current_node->getPartitions().size());
+    res = searchSATSolver(solver, withUserAssumptions(solver, assumptions));
     if (res == l_True) {
       nbSatisfiable++;
       uint64_t newCost = computeCostModel(solver->model);
+      vec<lbool> &newModel = improveModel(solver->model, newCost);
       if (nbSatisfiable == 1 || newCost < ubCost) {
-        saveModel(solver->model);
+        saveModel(newModel);
         printBound(newCost);
         ubCost = newCost;
       }
 
+      if (ubCost == currentLB()) {
+        if (verbosity > 0)
+          printf("c UB = LB\n");
+        printAnswer(_OPTIMUM_);
+        return _OPTIMUM_;
+      }
+
       if (nbSatisfiable == 1) {
         // assert(part_index == 0);
         current_node = guide_tree.front();
@@ -842,13 +898,14 @@ StatusCode PartMSU3::PartMSU3_binary() {
         return _UNSATISFIABLE_;
       }
 
+      reduceCore(solver);
       current_node->incrementLowerBound();
       lbCost++;
       nbCores++;
       if (verbosity > 0)
         printf("c LB : %-12" PRIu64 "\n", lbCost);
 
-      if (lbCost == ubCost) {
+      if (currentLB() == ubCost) {
         assert(nbSatisfiable > 0);
         if (verbosity > 0)
           printf("c LB = UB\n");
@@ -860,11 +917,11 @@ StatusCode PartMSU3::PartMSU3_binary() {
 
       joinObjFunction.clear();
       for (int i = 0; i < solver->conflict.size(); i++) {
-        if (coreMapping.find(solver->conflict[i]) != coreMapping.end()) {
-          assert(!activeSoft[coreMapping[solver->conflict[i]]]);
-          activeSoft[coreMapping[solver->conflict[i]]] = true;
-          joinObjFunction.push(
-              getRelaxationLit(coreMapping[solver->conflict[i]]));
+        int soft_index = coreSoft(solver->conflict[i]);
+        if (soft_index != -1) {
+          assert(!activeSoft[soft_index]);
+          activeSoft[soft_index] = true;
+          joinObjFunction.push(getRelaxationLit(soft_index));
           nrelaxed++;
         }
       }
@@ -916,15 +973,569 @@ StatusCode PartMSU3::PartMSU3_binary() {
   }
 }
 
+void PartMSU3::saveState(Checkpoint &ck) {
+  if (merge_strategy != _PART_BINARY_ || current_node == NULL)
+    return;
+
+  ck.algorithm = "partmsu3-binary";
+  for (int i = 0; i < activeSoft.size(); i++)
+    if (activeSoft[i])
+      ck.relaxed.push_back(i);
+
+  // Parents that received the encoder of one child are waiting for the other
+  // child, which is the current node, is queued or has a queued descendant.
+  // The ancestors in between may still be without an encoder.
+  std::set<TreeNode *> saved;
+  vec<TreeNode *> nodes;
+  nodes.push(current_node);
+  for (size_t i = 0; i < guide_tree.size(); i++)
+    nodes.push(guide_tree[i]);
+  for (int i = 0; i < nodes.size(); i++)
+    saved.insert(nodes[i]);
+  int nQueued = nodes.size();
+  for (int i = 0; i < nQueued; i++)
+    for (TreeNode *p = nodes[i]->getParent(); p != NULL; p = p->getParent())
+      if (p->hasEncoder() && saved.insert(p).second)
+        nodes.push(p);
+
+  for (int i = 0; i < nodes.size(); i++) {
+    Checkpoint::Node node;
+    node.role = i == 0 ? Checkpoint::_NODE_CURRENT_
+                       : (i < nQueued ? Checkpoint::_NODE_QUEUED_
+                                      : Checkpoint::_NODE_WAITING_);
+    node.first = nodes[i]->getPartitions()[0];
+    node.parts = nodes[i]->getPartitions().size();
+    node.lb = nodes[i]->getLowerBound();
+    ck.nodes.push_back(node);
+  }
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  restoreGuideTree : (assumptions : vec<Lit>&)  ->  [bool]
+  |
+  |  Description:
+  |
+  |    Restores the state of a checkpoint of the binary merging. The guide
+  |    tree is deterministic for the same formula, hence the saved nodes are
+  |    found by their first partition and their number of partitions. The
+  |    leaves that are not saved were already merged and are deleted. Each
+  |    saved node gets an encoder of its relaxed soft clauses at its lower
+  |    bound, as if its cores had been found in this search. A waiting node
+  |    only holds the encoder of its finished child, hence the soft clauses
+  |    of its pending child are left out of it.
+  |
+  |  Pre-conditions:
+  |    * 'guide_tree' contains the leaves computed by 'computeGuideTree'.
+  |
+  |  Post-conditions:
+  |    * 'current_node', 'guide_tree', 'activeSoft' and the bounds are
+  |      restored and 'assumptions' are the assumptions of 'current_node'.
+  |      If the bounds are equal, only the bounds are restored.
+  |    * Returns false if the checkpoint does not match the guide tree, in
+  |      which case only its lower bound is used.
+  |
+  |________________________________________________________________________________________________@*/
+bool PartMSU3::restoreGuideTree(vec<Lit> &assumptions) {
+  if (!resuming || resume_state.algorithm != "partmsu3-binary")
+    return false;
+
+  std::map<std::pair<int, int>, TreeNode *> tree;
+  for (size_t i = 0; i < guide_tree.size(); i++)
+    for (TreeNode *n = guide_tree[i]; n != NULL; n = n->getParent())
+      if (!tree.insert(std::make_pair(std::make_pair(n->getPartitions()[0],
+                                                     n->getPartitions().size()),
+                                      n))
+               .second)
+        break;
+
+  vec<TreeNode *> nodes;
+  int nCurrent = 0;
+  for (size_t i = 0; i < resume_state.nodes.size(); i++) {
+    Checkpoint::Node &node = resume_state.nodes[i];
+    std::map<std::pair<int, int>, TreeNode *>::iterator it =
+        tree.find(std::make_pair(node.first, node.parts));
+    if (it == tree.end() || node.lb < 0)
+      break;
+    nodes.push(it->second);
+    if (node.role == Checkpoint::_NODE_CURRENT_)
+      nCurrent++;
+  }
+  std::set<TreeNode *> saved;
+  for (int i = 0; i < nodes.size(); i++)
+    saved.insert(nodes[i]);
+
+  // The pending child of a waiting node is on the path from the current or
+  // a queued node to the waiting node.
+  std::map<TreeNode *, TreeNode *> pending;
+  for (int i = 0; i < nodes.size(); i++) {
+    if (resume_state.nodes[i].role == Checkpoint::_NODE_WAITING_)
+      continue;
+    for (TreeNode *n = nodes[i]; n->hasParent(); n = n->getParent())
+      if (saved.count(n->getParent()))
+        pending.insert(std::make_pair(n->getParent(), n));
+  }
+  int nAlone = 0;
+  for (int i = 0; i < nodes.size(); i++)
+    if (resume_state.nodes[i].role == Checkpoint::_NODE_WAITING_ &&
+        pending.count(nodes[i]) == 0)
+      nAlone++;
+
+  if (nodes.size() != (int)resume_state.nodes.size() || nCurrent != 1 ||
+      nAlone > 0) {
+    if (print)
+      printf("c Checkpoint does not match the guide tree.\n");
+    resuming = false;
+    return false;
+  }
+  if (!restoreSearch("partmsu3-binary"))
+    return false;
+  // The last core of a finished search may not be relaxed in the checkpoint.
+  if (currentLB() == ubCost)
+    return true;
+
+  for (size_t i = 0; i < resume_state.relaxed.size(); i++)
+    activeSoft[resume_state.relaxed[i]] = true;
+
+  for (size_t i = 0; i < guide_tree.size(); i++) {
+    if (saved.count(guide_tree[i]) == 0) {
+      delete guide_tree[i]->getEncoder();
+      delete guide_tree[i]->getEncodingAssumptions();
+      delete guide_tree[i];
+    }
+  }
+  guide_tree.clear();
+
+  for (int i = 0; i < nodes.size(); i++) {
+    nodes[i]->incrementLowerBound(resume_state.nodes[i].lb);
+    if (resume_state.nodes[i].role == Checkpoint::_NODE_WAITING_)
+      encodeNode(nodes[i], pending[nodes[i]]);
+    else
+      encodeNode(nodes[i]);
+    if (resume_state.nodes[i].role == Checkpoint::_NODE_CURRENT_)
+      current_node = nodes[i];
+    else if (resume_state.nodes[i].role == Checkpoint::_NODE_QUEUED_)
+      guide_tree.push_back(nodes[i]);
+  }
+
+  nodeAssumptions(current_node, assumptions);
+  return true;
+}
+
+// The encoding is built as if all the cores of 'node' had been found in a
+// single SAT call, i.e. it is only built if the lower bound is smaller than
+// the number of relaxed soft clauses.
+void PartMSU3::encodeNode(TreeNode *node, TreeNode *pending) {
+  if (!node->hasEncoder()) {
+    node->setEncoder(new Encoder(incremental_strategy, encoding));
+    node->setEncodingAssumptions(new vec<Lit>());
+  }
+
+  // The partitions of a child are at the start or at the end of its parent.
+  int start = 0, end = node->getPartitions().size();
+  if (pending != NULL) {
+    if (pending->getPartitions()[0] == node->getPartitions()[0])
+      start = pending->getPartitions().size();
+    else
+      end -= pending->getPartitions().size();
+  }
+
+  vec<Lit> currentObjFunction;
+  for (int i = start; i < end; ++i) {
+    int comm = node->getPartitions()[i];
+    for (int j = 0; j < nPartitionSoft(comm); ++j)
+      if (activeSoft[communitySoft(comm)[j]])
+        currentObjFunction.push(getRelaxationLit(communitySoft(comm)[j]));
+  }
+  if (node->getLowerBound() != currentObjFunction.size()) {
+    node->getEncoder()->buildCardinality(solver, currentObjFunction,
+                                         node->getLowerBound());
+    node->getEncoder()->incUpdateCardinality(
+        solver, currentObjFunction, node->getLowerBound(),
+        *(node->getEncodingAssumptions()));
+  }
+}
+
+void PartMSU3::nodeAssumptions(TreeNode *node, vec<Lit> &assumptions) {
+  assumptions.clear();
+  for (int i = 0; i < node->getPartitions().size(); ++i) {
+    int comm = node->getPartitions()[i];
+    for (int j = 0; j < nPartitionSoft(comm); ++j)
+      if (!activeSoft[communitySoft(comm)[j]])
+        assumptions.push(~getAssumptionLit(communitySoft(comm)[j]));
+  }
+  addVector(assumptions, *(node->getEncodingAssumptions()));
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  startWithDisjointCores : (assumptions : vec<Lit>&) (status : StatusCode&)
+  |                           ->  [bool]
+  |
+  |  Description:
+  |
+  |    Finds disjoint cores before the binary merging. A core whose soft
+  |    clauses are all in one leaf of the guide tree is encoded in that leaf,
+  |    as if the leaf had found it. A core that spans several leaves is not
+  |    encoded, since encoding it would merge the leaves before their own
+  |    cores are found, but all the cores remain a lower bound of the search
+  |    (see 'disjointLB').
+  |
+  |  Pre-conditions:
+  |    * 'guide_tree' contains the leaves computed by 'computeGuideTree'.
+  |
+  |  Post-conditions:
+  |    * If it returns false, 'current_node', 'guide_tree' and 'assumptions'
+  |      are the state of the binary merging after the first model.
+  |
+  |________________________________________________________________________________________________@*/
+bool PartMSU3::startWithDisjointCores(vec<Lit> &assumptions,
+                                      StatusCode &status) {
+  std::vector<std::vector<int> > cores;
+  lbool res = findDisjointCores(solver, cores);
+  if (res == l_False) {
+    status = _UNSATISFIABLE_;
+    return true;
+  }
+  if (res == l_Undef) {
+    status = _UNKNOWN_;
+    return true;
+  }
+  if (currentLB() == ubCost) {
+    status = _OPTIMUM_;
+    return true;
+  }
+
+  std::map<int, TreeNode *> leaf;
+  for (size_t i = 0; i < guide_tree.size(); i++)
+    for (int j = 0; j < guide_tree[i]->getPartitions().size(); j++) {
+      int comm = guide_tree[i]->getPartitions()[j];
+      for (int k = 0; k < nPartitionSoft(comm); k++)
+        leaf[communitySoft(comm)[k]] = guide_tree[i];
+    }
+
+  lbCost = 0;
+  for (size_t i = 0; i < cores.size(); i++) {
+    TreeNode *node = leaf.count(cores[i][0]) ? leaf[cores[i][0]] : NULL;
+    for (size_t j = 1; j < cores[i].size() && node != NULL; j++)
+      if (!leaf.count(cores[i][j]) || leaf[cores[i][j]] != node)
+        node = NULL;
+    if (node == NULL)
+      continue;
+    for (size_t j = 0; j < cores[i].size(); j++)
+      activeSoft[cores[i][j]] = true;
+    node->incrementLowerBound();
+    lbCost++;
+  }
+  for (size_t i = 0; i < guide_tree.size(); i++)
+    if (guide_tree[i]->getLowerBound() > 0)
+      encodeNode(guide_tree[i]);
+
+  if (verbosity > 0)
+    printf("c Disjoint cores encoded in leaves : %" PRIu64 " / %d\n", lbCost,
+           (int)cores.size());
+
+  current_node = guide_tree.front();
+  guide_tree.pop_front();
+  nodeAssumptions(current_node, assumptions);
+  return false;
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  solveSubtreesInParallel : (assumptions : vec<Lit>&) (status : StatusCode&)
+  |                            ->  [bool]
+  |
+  |  Description:
+  |
+  |    Sibling subtrees of the guide tree have disjoint soft clauses, hence
+  |    their cores are independent and the sum of their lower bounds is a
+  |    lower bound of the formula. The top of the tree is split until there
+  |    are two subtrees per thread (the largest subtree is split first). Each
+  |    thread has its own SAT solver with the hard clauses and solves whole
+  |    subtrees, from the leaves to the root of the subtree, as the binary
+  |    merging does. The relaxed soft clauses and the lower bounds of the
+  |    subtrees are then encoded in 'solver' and the binary merging continues
+  |    with the roots of the subtrees as the queued nodes.
+  |
+  |  Pre-conditions:
+  |    * 'guide_tree' contains the leaves computed by 'computeGuideTree'.
+  |
+  |  Post-conditions:
+  |    * If it returns false, 'current_node', 'guide_tree' and 'assumptions'
+  |      are the state of the binary merging after the first model (or are
+  |      unchanged if the tree is too small to be split).
+  |
+  |________________________________________________________________________________________________@*/
+bool PartMSU3::solveSubtreesInParallel(vec<Lit> &assumptions,
+                                       StatusCode &status) {
+  int nThreads = threads > 0 ? threads : std::thread::hardware_concurrency();
+  if (nThreads <= 1 || guide_tree.size() <= 1)
+    return false;
+
+  TreeChildren children;
+  for (size_t i = 0; i < guide_tree.size(); i++)
+    for (TreeNode *n = guide_tree[i]; n->hasParent(); n = n->getParent()) {
+      bool seen = children.count(n->getParent()) > 0;
+      children[n->getParent()].push_back(n);
+      if (seen)
+        break;
+    }
+  TreeNode *root = guide_tree[0];
+  while (root->hasParent())
+    root = root->getParent();
+
+  std::vector<TreeNode *> subtrees(1, root);
+  while ((int)subtrees.size() < 2 * nThreads) {
+    int best = -1, best_soft = 0;
+    for (size_t i = 0; i < subtrees.size(); i++) {
+      if (children.count(subtrees[i]) == 0)
+        continue;
+      int nSoft = 0;
+      for (int j = 0; j < subtrees[i]->getPartitions().size(); j++)
+        nSoft += nPartitionSoft(subtrees[i]->getPartitions()[j]);
+      if (best == -1 || nSoft > best_soft) {
+        best = i;
+        best_soft = nSoft;
+      }
+    }
+    if (best == -1)
+      break;
+    std::vector<TreeNode *> &split = children[subtrees[best]];
+    subtrees[best] = split[0];
+    subtrees.insert(subtrees.end(), split.begin() + 1, split.end());
+  }
+  if (nThreads > (int)subtrees.size())
+    nThreads = subtrees.size();
+
+  // The solvers are built before the threads start, since the formula and
+  // the instrumentation of the load are shared.
+  std::vector<Solver *> solvers;
+  for (int t = 0; t < nThreads; t++)
+    solvers.push_back(rebuildSolver());
+
+  parallel_stop = false;
+  parallel_status = _UNKNOWN_;
+  std::atomic<int> next(0);
+  std::vector<std::thread> workers;
+  for (int t = 0; t < nThreads; t++)
+    workers.push_back(std::thread(&PartMSU3::solveSubtrees, this, solvers[t],
+                                  &subtrees, &children, &next));
+  for (int t = 0; t < nThreads; t++) {
+    workers[t].join();
+    delete solvers[t];
+  }
+
+  if (parallel_stop) {
+    status = parallel_status;
+    return true;
+  }
+
+  // The nodes below the subtrees were merged by the threads.
+  std::set<TreeNode *> tops(subtrees.begin(), subtrees.end());
+  for (size_t i = 0; i < guide_tree.size(); i++) {
+    for (TreeNode *n = guide_tree[i]; tops.count(n) == 0;) {
+      TreeNode *parent = n->getParent();
+      if (n->hasEncoder()) {
+        delete n->getEncoder();
+        delete n->getEncodingAssumptions();
+      }
+      delete n;
+      std::vector<TreeNode *> &siblings = children[parent];
+      siblings.erase(std::find(siblings.begin(), siblings.end(), n));
+      if (!siblings.empty())
+        break;
+      n = parent;
+    }
+  }
+
+  guide_tree.clear();
+  for (size_t i = 0; i < subtrees.size(); i++) {
+    encodeNode(subtrees[i]);
+    guide_tree.push_back(subtrees[i]);
+  }
+  current_node = guide_tree.front();
+  guide_tree.pop_front();
+  nodeAssumptions(current_node, assumptions);
+  nbSatisfiable = 1;
+  if (verbosity > 0)
+    printf("c Subtrees %d solved by %d threads: LB %" PRIu64 " UB %" PRIu64
+           "\n",
+           (int)subtrees.size(), nThreads, lbCost, ubCost);
+  return false;
+}
+
+void PartMSU3::solveSubtrees(Solver *S, std::vector<TreeNode *> *subtrees,
+                             TreeChildren *children, std::atomic<int> *next) {
+  for (int i = (*next)++; i < (int)subtrees->size() && !parallel_stop;
+       i = (*next)++)
+    if (!solveSubtree(S, (*subtrees)[i], *children))
+      parallel_stop = true;
+}
+
+// Solves the children of 'node' and then 'node' with MSU3, starting at the
+// sum of the lower bounds of the children. Each node gets a new encoder of its
+// relaxed soft clauses; the encoders of the children are left in the solver
+// but are no longer enforced since their assumptions are dropped. Returns
+// false if the threads must stop.
+bool PartMSU3::solveSubtree(Solver *S, TreeNode *node, TreeChildren &children) {
+  TreeChildren::iterator it = children.find(node);
+  if (it != children.end())
+    for (size_t i = 0; i < it->second.size(); i++) {
+      if (!solveSubtree(S, it->second[i], children))
+        return false;
+      node->incrementLowerBound(it->second[i]->getLowerBound());
+    }
+
+  Encoder encoder(incremental_strategy, encoding);
+  vec<Lit> assumptions;
+  vec<Lit> currentObjFunction;
+  vec<Lit> joinObjFunction;
+  vec<Lit> encodingAssumptions;
+  vec<Lit> merged;
+  for (;;) {
+    currentObjFunction.clear();
+    assumptions.clear();
+    for (int i = 0; i < node->getPartitions().size(); ++i) {
+      int comm = node->getPartitions()[i];
+      for (int j = 0; j < nPartitionSoft(comm); ++j) {
+        int soft_index = communitySoft(comm)[j];
+        if (activeSoft[soft_index])
+          currentObjFunction.push(getRelaxationLit(soft_index));
+        else
+          assumptions.push(~getAssumptionLit(soft_index));
+      }
+    }
+
+    if (!encoder.hasCardEncoding()) {
+      if (node->getLowerBound() != currentObjFunction.size()) {
+        encoder.buildCardinality(S, currentObjFunction, node->getLowerBound());
+        encoder.incUpdateCardinality(S, currentObjFunction,
+                                     node->getLowerBound(),
+                                     encodingAssumptions);
+      }
+    } else {
+      if (joinObjFunction.size() > 0)
+        encoder.joinEncoding(S, joinObjFunction, node->getLowerBound());
+      encodingAssumptions.clear();
+      encoder.incUpdateCardinality(S, currentObjFunction,
+                                   node->getLowerBound(), encodingAssumptions);
+    }
+    addVector(assumptions, encodingAssumptions);
+
+    if (parallel_stop)
+      return false;
+    mergeUserAssumptions(S, assumptions, merged);
+    lbool res = parallelSATSolver(S, merged, node);
+    if (res == l_Undef)
+      return false;
+    if (res == l_True) {
+      parallelModel(S->model);
+      return !parallel_stop;
+    }
+
+    // A core that only has user assumptions is a core of the hard clauses.
+    int nUser = 0;
+    for (int i = 0; i < S->conflict.size(); i++)
+      for (int j = 0; j < user_assumptions.size(); j++)
+        if (S->conflict[i] == ~user_assumptions[j]) {
+          nUser++;
+          break;
+        }
+    if (nUser == S->conflict.size()) {
+      std::lock_guard<std::mutex> guard(parallel_lock);
+      parallel_status = _UNSATISFIABLE_;
+      return false;
+    }
+
+    joinObjFunction.clear();
+    for (int i = 0; i < S->conflict.size(); i++) {
+      int soft_index = coreSoft(S->conflict[i]);
+      if (soft_index != -1) {
+        activeSoft[soft_index] = true;
+        joinObjFunction.push(getRelaxationLit(soft_index));
+      }
+    }
+    node->incrementLowerBound();
+    parallelCore(S->conflict.size());
+    if (parallel_stop)
+      return false;
+  }
+}
+
+// The bounds are read and the call is recorded under 'parallel_lock', since
+// the threads share them, the trace and the profile. The checkpoint and the
+// memory samples are of the main solver and are not taken here.
+lbool PartMSU3::parallelSATSolver(Solver *S, vec<Lit> &assumptions,
+                                  TreeNode *node) {
+  SATCallStart start;
+  {
+    std::lock_guard<std::mutex> guard(parallel_lock);
+    startSATCall(S, start);
+    Progress::get().publish(start.lb, start.ub, model.size() > 0,
+                            node->getPartitions().size());
+  }
+#ifdef SIMP
+  lbool res = ((NSPACE::SimpSolver *)S)->solveLimited(assumptions, false);
+#else
+  lbool res = S->solveLimited(assumptions);
+#endif
+  std::lock_guard<std::mutex> guard(parallel_lock);
+  setTraceNode(node->getPartitions()[0], node->getPartitions().size());
+  recordSATCall(S, start, res, assumptions.size());
+  return res;
+}
+
+void PartMSU3::parallelModel(vec<lbool> &currentModel) {
+  // The cost is updated from the last model, which is shared by the threads.
+  std::lock_guard<std::mutex> guard(parallel_lock);
+  uint64_t newCost = computeCostModel(currentModel);
+  if (model.size() == 0 || newCost < ubCost) {
+    saveModel(currentModel);
+    printBound(newCost);
+    ubCost = newCost;
+  }
+  if (ubCost == currentLB()) {
+    parallel_status = _OPTIMUM_;
+    parallel_stop = true;
+  }
+}
+
+void PartMSU3::parallelCore(int size) {
+  std::lock_guard<std::mutex> guard(parallel_lock);
+  lbCost++;
+  nbCores++;
+  sumSizeCores += size;
+  if (verbosity > 0)
+    printf("c LB : %-12" PRIu64 "\n", lbCost);
+  if (model.size() > 0 && currentLB() == ubCost) {
+    parallel_status = _OPTIMUM_;
+    parallel_stop = true;
+  }
+}
+
+void PartMSU3::memoryUsage(MemoryUsage &mem) {
+  MaxSAT_Partition::memoryUsage(mem);
+  solverMemoryUsage(solver, mem);
+  uint64_t bytes = 0;
+  if (encoder != NULL)
+    bytes += encoder->memoryUsage();
+  if (current_node != NULL && current_node->hasEncoder())
+    bytes += current_node->getEncoder()->memoryUsage();
+  for (size_t i = 0; i < guide_tree.size(); i++)
+    if (guide_tree[i]->hasEncoder())
+      bytes += guide_tree[i]->getEncoder()->memoryUsage();
+  mem.add(_MEM_ENCODERS_, bytes);
+}
+
 StatusCode PartMSU3::search() {
+  // Weighted formulas are solved by stratification on the weights. The weight levels
+  // take the place of the partitions.
   if (maxsat_formula->getProblemType() == _WEIGHTED_) {
-    if(print) {
-      printf("Error: Currently algorithm MSU3 does not support weighted MaxSAT "
-             "instances.\n");
-      printf("s UNKNOWN\n");
-    }
-    throw MaxSATException(__FILE__, __LINE__, "MSU3 does not support weighted");
-    return _UNKNOWN_;
+    printConfiguration();
+    initRelaxation();
+    solver = rebuildSolver();
+    return weightedMSU3(solver);
   }
 
   if (incremental_strategy == _INCREMENTAL_ITERATIVE_) {
@@ -989,15 +1600,18 @@ Solver *PartMSU3::rebuildSolver() {
   for (int i = 0; i < maxsat_formula->nVars(); i++)
     newSATVariable(S);
 
-  for (int i = 0; i < maxsat_formula->nHard(); i++)
-    S->addClause(getHardClause(i).clause);
+  loadHardClauses(S);
 
   vec<Lit> clause;
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
+    if (isUnitRelaxed(i))
+      continue;
+
     clause.clear();
-    getSoftClause(i).clause.copyTo(clause);
-    for (int j = 0; j < getSoftClause(i).relaxation_vars.size(); j++)
-      clause.push(getSoftClause(i).relaxation_vars[j]);
+    getSoftClause(i).copyTo(clause);
+    LitSpan relaxation = maxsat_formula->getRelaxationVars(i);
+    for (int j = 0; j < relaxation.size(); j++)
+      clause.push(relaxation[j]);
 
     S->addClause(clause);
   }
@@ -1051,8 +1665,8 @@ Solver *PartMSU3::rebuildSolver() {
   |
   |  Description:
   |
-  |    Initializes the relaxation variables by adding a fresh variable to the
-  |    'relaxationVars' of each soft clause.
+  |    Initializes the relaxation variables by adding a relaxation literal to
+  |    the 'relaxationVars' of each soft clause (see 'newRelaxationLit').
   |
   |  Post-conditions:
   |    * 'objFunction' contains all relaxation variables that were added to soft
@@ -1061,9 +1675,9 @@ Solver *PartMSU3::rebuildSolver() {
   |________________________________________________________________________________________________@*/
 void PartMSU3::initRelaxation() {
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
-    Lit l = maxsat_formula->newLiteral();
-    getSoftClause(i).relaxation_vars.push(l);
-    getSoftClause(i).assumption_var = l;
+    Lit l = newRelaxationLit(i);
+    maxsat_formula->addRelaxationVar(i, l);
+    maxsat_formula->setAssumptionVar(i, l);
     objFunction.push(l);
   }
 }
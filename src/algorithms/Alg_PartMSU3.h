@@ -37,9 +37,12 @@
 #include "../Encoder.h"
 #include "../MaxSAT_Partition.h"
 #include <algorithm>
+#include <atomic>
 #include <deque>
 #include <map>
+#include <mutex>
 #include <set>
+#include <vector>
 
 namespace openwbo {
 
@@ -98,6 +101,9 @@ public:
     graph_type = graph;
     incremental_strategy = _INCREMENTAL_ITERATIVE_;
     encoding = enc;
+    encoder = NULL;
+    current_node = NULL;
+    threads = 1;
   }
   virtual ~PartMSU3() {
     if (this->solver != NULL) {
@@ -107,6 +113,11 @@ public:
 
   StatusCode search();
 
+  // Enumerates models with the SAT solver that was used in the search.
+  int enumerate(int limit, bool optimal_only, ModelCallback callback) {
+    return enumerateModels(solver, limit, optimal_only, callback);
+  }
+
   // Print solver configuration.
   void printConfiguration() {
 
@@ -129,6 +140,14 @@ public:
 
   int chooseAlgorithm();
 
+  // Number of threads that solve independent subtrees of the guide tree
+  // before the binary merging (0 = one per core, 1 = no parallel phase).
+  void setThreads(int n) { threads = n; }
+
+  // Adds the memory of the SAT solver, of the encoders of the search and of
+  // the partitions.
+  void memoryUsage(MemoryUsage &mem);
+
 protected:
   // Print PartMSU3 configuration.
   void print_PartMSU3_configuration();
@@ -152,8 +171,57 @@ protected:
   void dumpGuideTree(vec<TreeNode *> &tree);
   void sortPartitions(vec<int> &out_parts);
 
+  // Checkpoints of the binary merging
+  //
+  // Saves the relaxed soft clauses and the nodes of the guide tree that have
+  // an encoder.
+  void saveState(Checkpoint &ck);
+  // Rebuilds the encoders of the saved nodes in the guide tree that was
+  // computed for this search, and the assumptions of the current node.
+  bool restoreGuideTree(vec<Lit> &assumptions);
+
+  // Helpers of the binary merging
+  //
+  // Gives 'node' an encoder of its relaxed soft clauses at its lower bound,
+  // leaving out the partitions of its child 'pending' if there is one.
+  void encodeNode(TreeNode *node, TreeNode *pending = NULL);
+  // Assumptions of the soft clauses and of the encoder of 'node'.
+  void nodeAssumptions(TreeNode *node, vec<Lit> &assumptions);
+  // Encodes the disjoint cores found before the first model in the leaves
+  // that contain them. Returns true if the search ended with 'status'.
+  bool startWithDisjointCores(vec<Lit> &assumptions, StatusCode &status);
+
+  // Parallel phase of the binary merging
+  //
+  typedef std::map<TreeNode *, std::vector<TreeNode *> > TreeChildren;
+  // Solves the subtrees below the top of the guide tree with one SAT solver
+  // per thread. Returns true if the search ended with 'status'.
+  bool solveSubtreesInParallel(vec<Lit> &assumptions, StatusCode &status);
+  void solveSubtrees(Solver *S, std::vector<TreeNode *> *subtrees,
+                     TreeChildren *children, std::atomic<int> *next);
+  bool solveSubtree(Solver *S, TreeNode *node, TreeChildren &children);
+  // SAT call of a thread on 'node', recorded like those of
+  // 'searchSATSolver'.
+  lbool parallelSATSolver(Solver *S, vec<Lit> &assumptions, TreeNode *node);
+  // Saves a model or a core of a thread and stops the threads if the
+  // optimum was found.
+  void parallelModel(vec<lbool> &currentModel);
+  void parallelCore(int size);
+
   Solver *solver; // SAT Solver used as a black box.
 
+  Encoder *encoder; // Encoder of the sequential merging.
+  // Node of the guide tree that is being solved and nodes waiting to be
+  // solved in the binary merging.
+  TreeNode *current_node;
+  std::deque<TreeNode *> guide_tree;
+
+  int threads; // Threads of the parallel phase of the binary merging.
+  // Protects the bounds, the statistics and the model in the parallel phase.
+  std::mutex parallel_lock;
+  std::atomic<bool> parallel_stop;
+  StatusCode parallel_status; // Status if the parallel phase ended the search.
+
   // Controls the type of graph that will be used in the partitioning algorithm
   int graph_type;
   // Controls the partition merging strategy used by the algorithm
@@ -168,9 +236,6 @@ protected:
   vec<int> coeffs; // Coefficients of the literals that are used in the
                    // constraint that excludes models.
 
-  std::map<Lit, int> coreMapping; // Mapping between the assumption literal and
-                                  // the respective soft clause.
-
   // Soft clauses that are currently in the MaxSAT formula.
   vec<bool> activeSoft;
 };
@@ -0,0 +1,154 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "Alg_Portfolio.h"
+
+#include <thread>
+
+using namespace openwbo;
+
+Portfolio::~Portfolio() {
+  for (size_t i = 0; i < engines.size(); i++)
+    delete engines[i];
+}
+
+void Portfolio::addEngine(MaxSAT *engine, const char *name) {
+  engines.push_back(engine);
+  names.push_back(name);
+}
+
+void Portfolio::memoryUsage(MemoryUsage &mem) {
+  MaxSAT::memoryUsage(mem);
+  for (size_t i = 0; i < engines.size(); i++)
+    if (engines[i]->getMaxSATFormula() != NULL)
+      engines[i]->memoryUsage(mem);
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  search : [void] ->  [StatusCode]
+  |
+  |  Description:
+  |
+  |    Starts one thread per engine and waits for all of them. An engine that
+  |    is cancelled by another one throws a MaxSATException from its next SAT
+  |    call (or its next slice of conflicts), which ends its thread.
+  |
+  |  Post-conditions:
+  |    * 'model' and 'ubCost' are the best model of all engines.
+  |
+  |________________________________________________________________________________________________@*/
+StatusCode Portfolio::search() {
+  if (engines.empty()) {
+    if (print)
+      printf("Error: The portfolio has no engines.\n");
+    throw MaxSATException(__FILE__, __LINE__, "Portfolio without engines");
+    return _ERROR_;
+  }
+
+  stop = false;
+  shared_lb = currentLB();
+  shared_ub = model.size() > 0 ? ubCost : UINT64_MAX;
+  status = _UNKNOWN_;
+  winner = -1;
+  results.assign(engines.size(), _UNKNOWN_);
+  for (size_t i = 0; i < engines.size(); i++) {
+    engines[i]->loadFormula(maxsat_formula->copyMaxSATFormula());
+    engines[i]->setInitialTime(initialTime);
+    engines[i]->setInitialLB(initialLB);
+    engines[i]->setSharedBounds(this);
+  }
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < engines.size(); i++)
+    threads.push_back(std::thread(&Portfolio::runEngine, this, (int)i));
+  for (size_t i = 0; i < threads.size(); i++)
+    threads[i].join();
+
+  if (verbosity > 0)
+    printf("c Portfolio ended by %s\n",
+           winner >= 0 ? names[winner].c_str() : "the shared bounds");
+
+  printAnswer(status);
+  return searchStatus;
+}
+
+void Portfolio::runEngine(int engine) {
+  StatusCode result = _UNKNOWN_;
+  try {
+    result = engines[engine]->search();
+  } catch (MaxSATException &e) {
+    // Cancelled or not supported by the engine.
+  }
+
+  std::lock_guard<std::mutex> guard(lock);
+  results[engine] = result;
+  if (stop)
+    return;
+
+  // The model of the engine is optimal, but the shared model may be optimal
+  // as well.
+  if (result == _OPTIMUM_ && engines[engine]->getBestCost() < ubCost) {
+    vec<lbool> best;
+    for (int i = 0; i < maxsat_formula->nInitialVars(); i++)
+      best.push(engines[engine]->getValue(i) > 0 ? l_True : l_False);
+    saveModel(best);
+    ubCost = engines[engine]->getBestCost();
+    shared_ub = ubCost;
+    printBound(ubCost);
+  }
+  if (result == _OPTIMUM_ || result == _UNSATISFIABLE_)
+    finish(result, engine);
+}
+
+void Portfolio::finish(StatusCode result, int engine) {
+  status = result;
+  winner = engine;
+  stop = true;
+}
+
+void Portfolio::publishLB(uint64_t lb) {
+  uint64_t current = shared_lb;
+  while (lb > current && !shared_lb.compare_exchange_weak(current, lb))
+    ;
+
+  std::lock_guard<std::mutex> guard(lock);
+  if (!stop && model.size() > 0 && shared_lb >= ubCost)
+    finish(_OPTIMUM_, -1);
+}
+
+void Portfolio::publishModel(vec<lbool> &currentModel, uint64_t cost) {
+  std::lock_guard<std::mutex> guard(lock);
+  if (model.size() == 0 || cost < ubCost) {
+    saveModel(currentModel);
+    ubCost = cost;
+    shared_ub = cost;
+    printBound(cost);
+  }
+  if (!stop && shared_lb >= ubCost)
+    finish(_OPTIMUM_, -1);
+}
@@ -0,0 +1,96 @@
+/*!
+ * \author Ruben Martins - ruben@sat.inesc-id.pt
+ *
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#ifndef Alg_Portfolio_h
+#define Alg_Portfolio_h
+
+#ifdef SIMP
+#include "simp/SimpSolver.h"
+#else
+#include "core/Solver.h"
+#endif
+
+#include "../MaxSAT.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace openwbo {
+
+//=================================================================================================
+// Runs several MaxSAT algorithms in parallel threads, each on its own copy of
+// the formula. The engines share the best model and the best lower bound, and
+// the search ends as soon as one engine proves the optimum or the lower bound
+// of one engine reaches the best model of another. The cost of the best model
+// also tightens the bound of the engines that have a model.
+class Portfolio : public MaxSAT, public SharedBounds {
+
+public:
+  Portfolio(int verb = _VERBOSITY_MINIMAL_)
+      : stop(false), shared_lb(0), shared_ub(UINT64_MAX), status(_UNKNOWN_),
+        winner(-1) {
+    verbosity = verb;
+  }
+  ~Portfolio();
+
+  // Adds an engine that is owned by the portfolio. The engine gets a copy of
+  // the formula at the start of the search.
+  void addEngine(MaxSAT *engine, const char *name);
+
+  StatusCode search(); // Portfolio search.
+
+  // Adds the memory of every engine.
+  void memoryUsage(MemoryUsage &mem);
+
+  // Shared bounds
+  //
+  bool cancelled() { return stop; }
+  uint64_t lowerBound() { return shared_lb; }
+  uint64_t upperBound() { return shared_ub; }
+  void publishLB(uint64_t lb);
+  void publishModel(vec<lbool> &currentModel, uint64_t cost);
+
+protected:
+  void runEngine(int engine); // Search of an engine in its own thread.
+  // Ends the search of every engine with 'status' (requires 'lock').
+  void finish(StatusCode status, int engine);
+
+  std::vector<MaxSAT *> engines;
+  std::vector<std::string> names;
+  std::vector<StatusCode> results; // Status of the search of each engine.
+
+  std::mutex lock; // Protects the model, 'ubCost' and the status.
+  std::atomic<bool> stop;
+  std::atomic<uint64_t> shared_lb;
+  std::atomic<uint64_t> shared_ub; // 'ubCost' once there is a model.
+  StatusCode status; // Status of the portfolio.
+  int winner; // Engine that ended the search (-1 if it were the bounds).
+};
+} // namespace openwbo
+
+#endif
@@ -37,34 +37,25 @@ using namespace openwbo;
 
 /*_________________________________________________________________________________________________
   |
-  |  rebuildWeightSolver : (strategy : int)  ->  [Solver *]
+  |  rebuildSolver : [void]  ->  [Solver *]
   |
-  |   Description:
+  |  Description:
   |
-  |    Rebuilds a SAT solver with the current MaxSAT formula using a
-  |    weight-based strategy.
-  |    Only soft clauses with weight greater or equal to 'currentWeight' are
-  |    considered in the working MaxSAT formula.
+  |    Rebuilds a SAT solver with the current MaxSAT formula.
+  |    All soft clauses are added to the SAT solver. The SAT solver is kept
+  |    during the whole search: the working formula of the weight-based
+  |    strategy is given by the assumptions (see 'weightAssumptions') and the
+  |    relaxation of the cores is added with 'updateSolver', so that learned
+  |    clauses are not lost between iterations.
   |
-  |   For further details see:
-  |     * Ruben Martins, Vasco Manquinho, Inês Lynce: On Partitioning for
-  |       Maximum Satisfiability. ECAI 2012: 913-914
-  |	    * Carlos Ansótegui, Maria Luisa Bonet, Joel Gabàs, Jordi Levy:
-  |       Improving SAT-Based Weighted MaxSAT Solvers. CP 2012: 86-101
-  |
-  |   Pre-conditions:
-  |     * Assumes that 'currentWeight' has been previously updated.
-  |     * Assumes that the weight strategy is either '_WEIGHT_NORMAL_' or
-  |       '_WEIGHT_DIVERSIFY_'.
+  |  Pre-conditions:
+  |    * Assumes that 'initAssumptions' was called before.
   |
-  |   Post-conditions:
-  |     * 'nbCurrentSoft' is updated to the number of soft clauses in the
-  |        working MaxSAT formula.
+  |  Post-conditions:
+  |    * 'nbLoadedHard' is updated to the number of hard clauses.
   |
   |________________________________________________________________________________________________@*/
-Solver *WBO::rebuildWeightSolver(int strategy) {
-
-  assert(strategy == _WEIGHT_NORMAL_ || strategy == _WEIGHT_DIVERSIFY_);
+Solver *WBO::rebuildSolver() {
 
   Solver *S = newSATSolver();
 
@@ -73,28 +64,11 @@ Solver *WBO::rebuildWeightSolver(int strategy) {
   for (int i = 0; i < maxsat_formula->nVars(); i++)
     newSATVariable(S);
 
-  for (int i = 0; i < maxsat_formula->nHard(); i++)
-    S->addClause(maxsat_formula->getHardClause(i).clause);
+  loadHardClauses(S);
+  nbLoadedHard = maxsat_formula->nHard();
 
-  if (symmetryStrategy)
-    symmetryBreaking();
-
-  vec<Lit> clause;
-  nbCurrentSoft = 0;
-  for (int i = 0; i < maxsat_formula->nSoft(); i++) {
-    if (maxsat_formula->getSoftClause(i).weight >=
-        maxsat_formula->getMaximumWeight()) {
-      nbCurrentSoft++;
-      clause.clear();
-      maxsat_formula->getSoftClause(i).clause.copyTo(clause);
-      for (int j = 0;
-           j < maxsat_formula->getSoftClause(i).relaxation_vars.size(); j++)
-        clause.push(maxsat_formula->getSoftClause(i).relaxation_vars[j]);
-
-      clause.push(maxsat_formula->getSoftClause(i).assumption_var);
-      S->addClause(clause);
-    }
-  }
+  for (int i = 0; i < maxsat_formula->nSoft(); i++)
+    loadSoftClause(S, i);
 
   // printf("c #PB: %d\n", maxsat_formula->nPB());
   for (int i = 0; i < maxsat_formula->nPB(); i++) {
@@ -132,142 +106,96 @@ Solver *WBO::rebuildWeightSolver(int strategy) {
   return S;
 }
 
+// Adds the soft clause with its relaxation variables and its assumption
+// literal to 'S'. Unit soft clauses that are assumed directly are not added.
+void WBO::loadSoftClause(Solver *S, int soft) {
+  if (isUnitAssumption(soft))
+    return;
+
+  vec<Lit> clause;
+  maxsat_formula->getSoftClause(soft).copyTo(clause);
+  LitSpan relaxation = maxsat_formula->getRelaxationVars(soft);
+  for (int j = 0; j < relaxation.size(); j++)
+    clause.push(relaxation[j]);
+  clause.push(maxsat_formula->getAssumptionVar(soft));
+
+  S->addClause(clause);
+}
+
 /*_________________________________________________________________________________________________
   |
-  |  rebuildSolver : [void]  ->  [Solver *]
+  |  updateSolver : (S : Solver *)  ->  [void]
   |
   |  Description:
   |
-  |    Rebuilds a SAT solver with the current MaxSAT formula using the original
-  |    WBO strategy.
-  |    All soft clauses are considered in the working formula.
+  |    Adds to the SAT solver the variables and the hard clauses created since
+  |    the last update (exactly one constraints and symmetry breaking clauses)
+  |    and the soft clauses relaxed by 'relaxCore'. A relaxed soft clause
+  |    replaces the previous one, which is satisfied by its old assumption
+  |    literal.
   |
-  |  Pre-conditions:
-  |    * Assumes that the weight strategy is '_WEIGHT_NONE_'.
+  |  Post-conditions:
+  |    * 'nbLoadedHard' is updated to the number of hard clauses.
+  |    * 'newSoft' and 'oldAssumptions' are cleared.
   |
   |________________________________________________________________________________________________@*/
-Solver *WBO::rebuildSolver() {
+void WBO::updateSolver(Solver *S) {
 
-  assert(weightStrategy == _WEIGHT_NONE_);
-
-  Solver *S = newSATSolver();
-
-  reserveSATVariables(S, maxsat_formula->nVars());
-
-  for (int i = 0; i < maxsat_formula->nVars(); i++)
+  while (S->nVars() < maxsat_formula->nVars())
     newSATVariable(S);
 
-  for (int i = 0; i < maxsat_formula->nHard(); i++)
-    S->addClause(maxsat_formula->getHardClause(i).clause);
-
-  if (symmetryStrategy)
-    symmetryBreaking();
-
   vec<Lit> clause;
-  for (int i = 0; i < maxsat_formula->nSoft(); i++) {
-    clause.clear();
-    maxsat_formula->getSoftClause(i).clause.copyTo(clause);
-    for (int j = 0; j < maxsat_formula->getSoftClause(i).relaxation_vars.size();
-         j++)
-      clause.push(maxsat_formula->getSoftClause(i).relaxation_vars[j]);
-    clause.push(maxsat_formula->getSoftClause(i).assumption_var);
-
+  for (int i = nbLoadedHard; i < maxsat_formula->nHard(); i++) {
+    maxsat_formula->getHardClause(i).copyTo(clause);
     S->addClause(clause);
   }
+  nbLoadedHard = maxsat_formula->nHard();
 
-  // printf("c #PB: %d\n", maxsat_formula->nPB());
-  for (int i = 0; i < maxsat_formula->nPB(); i++) {
-    Encoder *enc = new Encoder(_INCREMENTAL_NONE_, _CARD_MTOTALIZER_,
-                               _AMO_LADDER_, _PB_GTE_);
-
-    // Make sure the PB is on the form <=
-    if (!maxsat_formula->getPBConstraint(i)->_sign)
-      maxsat_formula->getPBConstraint(i)->changeSign();
-
-    enc->encodePB(S, maxsat_formula->getPBConstraint(i)->_lits,
-                  maxsat_formula->getPBConstraint(i)->_coeffs,
-                  maxsat_formula->getPBConstraint(i)->_rhs);
-
-    // maxsat_formula->getPBConstraint(i)->print();
-
-    delete enc;
-  }
-
-  // printf("c #Card: %d\n", maxsat_formula->nCard());
-  for (int i = 0; i < maxsat_formula->nCard(); i++) {
-    Encoder *enc = new Encoder(_INCREMENTAL_NONE_, _CARD_MTOTALIZER_,
-                               _AMO_LADDER_, _PB_GTE_);
-
-    if (maxsat_formula->getCardinalityConstraint(i)->_rhs == 1) {
-      enc->encodeAMO(S, maxsat_formula->getCardinalityConstraint(i)->_lits);
-    } else {
-      enc->encodeCardinality(S,
-                             maxsat_formula->getCardinalityConstraint(i)->_lits,
-                             maxsat_formula->getCardinalityConstraint(i)->_rhs);
-    }
+  for (int i = 0; i < oldAssumptions.size(); i++)
+    S->addClause(oldAssumptions[i]);
+  for (int i = 0; i < newSoft.size(); i++)
+    loadSoftClause(S, newSoft[i]);
 
-    delete enc;
-  }
-  return S;
+  oldAssumptions.clear();
+  newSoft.clear();
 }
 
 /*_________________________________________________________________________________________________
   |
-  |  rebuildHardSolver : [void]  ->  [Solver *]
+  |  weightAssumptions : (assumps : vec<Lit>&)  ->  [void]
   |
   |  Description:
   |
-  |    Rebuilds a SAT solver with the hard clauses of the MaxSAT formula.
-  |    Used for testing if the MaxSAT formula is unsatisfiable.
+  |    Selects from 'assumptions' the soft clauses with weight greater or equal
+  |    to 'currentWeight'. These are the soft clauses of the working MaxSAT
+  |    formula; the assumption literals of the others are free and satisfy
+  |    their clauses in the SAT solver.
+  |
+  |   For further details see:
+  |     * Ruben Martins, Vasco Manquinho, Inês Lynce: On Partitioning for
+  |       Maximum Satisfiability. ECAI 2012: 913-914
+  |	    * Carlos Ansótegui, Maria Luisa Bonet, Joel Gabàs, Jordi Levy:
+  |       Improving SAT-Based Weighted MaxSAT Solvers. CP 2012: 86-101
+  |
+  |  Post-conditions:
+  |    * 'nbCurrentSoft' is updated to the number of soft clauses in the
+  |       working MaxSAT formula.
   |
   |________________________________________________________________________________________________@*/
-Solver *WBO::rebuildHardSolver() {
-
-  Solver *S = newSATSolver();
-
-  reserveSATVariables(S, maxsat_formula->nVars());
-
-  for (int i = 0; i < maxsat_formula->nVars(); i++)
-    newSATVariable(S);
-
-  for (int i = 0; i < maxsat_formula->nHard(); i++)
-    S->addClause(maxsat_formula->getHardClause(i).clause);
-
-  // printf("c #PB: %d\n", maxsat_formula->nPB());
-  for (int i = 0; i < maxsat_formula->nPB(); i++) {
-    Encoder *enc = new Encoder(_INCREMENTAL_NONE_, _CARD_MTOTALIZER_,
-                               _AMO_LADDER_, _PB_GTE_);
-
-    // Make sure the PB is on the form <=
-    if (!maxsat_formula->getPBConstraint(i)->_sign)
-      maxsat_formula->getPBConstraint(i)->changeSign();
-
-    enc->encodePB(S, maxsat_formula->getPBConstraint(i)->_lits,
-                  maxsat_formula->getPBConstraint(i)->_coeffs,
-                  maxsat_formula->getPBConstraint(i)->_rhs);
-
-    // maxsat_formula->getPBConstraint(i)->print();
-
-    delete enc;
+void WBO::weightAssumptions(vec<Lit> &assumps) {
+
+  assumps.clear();
+  for (int i = 0; i < assumptions.size(); i++) {
+    int indexSoft = coreSoft(~assumptions[i]);
+    if (indexSoft != -1 &&
+        maxsat_formula->getSoftWeight(indexSoft) >= currentWeight)
+      assumps.push(assumptions[i]);
   }
 
-  // printf("c #Card: %d\n", maxsat_formula->nCard());
-  for (int i = 0; i < maxsat_formula->nCard(); i++) {
-    Encoder *enc = new Encoder(_INCREMENTAL_NONE_, _CARD_MTOTALIZER_,
-                               _AMO_LADDER_, _PB_GTE_);
-
-    if (maxsat_formula->getCardinalityConstraint(i)->_rhs == 1) {
-      enc->encodeAMO(S, maxsat_formula->getCardinalityConstraint(i)->_lits);
-    } else {
-      enc->encodeCardinality(S,
-                             maxsat_formula->getCardinalityConstraint(i)->_lits,
-                             maxsat_formula->getCardinalityConstraint(i)->_rhs);
-    }
-
-    delete enc;
-  }
-
-  return S;
+  nbCurrentSoft = 0;
+  for (int i = 0; i < maxsat_formula->nSoft(); i++)
+    if (maxsat_formula->getSoftWeight(i) >= currentWeight)
+      nbCurrentSoft++;
 }
 
 /*_________________________________________________________________________________________________
@@ -291,11 +219,9 @@ void WBO::updateCurrentWeight(int strategy) {
   assert(strategy == _WEIGHT_NORMAL_ || strategy == _WEIGHT_DIVERSIFY_);
 
   if (strategy == _WEIGHT_NORMAL_)
-    maxsat_formula->setMaximumWeight(
-        findNextWeight(maxsat_formula->getMaximumWeight()));
+    currentWeight = findNextWeight(currentWeight);
   else if (strategy == _WEIGHT_DIVERSIFY_)
-    maxsat_formula->setMaximumWeight(
-        findNextWeightDiversity(maxsat_formula->getMaximumWeight()));
+    currentWeight = findNextWeightDiversity(currentWeight);
 }
 
 /*_________________________________________________________________________________________________
@@ -315,9 +241,9 @@ uint64_t WBO::findNextWeight(uint64_t weight) {
 
   uint64_t nextWeight = 1;
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
-    if (maxsat_formula->getSoftClause(i).weight > nextWeight &&
-        maxsat_formula->getSoftClause(i).weight < weight)
-      nextWeight = maxsat_formula->getSoftClause(i).weight;
+    if (maxsat_formula->getSoftWeight(i) > nextWeight &&
+        maxsat_formula->getSoftWeight(i) < weight)
+      nextWeight = maxsat_formula->getSoftWeight(i);
   }
 
   return nextWeight;
@@ -362,9 +288,9 @@ uint64_t WBO::findNextWeightDiversity(uint64_t weight) {
     nbClauses = 0;
     nbWeights.clear();
     for (int i = 0; i < maxsat_formula->nSoft(); i++) {
-      if (maxsat_formula->getSoftClause(i).weight >= nextWeight) {
+      if (maxsat_formula->getSoftWeight(i) >= nextWeight) {
         nbClauses++;
-        nbWeights.insert(maxsat_formula->getSoftClause(i).weight);
+        nbWeights.insert(maxsat_formula->getSoftWeight(i));
       }
     }
 
@@ -494,6 +420,8 @@ void WBO::encodeEO(vec<Lit> &lits) {
   |    * If the weight of the soft clause is the same as the weight of the core:
   |      - 'softClauses[indexSoft].relaxationVars' is updated with a new
   |        relaxation variable.
+  |      - The soft clause gets a new assumption literal and the old one is
+  |        added to 'oldAssumptions'.
   |    * If the weight of the soft clause is not the same as the weight of the
   |      core:
   |      - 'softClauses[indexSoft].weight' is decreased by the weight of the
@@ -504,6 +432,7 @@ void WBO::encodeEO(vec<Lit> &lits) {
   |        clause.
   |      - 'coreMapping' is updated to map the new soft clause to its assumption
   |        literal.
+  |    * 'newSoft' is updated with the soft clauses to add to the SAT solver.
   |    * 'sumSizeCores' is updated.
   |
   |________________________________________________________________________________________________@*/
@@ -516,28 +445,47 @@ void WBO::relaxCore(const vec<Lit> &conflict, uint64_t weightCore,
   vec<Lit> lits;
 
   for (int i = 0; i < conflict.size(); i++) {
-    int indexSoft = coreMapping[conflict[i]];
+    int indexSoft = coreSoft(conflict[i]);
+    if (indexSoft == -1)
+      continue; // A user assumption, not a soft clause.
 
-    if (maxsat_formula->getSoftClause(indexSoft).weight == weightCore) {
+    if (maxsat_formula->getSoftWeight(indexSoft) == weightCore) {
       // If the weight of the soft clause is the same as the weight of the core
       // then relax it.
+      bool unit = isUnitAssumption(indexSoft);
       Lit p = maxsat_formula->newLiteral();
-      maxsat_formula->getSoftClause(indexSoft).relaxation_vars.push(p);
+      maxsat_formula->addRelaxationVar(indexSoft, p);
       lits.push(p);
 
+      // The relaxed soft clause gets a fresh assumption literal and replaces
+      // the one in the SAT solver, which is satisfied by the old assumption
+      // literal. A unit soft clause assumed directly is not in the SAT solver
+      // (the relaxed clause (l v p v ~l) would be a tautology).
+      Lit old_assumption = maxsat_formula->getAssumptionVar(indexSoft);
+      if (!unit)
+        oldAssumptions.push(old_assumption);
+      Lit l = maxsat_formula->newLiteral();
+      maxsat_formula->setAssumptionVar(indexSoft, l);
+      mapCore(l, indexSoft);
+      for (int j = 0; j < assumps.size(); j++)
+        if (assumps[j] == ~old_assumption)
+          assumps[j] = ~l;
+      newSoft.push(indexSoft);
+
       if (symmetryStrategy)
         symmetryLog(indexSoft);
     } else {
       // If the weight of the soft clause is different from the weight of the
       // core then duplicate the soft clause.
-      assert(maxsat_formula->getSoftClause(indexSoft).weight - weightCore > 0);
+      assert(maxsat_formula->getSoftWeight(indexSoft) - weightCore > 0);
       // Update the weight of the soft clause.
-      maxsat_formula->getSoftClause(indexSoft).weight -= weightCore;
+      maxsat_formula->setSoftWeight(
+          indexSoft, maxsat_formula->getSoftWeight(indexSoft) - weightCore);
 
       vec<Lit> clause;
-      maxsat_formula->getSoftClause(indexSoft).clause.copyTo(clause);
+      maxsat_formula->getSoftClause(indexSoft).copyTo(clause);
       vec<Lit> vars;
-      maxsat_formula->getSoftClause(indexSoft).relaxation_vars.copyTo(vars);
+      maxsat_formula->getRelaxationVars(indexSoft).copyTo(vars);
 
       Lit p = maxsat_formula->newLiteral();
       vars.push(p);
@@ -548,11 +496,11 @@ void WBO::relaxCore(const vec<Lit> &conflict, uint64_t weightCore,
 
       Lit l = maxsat_formula->newLiteral();
       // Create a new assumption literal.
-      maxsat_formula->getSoftClause(maxsat_formula->nSoft() - 1)
-          .assumption_var = l;
-      coreMapping[l] = maxsat_formula->nSoft() -
-                       1; // Map the new soft clause to its assumption literal.
+      maxsat_formula->setAssumptionVar(maxsat_formula->nSoft() - 1, l);
+      // Map the new soft clause to its assumption literal.
+      mapCore(l, maxsat_formula->nSoft() - 1);
       assumps.push(~l);   // Update the assumption vector.
+      newSoft.push(maxsat_formula->nSoft() - 1);
 
       if (symmetryStrategy)
         symmetryLog(maxsat_formula->nSoft() - 1);
@@ -569,7 +517,8 @@ void WBO::relaxCore(const vec<Lit> &conflict, uint64_t weightCore,
   |    Description:
   |
   |      Computes the cost of the core. The cost of a core is the minimum weight
-  |      of the soft clauses that appear in that core.
+  |      of the soft clauses that appear in that core. Literals of the core
+  |      that do not map to a soft clause ('coreSoft' returns -1) are skipped.
   |
   |    Pre-conditions:
   |      * Assumes that 'conflict' is not empty.
@@ -586,11 +535,14 @@ uint64_t WBO::computeCostCore(const vec<Lit> &conflict) {
   uint64_t coreCost = UINT64_MAX;
 
   for (int i = 0; i < conflict.size(); i++) {
-    int indexSoft = coreMapping[conflict[i]];
-    if (maxsat_formula->getSoftClause(indexSoft).weight < coreCost)
-      coreCost = maxsat_formula->getSoftClause(indexSoft).weight;
+    int indexSoft = coreSoft(conflict[i]);
+    if (indexSoft != -1 && maxsat_formula->getSoftWeight(indexSoft) < coreCost)
+      coreCost = maxsat_formula->getSoftWeight(indexSoft);
   }
 
+  // The hard clauses are satisfiable ('unsatSearch'), so a core has a soft
+  // clause.
+  assert(coreCost != UINT64_MAX);
   return coreCost;
 }
 
@@ -650,7 +602,7 @@ void WBO::symmetryLog(int p) {
     // Note: This is the difference between relaxationMapping[p] and
     // softClauses[p].relaxationVars.
     relaxationMapping[p].push(
-        maxsat_formula->getSoftClause(p).relaxation_vars.last());
+        maxsat_formula->getRelaxationVars(p).last());
     // If 'softMapping[p].size()' is equal to 1 then the soft clause only appear
     // in one core.
     // Symmetry breaking only applies when the soft clause has appeared in
@@ -708,7 +660,7 @@ void WBO::symmetryBreaking() {
         if (coreIntersection[core].size() == 0)
           coreList.push(core);
         assert(j < relaxationMapping[p].size());
-        assert(var(relaxationMapping[p][j]) > maxsat_formula->nInitialVars());
+        assert(var(relaxationMapping[p][j]) >= maxsat_formula->nInitialVars());
         coreIntersection[core].push(relaxationMapping[p][j]);
       }
 
@@ -716,7 +668,7 @@ void WBO::symmetryBreaking() {
         int core = addCores[j];
         int b = softMapping[p].size() - 1;
         assert(b < relaxationMapping[p].size());
-        assert(var(relaxationMapping[p][b]) > maxsat_formula->nInitialVars());
+        assert(var(relaxationMapping[p][b]) >= maxsat_formula->nInitialVars());
         coreIntersectionCurrent[core].push(relaxationMapping[p][b]);
       }
 
@@ -783,7 +735,8 @@ void WBO::symmetryBreaking() {
   |
   |  Description:
   |
-  |    Calls a SAT solver only on the hard clauses of the MaxSAT formula.
+  |    Calls the SAT solver without assumptions, i.e. only on the hard clauses
+  |    of the MaxSAT formula.
   |    If the hard clauses are unsatisfiable then the MaxSAT solver terminates
   |    and returns 'UNSATISFIABLE'.
   |    Otherwise, a model has been found and it is stored. Without this call,
@@ -802,10 +755,9 @@ void WBO::symmetryBreaking() {
   |________________________________________________________________________________________________@*/
 StatusCode WBO::unsatSearch() {
 
-  assert(assumptions.size() == 0);
-
-  solver = rebuildHardSolver();
-  lbool res = searchSATSolver(solver, assumptions);
+  // Without assumptions the assumption literals satisfy the soft clauses.
+  vec<Lit> dummy;
+  lbool res = searchSATSolver(solver, dummy);
 
   if (res == l_False) {
     nbCores++;
@@ -820,8 +772,6 @@ StatusCode WBO::unsatSearch() {
     printBound(ubCost);
   }
 
-  delete solver;
-  solver = NULL;
   return _SATISFIABLE_;
 }
 
@@ -855,15 +805,21 @@ StatusCode WBO::weightSearch() {
   assert(weightStrategy == _WEIGHT_NORMAL_ ||
          weightStrategy == _WEIGHT_DIVERSIFY_);
 
-  unsatSearch();
-
   initAssumptions(assumptions);
+  solver = rebuildSolver();
+
+  StatusCode unsat_status = unsatSearch();
+  if (unsat_status != _SATISFIABLE_)
+    return unsat_status;
+
+  currentWeight = maxsat_formula->getMaximumWeight();
   updateCurrentWeight(weightStrategy);
-  solver = rebuildWeightSolver(weightStrategy);
+  vec<Lit> working; // Assumptions of the working MaxSAT formula.
 
   for (;;) {
 
-    lbool res = searchSATSolver(solver, assumptions);
+    weightAssumptions(working);
+    lbool res = searchSATSolver(solver, working);
 
     if (res == l_False) {
       nbCores++;
@@ -874,8 +830,9 @@ StatusCode WBO::weightSearch() {
         printf("c LB : %-12" PRIu64 " CS : %-12d W  : %-12" PRIu64 "\n", lbCost,
                solver->conflict.size(), coreCost);
       relaxCore(solver->conflict, coreCost, assumptions);
-      delete solver;
-      solver = rebuildWeightSolver(weightStrategy);
+      if (symmetryStrategy)
+        symmetryBreaking();
+      updateSolver(solver);
     }
 
     if (res == l_True) {
@@ -906,9 +863,6 @@ StatusCode WBO::weightSearch() {
           printAnswer(_OPTIMUM_);
           return _OPTIMUM_;
         }
-
-        delete solver;
-        solver = rebuildWeightSolver(weightStrategy);
       }
     }
   }
@@ -935,11 +889,13 @@ StatusCode WBO::weightSearch() {
   |________________________________________________________________________________________________@*/
 StatusCode WBO::normalSearch() {
 
-  unsatSearch();
-
   initAssumptions(assumptions);
   solver = rebuildSolver();
 
+  StatusCode unsat_status = unsatSearch();
+  if (unsat_status != _SATISFIABLE_)
+    return unsat_status;
+
   for (;;) {
 
     lbool res = searchSATSolver(solver, assumptions);
@@ -961,8 +917,9 @@ StatusCode WBO::normalSearch() {
       }
 
       relaxCore(solver->conflict, coreCost, assumptions);
-      delete solver;
-      solver = rebuildSolver();
+      if (symmetryStrategy)
+        symmetryBreaking();
+      updateSolver(solver);
     }
 
     if (res == l_True) {
@@ -1029,10 +986,25 @@ StatusCode WBO::search() {
   |
   |________________________________________________________________________________________________@*/
 void WBO::initAssumptions(vec<Lit> &assumps) {
+  // Unit soft clauses can only use their literal as assumption if all soft
+  // clauses are in the working formula.
+  bool unit = maxsat_formula->getProblemType() == _UNWEIGHTED_ ||
+              weightStrategy == _WEIGHT_NONE_;
+
   for (int i = 0; i < maxsat_formula->nSoft(); i++) {
-    Lit l = maxsat_formula->newLiteral();
-    maxsat_formula->getSoftClause(i).assumption_var = l;
-    coreMapping[l] = i;
+    Lit l = unit ? newRelaxationLit(i) : maxsat_formula->newLiteral();
+    maxsat_formula->setAssumptionVar(i, l);
+    mapCore(l, i);
     assumps.push(~l);
   }
 }
+
+// Tests if a soft clause uses the negation of its unit literal as assumption
+// literal. The soft clause is then a tautology and is not added to the SAT
+// solver.
+bool WBO::isUnitAssumption(int soft) {
+  LitSpan clause = maxsat_formula->getSoftClause(soft);
+  return clause.size() == 1 &&
+         maxsat_formula->getRelaxationVars(soft).size() == 0 &&
+         maxsat_formula->getAssumptionVar(soft) == ~clause[0];
+}
@@ -55,6 +55,8 @@ public:
 
     nbCurrentSoft = 0;
     weightStrategy = weight;
+    currentWeight = 1;
+    nbLoadedHard = 0;
 
     symmetryStrategy = symmetry;
     symmetryBreakingLimit = limit;
@@ -67,13 +69,22 @@ public:
 
   StatusCode search(); // WBO search.
 
+  // Adds the memory of the SAT solver and of the encoder.
+  void memoryUsage(MemoryUsage &mem) {
+    MaxSAT::memoryUsage(mem);
+    solverMemoryUsage(solver, mem);
+    mem.add(_MEM_ENCODERS_, encoder.memoryUsage());
+  }
+
 protected:
   // Rebuild MaxSAT solver
   //
-  // Rebuild MaxSAT solver with weight-based strategy.
-  Solver *rebuildWeightSolver(int strategy);
-  Solver *rebuildSolver();     // Rebuild MaxSAT solver.
-  Solver *rebuildHardSolver(); // Rebuild MaxSAT solver with only hard clauses.
+  Solver *rebuildSolver(); // Rebuild MaxSAT solver.
+  void loadSoftClause(Solver *S, int soft); // Adds a soft clause to 'S'.
+  // Adds the clauses created by the relaxation of the cores to 'S'.
+  void updateSolver(Solver *S);
+  // Assumptions of the soft clauses in the working formula of 'weightSearch'.
+  void weightAssumptions(vec<Lit> &assumps);
   void updateCurrentWeight(int strategy); // Updates 'currentWeight'.
   uint64_t
   findNextWeight(uint64_t weight); // Finds the next weight for 'currentWeight'.
@@ -104,6 +115,8 @@ protected:
   // Other
   // Initializes assumptions and core extraction.
   void initAssumptions(vec<Lit> &assumps);
+  // Tests if a soft clause uses its unit literal as assumption.
+  bool isUnitAssumption(int soft);
 
   // SAT solver
   Solver *solver;  // SAT solver used as a black box.
@@ -114,14 +127,19 @@ protected:
   int nbCurrentSoft;  // Current number of soft clauses used by the MaxSAT
                       // solver.
   int weightStrategy; // Weight strategy to be used in 'weightSearch'.
+  uint64_t currentWeight; // Minimum weight of the working MaxSAT formula.
 
   // Core extraction
   //
-  std::map<Lit, int> coreMapping; // Maps the assumption literal to the number
-                                  // of the soft clause.
   vec<Lit> assumptions; // Stores the assumptions to be used in the extraction
                         // of the core.
 
+  // Incremental SAT solver
+  //
+  int nbLoadedHard;   // Number of hard clauses in the SAT solver.
+  vec<int> newSoft;   // Soft clauses relaxed since the last update.
+  vec<Lit> oldAssumptions; // Assumption literals of the replaced soft clauses.
+
   // Symmetry breaking
   //
   bool symmetryStrategy; // Symmetry breaking strategy.
@@ -51,6 +51,15 @@ public:
   }
   ~Adder() {}
 
+  uint64_t memoryUsage() {
+    uint64_t bytes = Encodings::memoryUsage() + vecBytes(_output) +
+                     vecBytes(clause) +
+                     _buckets.capacity() * sizeof(std::queue<Lit>);
+    for (size_t i = 0; i < _buckets.size(); i++)
+      bytes += _buckets[i].size() * sizeof(Lit);
+    return bytes;
+  }
+
   // Encode constraint.
   void encode(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs, uint64_t rhs);
 
@@ -41,6 +41,10 @@ public:
   }
   ~CNetworks() {}
 
+  uint64_t memoryUsage() {
+    return Encodings::memoryUsage() + vecBytes(cardinality_outlits);
+  }
+
   void encode(Solver *S, vec<Lit> &lits, int64_t rhs);
   void update(Solver *S, int64_t rhs);
 
@@ -72,6 +72,12 @@ public:
   }
   ~GTE() {}
 
+  uint64_t memoryUsage() {
+    return Encodings::memoryUsage() + vecBytes(pb_outlits) +
+           mapBytes(pb_oliterals) + vecBytes(unit_lits) +
+           vecBytes(unit_coeffs);
+  }
+
   // Encode constraint.
   void encode(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs, uint64_t rhs);
 
@@ -49,6 +49,11 @@ public:
   }
   ~MTotalizer() {}
 
+  uint64_t memoryUsage() {
+    return Encodings::memoryUsage() + vecBytes(cardinality_inlits) +
+           vecBytes(cardinality_upoutlits) + vecBytes(cardinality_lwoutlits);
+  }
+
   void encode(Solver *S, vec<Lit> &lits, int64_t rhs);
   void update(Solver *S, int64_t rhs);
   void setModulo(int m) { modulo = m; }
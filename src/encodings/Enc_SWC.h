@@ -51,6 +51,16 @@ public:
   }
   ~SWC() {}
 
+  uint64_t memoryUsage() {
+    uint64_t bytes = Encodings::memoryUsage() + vecBytes(pb_outlits) +
+                     vecBytes(unit_lits) + vecBytes(unit_coeffs) +
+                     vecBytes(lits_inc) + vecBytes(coeffs_inc);
+    // 'seq_auxiliary_inc' has one vector per literal of 'lits_inc' plus one
+    for (int i = 0; lits_inc.size() > 0 && i <= lits_inc.size(); i++)
+      bytes += sizeof(vec<Lit>) + vecBytes(seq_auxiliary_inc[i]);
+    return bytes;
+  }
+
   // Encode constraint.
   void encode(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs, uint64_t rhs);
   void encode(Solver *S, vec<Lit> &lits, vec<uint64_t> &coeffs, uint64_t rhs,
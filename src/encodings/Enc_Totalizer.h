@@ -54,6 +54,15 @@ public:
   }
   ~Totalizer() {}
 
+  uint64_t memoryUsage() {
+    return Encodings::memoryUsage() + vecBytes(totalizerIterative_left) +
+           vecBytes(totalizerIterative_right) +
+           vecBytes(totalizerIterative_output) +
+           vecBytes(totalizerIterative_rhs) + vecBytes(ilits) +
+           vecBytes(olits) + vecBytes(cardinality_inlits) +
+           vecBytes(cardinality_outlits) + vecBytes(disable_lits);
+  }
+
   void build(Solver *S, vec<Lit> &lits, int64_t rhs);
   void join(Solver *S, vec<Lit> &lits, int64_t rhs);
   void update(Solver *S, int64_t rhs, vec<Lit> &lits, vec<Lit> &assumptions);
@@ -35,6 +35,7 @@
 #endif
 
 #include "../MaxTypes.h"
+#include "../MemoryUsage.h"
 #include "core/SolverTypes.h"
 
 using NSPACE::vec;
@@ -53,6 +54,9 @@ public:
   Encodings() { hasEncoding = false; }
   ~Encodings() {}
 
+  // Bytes of the auxiliary structures of the encoding.
+  uint64_t memoryUsage() { return vecBytes(clause); }
+
   // Auxiliary methods for creating clauses
   //
   // Add a unit clause to a SAT solver
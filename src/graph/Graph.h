@@ -31,6 +31,7 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "../MemoryUsage.h"
 #include "mtl/Vec.h"
 
 using namespace std;
@@ -85,6 +86,14 @@ public:
 
   int connectedComponents();
 
+  // Bytes reserved by the graph.
+  inline uint64_t memoryUsage() {
+    return vecBytes(_edges) + vecBytes(_weights) + vecBytes(_totalWeights) +
+           vecBytes(_incomingEdges) + vecBytes(_nSelfLoops) +
+           vecBytes(_marks) + vecBytes(_markedVertexes) + vecBytes(_index) +
+           vecBytes(_lowlink) + vecBytes(_stack) + vecBytes(_sccs);
+  }
+
   // Labels, colors and output
 
 protected:
@@ -53,6 +53,14 @@ public:
   inline int vertexCommunity(int u) { return _vertexCommunity[u]; }
   inline double getModularity() { return _modularity; }
 
+  // Bytes reserved by the communities (the working graph is not included).
+  inline uint64_t memoryUsage() {
+    return vecBytes(_vertexCommunity) + vecBytes(_vertexToComm) +
+           vecBytes(_communities) + vecBytes(_inside) + vecBytes(_total) +
+           vecBytes(_adjWeight) + vecBytes(_adjComm) + vecBytes(_adjMarked) +
+           vecBytes(_renumber);
+  }
+
   inline const vec<int> &adjCommunities(int c) { return _g->vertexEdges(c); }
   inline const vec<double> &adjCommunityWeights(int c) {
     return _g->vertexWeights(c);
@@ -0,0 +1,35 @@
+# Additions of the Game of Life solver to the build of Open-WBO, included by
+# the Makefile before its unchanged part.
+
+# The preprocessing uses the SimpSolver also when VERSION is core
+ifneq ($(VERSION),simp)
+DEPDIR     += simp
+endif
+DEPDIR     += ../../life
+# The formula, the portfolio and the parallel searches use threads
+LFLAGS     += -pthread
+CFLAGS     += -pthread
+ifeq ($(INSTRUMENTATION),1)
+CFLAGS     += -DINSTRUMENTATION
+endif
+ifeq ($(GLUCOSE_PROFILE),1)
+CFLAGS     += -DGLUCOSE_PROFILE
+endif
+
+# Generator and checker of boards (see tools/golgen.cc and tools/golcheck.cc)
+TOOLS      = golgen golcheck
+$(TOOLS): %: tools/%.cc
+	$(CXX) -O2 -Wall -std=c++11 -o $@ $<
+
+# Differential check of all algorithms/encodings on a small corpus
+check: main $(TOOLS)
+	tools/check.sh
+
+clean: clean-tools
+clean-tools:
+	rm -f $(TOOLS)
+
+.PHONY: check clean-tools
+
+# The targets above are not the default goal: 'make' builds the solver
+.DEFAULT_GOAL :=
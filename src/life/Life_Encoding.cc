@@ -0,0 +1,177 @@
+/*!
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#include "Life_Encoding.h"
+
+#include <thread>
+#include <vector>
+
+using namespace openwbo;
+
+/*_________________________________________________________________________________________________
+  |
+  |  encode : (nThreads : int) (sizes : vec<int>&) (lits : vec<Lit>&)  ->  [void]
+  |
+  |  Description:
+  |
+  |    Splits the rows of the board into 'nThreads' bands and encodes each band
+  |    in its own thread. The buffer of each band is appended to 'sizes' and
+  |    'lits' in row order, so the result does not depend on the number of
+  |    threads.
+  |
+  |________________________________________________________________________________________________@*/
+void LifeEncoding::encode(int nThreads, vec<int> &sizes, vec<Lit> &lits) {
+  if (nThreads <= 0)
+    nThreads = std::thread::hardware_concurrency();
+  if (nThreads > lin)
+    nThreads = lin;
+  if (nThreads <= 1) {
+    encodeRows(0, lin, sizes, lits);
+    return;
+  }
+
+  std::vector<vec<int> > band_sizes(nThreads);
+  std::vector<vec<Lit> > band_lits(nThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < nThreads; t++) {
+    int begin = (int)((int64_t)lin * t / nThreads);
+    int end = (int)((int64_t)lin * (t + 1) / nThreads);
+    threads.push_back(std::thread(&LifeEncoding::encodeRows, this, begin, end,
+                                  std::ref(band_sizes[t]),
+                                  std::ref(band_lits[t])));
+  }
+
+  int nb_clauses = sizes.size(), nb_lits = lits.size();
+  for (int t = 0; t < nThreads; t++) {
+    threads[t].join();
+    nb_clauses += band_sizes[t].size();
+    nb_lits += band_lits[t].size();
+  }
+
+  sizes.capacity(nb_clauses);
+  lits.capacity(nb_lits);
+  for (int t = 0; t < nThreads; t++) {
+    for (int i = 0; i < band_sizes[t].size(); i++)
+      sizes.push(band_sizes[t][i]);
+    for (int i = 0; i < band_lits[t].size(); i++)
+      lits.push(band_lits[t][i]);
+  }
+}
+
+void LifeEncoding::encodeRows(int begin, int end, vec<int> &sizes,
+                              vec<Lit> &lits) {
+  for (int i = begin; i < end; i++)
+    for (int j = 0; j < col; j++)
+      encodeCell(i, j, sizes, lits);
+}
+
+bool LifeEncoding::findLonelyCell(int &i, int &j) const {
+  if (lin > 1 && col > 1)
+    return false;
+  for (i = 0; i < lin; i++)
+    for (j = 0; j < col; j++) {
+      int n = (i > 0) + (i < lin - 1) + (j > 0) + (j < col - 1);
+      if (board[i * col + j] == 1 && n < 2)
+        return true;
+    }
+  return false;
+}
+
+/*_________________________________________________________________________________________________
+  |
+  |  encodeCell : (i : int) (j : int) (sizes : vec<int>&) (lits : vec<Lit>&)  ->  [void]
+  |
+  |  Description:
+  |
+  |    Generates the clauses of cell (i,j). A subset of the neighbours is a bit
+  |    mask over the neighbours in increasing variable order; the cell itself
+  |    comes after the first 'before' neighbours, which keeps the literals of
+  |    every clause sorted.
+  |
+  |________________________________________________________________________________________________@*/
+void LifeEncoding::encodeCell(int i, int j, vec<int> &sizes, vec<Lit> &lits) {
+  int nbrs[8];
+  int n = 0, before = 0;
+  for (int di = -1; di <= 1; di++)
+    for (int dj = -1; dj <= 1; dj++) {
+      if (di == 0 && dj == 0)
+        before = n;
+      else if (i + di >= 0 && i + di < lin && j + dj >= 0 && j + dj < col)
+        nbrs[n++] = (i + di) * col + j + dj;
+    }
+
+  Lit cell = mkLit(i * col + j, false);
+  bool alive = board[i * col + j] == 1;
+  int full = (1 << n) - 1;
+
+  // A live cell with less than 2 neighbours on the board cannot survive.
+  if (alive && n < 2) {
+    sizes.push(0);
+    return;
+  }
+
+  for (int mask = 0; mask <= full; mask++) {
+    int k = __builtin_popcount(mask);
+    if (alive) {
+      // Loneliness: one of the neighbours in 'mask' is alive.
+      if (k == n - 1)
+        addClause(nbrs, n, before, lit_Undef, 0, full & ~mask, sizes, lits);
+      // Stagnation: if exactly the pair in 'mask' is alive, so is the cell.
+      if (k == 2)
+        addClause(nbrs, n, before, cell, mask, 0, sizes, lits);
+      // Overcrowding: the neighbours in 'mask' are not all alive.
+      if (k == 4)
+        addClause(nbrs, n, before, lit_Undef, mask, full & ~mask, sizes,
+                  lits);
+    } else {
+      // Preservation: if exactly the pair in 'mask' is alive, the cell is dead.
+      if (k == 2)
+        addClause(nbrs, n, before, ~cell, mask, 0, sizes, lits);
+      // Life: the neighbours in 'mask' are not exactly the live ones.
+      if (k == 3)
+        addClause(nbrs, n, before, lit_Undef, mask, 0, sizes, lits);
+    }
+  }
+}
+
+// Adds the clause over the neighbours that are not in 'skip', negated if they
+// are in 'neg', and the cell literal 'c' (if defined).
+void LifeEncoding::addClause(const int *nbrs, int n, int before, Lit c,
+                             int neg, int skip, vec<int> &sizes,
+                             vec<Lit> &lits) {
+  int size = 0;
+  for (int p = 0; p <= n; p++) {
+    if (p == before && c != lit_Undef) {
+      lits.push(c);
+      size++;
+    }
+    if (p == n || (skip >> p & 1))
+      continue;
+    lits.push(mkLit(nbrs[p], neg >> p & 1));
+    size++;
+  }
+  sizes.push(size);
+}
@@ -0,0 +1,83 @@
+/*!
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#ifndef Life_Encoding_h
+#define Life_Encoding_h
+
+#ifdef SIMP
+#include "simp/SimpSolver.h"
+#else
+#include "core/Solver.h"
+#endif
+
+using NSPACE::vec;
+using NSPACE::Lit;
+using NSPACE::mkLit;
+using NSPACE::lit_Undef;
+
+namespace openwbo {
+
+// Hard clauses that make the predecessor evolve into the target board.
+//
+// Cell (i,j) of the predecessor is variable i*col+j. For each cell with 'n'
+// neighbours inside the board the following clauses are generated:
+//   - live target cell: at least 2 live neighbours (loneliness), at most 3
+//     (overcrowding) and, if exactly 2, the cell was alive (stagnation);
+//   - dead target cell: not 3 live neighbours (life) and, if exactly 2, the
+//     cell was dead (preservation).
+// The literals of each clause are sorted. Bands of rows are encoded in
+// parallel into flat buffers (sizes + literals) that are concatenated in row
+// order.
+class LifeEncoding {
+
+public:
+  LifeEncoding(int lin, int col, const int *board)
+      : lin(lin), col(col), board(board) {}
+  ~LifeEncoding() {}
+
+  // Encodes the whole board with 'nThreads' threads (0 = one per core).
+  void encode(int nThreads, vec<int> &sizes, vec<Lit> &lits);
+
+  // Encodes the cells of rows [begin, end).
+  void encodeRows(int begin, int end, vec<int> &sizes, vec<Lit> &lits);
+
+  // Finds a live cell with less than 2 neighbours on the board (only on a
+  // board with a single row or column). Its clause is empty, hence the board
+  // has no predecessor. Returns false if there is none.
+  bool findLonelyCell(int &i, int &j) const;
+
+protected:
+  int lin, col;
+  const int *board;
+
+  void encodeCell(int i, int j, vec<int> &sizes, vec<Lit> &lits);
+  void addClause(const int *nbrs, int n, int before, Lit c, int neg, int skip,
+                 vec<int> &sizes, vec<Lit> &lits);
+};
+
+} // namespace openwbo
+
+#endif
@@ -0,0 +1,219 @@
+/*!
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#include "Life_LowerBound.h"
+
+#include <vector>
+
+using namespace openwbo;
+
+namespace {
+
+// State of the branch and bound used for small components.
+struct PackSearch {
+  const uint64_t *adj;
+  uint64_t best_set;
+  int best;
+  uint64_t nodes;
+  uint64_t budget;
+  bool aborted;
+
+  void search(uint64_t cand, uint64_t chosen, int size) {
+    if (++nodes > budget) {
+      aborted = true;
+      return;
+    }
+
+    // Windows without conflicts among the candidates can always be added.
+    int v = -1, v_deg = 65;
+    for (uint64_t p = cand; p != 0; p &= p - 1) {
+      int u = __builtin_ctzll(p);
+      int deg = __builtin_popcountll(adj[u] & cand);
+      if (deg == 0) {
+        chosen |= (uint64_t)1 << u;
+        cand &= ~((uint64_t)1 << u);
+        size++;
+      } else if (deg < v_deg) {
+        v = u;
+        v_deg = deg;
+      }
+    }
+
+    if (size > best) {
+      best = size;
+      best_set = chosen;
+    }
+    if (cand == 0 || size + __builtin_popcountll(cand) <= best)
+      return;
+
+    uint64_t bit = (uint64_t)1 << v;
+    search(cand & ~adj[v] & ~bit, chosen | bit, size + 1);
+    if (!aborted)
+      search(cand & ~bit, chosen, size);
+  }
+};
+
+} // namespace
+
+/*_________________________________________________________________________________________________
+  |
+  |  compute : (exact_limit : int) (node_budget : uint64_t)  ->  [void]
+  |
+  |  Description:
+  |
+  |    Packs pairwise-disjoint 3x3 windows centred at live target cells. Only
+  |    interior cells are considered since the window of a border cell is not
+  |    fully inside the board. Two windows overlap iff their centres are at
+  |    most 2 cells apart in both directions, which defines a conflict graph
+  |    whose independent sets are the valid packings.
+  |
+  |  Post-conditions:
+  |    * 'centers' contains the centre cell of every window of the packing.
+  |    * 'exact' is true if the packing is maximum.
+  |
+  |________________________________________________________________________________________________@*/
+void LifeLowerBound::compute(int exact_limit, uint64_t node_budget) {
+  centers.clear();
+  exact = true;
+
+  vec<int> cells;
+  vec<int> id(lin * col, -1);
+  for (int i = 1; i < lin - 1; i++)
+    for (int j = 1; j < col - 1; j++)
+      if (board[i * col + j] == 1) {
+        id[i * col + j] = cells.size();
+        cells.push(i * col + j);
+      }
+
+  vec<vec<int> > nbrs(cells.size());
+  for (int c = 0; c < cells.size(); c++) {
+    int i = cells[c] / col, j = cells[c] % col;
+    for (int di = -2; di <= 2; di++)
+      for (int dj = -2; dj <= 2; dj++) {
+        int a = i + di, b = j + dj;
+        if ((di != 0 || dj != 0) && a >= 0 && a < lin && b >= 0 && b < col &&
+            id[a * col + b] != -1)
+          nbrs[c].push(id[a * col + b]);
+      }
+  }
+
+  // Solve each connected component of the conflict graph on its own.
+  vec<int> comp_of(cells.size(), -1);
+  vec<int> comp, local(cells.size(), -1), packing;
+  for (int s = 0; s < cells.size(); s++) {
+    if (comp_of[s] != -1)
+      continue;
+
+    comp.clear();
+    comp.push(s);
+    comp_of[s] = s;
+    for (int k = 0; k < comp.size(); k++)
+      for (int n = 0; n < nbrs[comp[k]].size(); n++)
+        if (comp_of[nbrs[comp[k]][n]] == -1) {
+          comp_of[nbrs[comp[k]][n]] = s;
+          comp.push(nbrs[comp[k]][n]);
+        }
+
+    packing.clear();
+    packGreedy(comp, nbrs, packing);
+
+    if (comp.size() > 1 && (int)packing.size() < comp.size()) {
+      if (comp.size() <= exact_limit && comp.size() <= 64) {
+        for (int k = 0; k < comp.size(); k++)
+          local[comp[k]] = k;
+        vec<uint64_t> adj(comp.size(), 0);
+        for (int k = 0; k < comp.size(); k++)
+          for (int n = 0; n < nbrs[comp[k]].size(); n++)
+            adj[k] |= (uint64_t)1 << local[nbrs[comp[k]][n]];
+        packExact(comp, adj, node_budget, packing);
+      } else
+        exact = false;
+    }
+
+    for (int k = 0; k < packing.size(); k++)
+      centers.push(cells[packing[k]]);
+  }
+}
+
+// Greedy packing that scans the windows by increasing number of conflicts.
+void LifeLowerBound::packGreedy(vec<int> &comp, vec<vec<int> > &nbrs,
+                                vec<int> &out) {
+  // At most 24 other centres fit in the 5x5 area around a centre.
+  vec<vec<int> > by_degree(25);
+  for (int k = 0; k < comp.size(); k++)
+    by_degree[nbrs[comp[k]].size()].push(comp[k]);
+
+  std::vector<bool> blocked;
+  int max_id = 0;
+  for (int k = 0; k < comp.size(); k++)
+    if (comp[k] > max_id)
+      max_id = comp[k];
+  blocked.resize(max_id + 1, false);
+
+  for (int d = 0; d < by_degree.size(); d++)
+    for (int k = 0; k < by_degree[d].size(); k++) {
+      int c = by_degree[d][k];
+      if (blocked[c])
+        continue;
+      out.push(c);
+      blocked[c] = true;
+      for (int n = 0; n < nbrs[c].size(); n++)
+        blocked[nbrs[c][n]] = true;
+    }
+}
+
+// Replaces 'out' by a maximum packing unless the node budget is exhausted.
+void LifeLowerBound::packExact(vec<int> &comp, vec<uint64_t> &adj,
+                               uint64_t node_budget, vec<int> &out) {
+  PackSearch ps;
+  ps.adj = (const uint64_t *)adj;
+  ps.best = out.size();
+  ps.best_set = 0;
+  ps.nodes = 0;
+  ps.budget = node_budget;
+  ps.aborted = false;
+
+  uint64_t all = comp.size() == 64 ? ~(uint64_t)0
+                                   : (((uint64_t)1 << comp.size()) - 1);
+  ps.search(all, 0, 0);
+
+  if (ps.aborted)
+    exact = false;
+
+  if (ps.best_set != 0) {
+    out.clear();
+    for (uint64_t p = ps.best_set; p != 0; p &= p - 1)
+      out.push(comp[__builtin_ctzll(p)]);
+  }
+}
+
+void LifeLowerBound::windowLits(int w, vec<Lit> &lits) {
+  lits.clear();
+  int i = centers[w] / col, j = centers[w] % col;
+  for (int di = -1; di <= 1; di++)
+    for (int dj = -1; dj <= 1; dj++)
+      lits.push(mkLit((i + di) * col + j + dj));
+}
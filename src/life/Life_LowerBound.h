@@ -0,0 +1,87 @@
+/*!
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#ifndef Life_LowerBound_h
+#define Life_LowerBound_h
+
+#ifdef SIMP
+#include "simp/SimpSolver.h"
+#else
+#include "core/Solver.h"
+#endif
+
+#include <stdint.h>
+
+using NSPACE::vec;
+using NSPACE::Lit;
+using NSPACE::mkLit;
+
+namespace openwbo {
+
+// Admissible lower bound on the number of live cells of a predecessor.
+//
+// Every live target cell needs at least three live predecessor cells in the
+// 3x3 window around it: two neighbours if it survives, three if it is born.
+// The windows of a set of live cells that are pairwise disjoint therefore
+// force at least 3 live cells each. The packing is computed greedily and, for
+// each connected group of overlapping windows that is small enough, improved
+// to a maximum packing with a branch and bound.
+class LifeLowerBound {
+
+public:
+  LifeLowerBound(int lin, int col, const int *board)
+      : lin(lin), col(col), board(board), exact(true) {}
+  ~LifeLowerBound() {}
+
+  // Computes the packing. Components with at most 'exact_limit' windows are
+  // solved exactly (0 = greedy only).
+  void compute(int exact_limit = 48, uint64_t node_budget = 1000000);
+
+  // Number of live predecessor cells forced by the packing.
+  uint64_t lowerBound() { return 3 * (uint64_t)centers.size(); }
+
+  int nWindows() { return centers.size(); }
+  bool isExact() { return exact; }
+
+  // Predecessor cell literals of the window 'w' (at least 3 must be true).
+  void windowLits(int w, vec<Lit> &lits);
+
+protected:
+  int lin, col;
+  const int *board;
+
+  vec<int> centers; // Centre cell of each window of the packing.
+  bool exact;       // True if every component was solved to optimality.
+
+  // Maximum independent set of a component with at most 64 windows.
+  void packExact(vec<int> &comp, vec<uint64_t> &adj, uint64_t node_budget,
+                 vec<int> &out);
+  void packGreedy(vec<int> &comp, vec<vec<int> > &nbrs, vec<int> &out);
+};
+
+} // namespace openwbo
+
+#endif
@@ -2,3 +2,8 @@ VERSION    = core
 SOLVERNAME = "Glucose4.1"
 SOLVERDIR  = glucose4.1
 NSPACE     = Glucose
+
+# Glucose can add trusted clauses in bulk
+CFLAGS     += -DSAT_HAS_BULK_CLAUSES
+# and report the memory used by its main structures
+CFLAGS     += -DSAT_HAS_MEMORY_USAGE
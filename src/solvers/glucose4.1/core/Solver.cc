@@ -462,6 +462,75 @@ bool Solver::addClause_(vec <Lit> &ps) {
 }
 
 
+/*_________________________________________________________________________________________________
+|
+|  memoryUsage : (arena : uint64_t&) (watchLists : uint64_t&) (learntClauses : uint64_t&)  ->  [void]
+|  
+|  Description:
+|    Bytes reserved by the clause arena, by the watch lists (long, binary and unary) and by the
+|    learnt clause database. Learnt clauses live in the arena, so 'learntClauses' is the part of
+|    'arena' they use plus the vector of their references.
+|________________________________________________________________________________________________@*/
+void Solver::memoryUsage(uint64_t& arena, uint64_t& watchLists, uint64_t& learntClauses) {
+    arena = (uint64_t)ca.getCap() * sizeof(uint32_t);
+
+    watchLists = 0;
+    for(int v = 0; v < nVars(); v++)
+        for(int s = 0; s < 2; s++) {
+            Lit p = mkLit(v, s);
+            watchLists += (uint64_t)(watches[p].capacity() + watchesBin[p].capacity() +
+                                     unaryWatches[p].capacity()) * sizeof(Watcher);
+        }
+
+    learntClauses = (uint64_t)learnts.capacity() * sizeof(CRef);
+    for(int i = 0; i < learnts.size(); i++)
+        learntClauses += sizeof(Clause) + sizeof(Lit) * (ca[learnts[i]].size() + 1); // +1: extra field
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  addClauses : (sizes : const vec<int>&) (lits : const vec<Lit>&)  ->  [bool]
+|  
+|  Description:
+|    Adds clauses in bulk. 'lits' holds the literals of all clauses one after another and 'sizes'
+|    the number of literals of each clause. The clauses are trusted: they are not sorted and must
+|    not contain duplicate or complementary literals. Units are propagated once at the end.
+|    If the solver has root level assignments, every clause is added with 'addClause_'.
+|________________________________________________________________________________________________@*/
+bool Solver::addClauses(const vec<int>& sizes, const vec<Lit>& lits) {
+
+    assert(decisionLevel() == 0);
+    if(!ok) return false;
+
+    bool checked = trail.size() > 0;
+    int pos = 0;
+    for(int i = 0; i < sizes.size(); i++) {
+        add_tmp.clear();
+        for(int k = 0; k < sizes[i]; k++)
+            add_tmp.push(lits[pos++]);
+
+        if(checked) {
+            if(!addClause_(add_tmp))
+                return false;
+        } else if(add_tmp.size() == 0)
+            return ok = false;
+        else if(add_tmp.size() == 1) {
+            if(value(add_tmp[0]) == l_False)
+                return ok = false;
+            if(value(add_tmp[0]) == l_Undef)
+                uncheckedEnqueue(add_tmp[0]);
+        } else {
+            CRef cr = ca.alloc(add_tmp, false);
+            clauses.push(cr);
+            attachClause(cr);
+        }
+    }
+
+    return ok = (propagate() == CRef_Undef);
+}
+
+
 void Solver::attachClause(CRef cr) {
     const Clause &c = ca[cr];
 
@@ -679,6 +748,7 @@ void Solver::cancelUntil(int level) {
 // Major methods:
 
 Lit Solver::pickBranchLit() {
+    PROFILE_SCOPE(pickBranchLit);
     Var next = var_Undef;
 
     // Random decision:
@@ -736,6 +806,7 @@ Lit Solver::pickBranchLit() {
 |  
 |________________________________________________________________________________________________@*/
 void Solver::analyze(CRef confl, vec <Lit> &out_learnt, vec <Lit> &selectors, int &out_btlevel, unsigned int &lbd, unsigned int &szWithoutSelectors) {
+    PROFILE_SCOPE(analyze);
     int pathC = 0;
     Lit p = lit_Undef;
 
@@ -1031,6 +1102,7 @@ void Solver::bumpForceUNSAT(Lit q) {
 |      * the propagation queue is empty, even if there was a conflict.
 |________________________________________________________________________________________________@*/
 CRef Solver::propagate() {
+    PROFILE_SCOPE(propagate);
     CRef confl = CRef_Undef;
     int num_props = 0;
     watches.cleanAll();
@@ -1041,6 +1113,7 @@ CRef Solver::propagate() {
         vec <Watcher> &ws = watches[p];
         Watcher *i, *j, *end;
         num_props++;
+        PROFILE_SAMPLE(watchLengths, ws.size());
 
 
         // First, Propagate binary clauses
@@ -1071,6 +1144,7 @@ CRef Solver::propagate() {
             CRef cr = i->cref;
             Clause &c = ca[cr];
             assert(!c.getOneWatched());
+            PROFILE_SAMPLE(clauseSizes, c.size());
             Lit false_lit = ~p;
             if(c[0] == false_lit)
                 c[0] = c[1], c[1] = false_lit;
@@ -1251,6 +1325,7 @@ CRef Solver::propagateUnaryWatches(Lit p) {
 
 
 void Solver::reduceDB() {
+    PROFILE_SCOPE(reduceDB);
 
     int i, j;
     stats[nbReduceDB]++;
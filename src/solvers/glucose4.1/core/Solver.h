@@ -58,6 +58,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "core/Constants.h"
 #include "mtl/Clone.h"
 #include "core/SolverStats.h"
+#include "core/SolverProfile.h"
 
 
 namespace Glucose {
@@ -124,6 +125,7 @@ public:
     bool    addClause (Lit p, Lit q, Lit r);                    // Add a ternary clause to the solver. 
     virtual bool    addClause_(      vec<Lit>& ps);                     // Add a clause to the solver without making superflous internal copy. Will
                                                                 // change the passed vector 'ps'.
+    virtual bool    addClauses(const vec<int>& sizes, const vec<Lit>& lits); // Add trusted clauses in bulk (see 'addClauses' in Solver.cc).
     // Solving:
     //
     bool    simplify     ();                        // Removes already satisfied clauses.
@@ -165,6 +167,7 @@ public:
     int     nLearnts   ()      const;       // The current number of learnt clauses.
     int     nVars      ()      const;       // The current number of variables.
     int     nFreeVars  ()      ;
+    void    memoryUsage(uint64_t& arena, uint64_t& watchLists, uint64_t& learntClauses); // Bytes of the main structures.
 
     inline char valuePhase(Var v) {return polarity[v];}
 
@@ -178,6 +181,7 @@ public:
     void    setConfBudget(int64_t x);
     void    setPropBudget(int64_t x);
     void    budgetOff();
+    int64_t confBudget() const;   // Conflicts at which the budget ends (-1 means no budget).
     void    interrupt();          // Trigger a (potentially asynchronous) interruption of the solver.
     void    clearInterrupt();     // Clear interrupt indicator flag.
 
@@ -269,6 +273,11 @@ public:
     // Important stats completely related to search. Keep here
     uint64_t solves,starts,decisions,propagations,conflicts,conflictsRestarts;
 
+#ifdef GLUCOSE_PROFILE
+    // Cycles of the hot functions (see SolverProfile.h)
+    SolverProfile profile;
+#endif
+
 protected:
 
     long curRestart;
@@ -545,6 +554,7 @@ inline void     Solver::setPropBudget(int64_t x){ propagation_budget = propagati
 inline void     Solver::interrupt(){ asynch_interrupt = true; }
 inline void     Solver::clearInterrupt(){ asynch_interrupt = false; }
 inline void     Solver::budgetOff(){ conflict_budget = propagation_budget = -1; }
+inline int64_t  Solver::confBudget() const { return conflict_budget; }
 inline bool     Solver::withinBudget() const {
     return !asynch_interrupt &&
            (conflict_budget    < 0 || conflicts < (uint64_t)conflict_budget) &&
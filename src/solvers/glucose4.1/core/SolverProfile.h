@@ -0,0 +1,163 @@
+/********************************************************************************[SolverProfile.h]
+ Glucose -- Copyright (c) 2009-2014, Gilles Audemard, Laurent Simon
+                                CRIL - Univ. Artois, France
+                                LRI  - Univ. Paris Sud, France (2009-2013)
+                                Labri - Univ. Bordeaux, France
+
+ Syrup (Glucose Parallel) -- Copyright (c) 2013-2014, Gilles Audemard, Laurent Simon
+                                CRIL - Univ. Artois, France
+                                Labri - Univ. Bordeaux, France
+
+Glucose sources are based on MiniSat (see below MiniSat copyrights). Permissions and copyrights of
+Glucose (sources until 2013, Glucose 3.0, single core) are exactly the same as Minisat on which it 
+is based on. (see below).
+
+Glucose-Syrup sources are based on another copyright. Permissions and copyrights for the parallel
+version of Glucose-Syrup (the "Software") are granted, free of charge, to deal with the Software
+without restriction, including the rights to use, copy, modify, merge, publish, distribute,
+sublicence, and/or sell copies of the Software, and to permit persons to whom the Software is 
+furnished to do so, subject to the following conditions:
+
+- The above and below copyrights notices and this permission notice shall be included in all
+copies or substantial portions of the Software;
+- The parallel version of Glucose (all files modified since Glucose 3.0 releases, 2013) cannot
+be used in any competitive event (sat competitions/evaluations) without the express permission of 
+the authors (Gilles Audemard / Laurent Simon). This is also the case for any competitive event
+using Glucose Parallel as an embedded SAT engine (single core or not).
+
+
+--------------- Original Minisat Copyrights
+
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+
+#ifndef SOLVERPROFILE_H
+#define	SOLVERPROFILE_H
+
+// Cycle counters of the hot functions of the solver and histograms of the
+// work done by 'propagate'. Only compiled with GLUCOSE_PROFILE defined
+// (make GLUCOSE_PROFILE=1 in the Open-WBO directory); otherwise the macros
+// below expand to nothing.
+
+#ifdef GLUCOSE_PROFILE
+
+#include <stdint.h>
+#include <stdio.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+namespace Glucose {
+
+    // Histogram with power of two buckets: bucket k counts values in [2^(k-1), 2^k).
+    class ProfileHistogram {
+    public:
+        enum { nbBuckets = 33 };
+        uint64_t bucket[nbBuckets];
+
+        ProfileHistogram() { for(int i = 0; i < nbBuckets; i++) bucket[i] = 0; }
+
+        void add(uint32_t v) { bucket[v == 0 ? 0 : 32 - __builtin_clz(v)]++; }
+
+        void print(FILE *out, const char *prefix, const char *name) const {
+            uint64_t total = 0;
+            for(int i = 0; i < nbBuckets; i++) total += bucket[i];
+            for(int i = 0; i < nbBuckets; i++) {
+                if(bucket[i] == 0) continue;
+                uint64_t lo = i == 0 ? 0 : (uint64_t)1 << (i - 1), hi = i == 0 ? 0 : ((uint64_t)1 << i) - 1;
+                fprintf(out, "%s%s %llu-%llu: %llu (%.1f%%)\n", prefix, name, (unsigned long long)lo,
+                        (unsigned long long)hi, (unsigned long long)bucket[i], 100.0 * bucket[i] / total);
+            }
+        }
+    };
+
+    class SolverProfile {
+    public:
+        enum { prof_propagate = 0, prof_analyze, prof_reduceDB, prof_pickBranchLit, nbFunctions };
+
+        uint64_t cycles[nbFunctions];   // Time stamp counter ticks spent in each function
+        uint64_t calls[nbFunctions];
+        ProfileHistogram watchLengths;  // Length of the watch lists visited by propagate
+        ProfileHistogram clauseSizes;   // Size of the clauses inspected by propagate
+
+        SolverProfile() { for(int i = 0; i < nbFunctions; i++) cycles[i] = calls[i] = 0; }
+
+        static inline uint64_t ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+#else
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+        }
+
+        // Adds the work done between the snapshots 'before' and 'after'.
+        void accumulate(const SolverProfile &after, const SolverProfile &before) {
+            for(int i = 0; i < nbFunctions; i++) {
+                cycles[i] += after.cycles[i] - before.cycles[i];
+                calls[i] += after.calls[i] - before.calls[i];
+            }
+            for(int i = 0; i < ProfileHistogram::nbBuckets; i++) {
+                watchLengths.bucket[i] += after.watchLengths.bucket[i] - before.watchLengths.bucket[i];
+                clauseSizes.bucket[i] += after.clauseSizes.bucket[i] - before.clauseSizes.bucket[i];
+            }
+        }
+
+        void print(FILE *out, const char *prefix) const {
+            static const char *names[nbFunctions] = {"propagate", "analyze", "reduceDB", "pickBranchLit"};
+            uint64_t total = 0;
+            for(int i = 0; i < nbFunctions; i++) total += cycles[i];
+            for(int i = 0; i < nbFunctions; i++)
+                fprintf(out, "%s%-14s cycles %14llu (%5.1f%%) calls %12llu cycles/call %10.1f\n", prefix, names[i],
+                        (unsigned long long)cycles[i], total == 0 ? 0 : 100.0 * cycles[i] / total,
+                        (unsigned long long)calls[i], calls[i] == 0 ? 0 : (double)cycles[i] / calls[i]);
+            watchLengths.print(out, prefix, "watch-list length");
+            clauseSizes.print(out, prefix, "clause size");
+        }
+    };
+
+    // Adds the ticks from its construction to its destruction to a function.
+    class ProfileScope {
+        SolverProfile &profile;
+        int function;
+        uint64_t start;
+    public:
+        ProfileScope(SolverProfile &p, int f) : profile(p), function(f), start(SolverProfile::ticks()) {}
+        ~ProfileScope() {
+            profile.cycles[function] += SolverProfile::ticks() - start;
+            profile.calls[function]++;
+        }
+    };
+
+}
+
+#define PROFILE_SCOPE(f) Glucose::ProfileScope profile_scope_(profile, Glucose::SolverProfile::prof_##f)
+#define PROFILE_SAMPLE(h, v) profile.h.add(v)
+
+#else
+
+#define PROFILE_SCOPE(f)
+#define PROFILE_SAMPLE(h, v)
+
+#endif
+
+#endif	/* SOLVERPROFILE_H */
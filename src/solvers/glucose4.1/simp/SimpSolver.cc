@@ -258,6 +258,22 @@ bool SimpSolver::addClause_(vec<Lit>& ps)
 }
 
 
+// The occurrence lists of the simplifier are kept by 'addClause_', so bulk insertion goes
+// through it clause by clause.
+bool SimpSolver::addClauses(const vec<int>& sizes, const vec<Lit>& lits)
+{
+    int pos = 0;
+    for (int i = 0; i < sizes.size(); i++){
+        add_tmp.clear();
+        for (int k = 0; k < sizes[i]; k++)
+            add_tmp.push(lits[pos++]);
+        if (!addClause_(add_tmp))
+            return false;
+    }
+    return true;
+}
+
+
 
 void SimpSolver::removeClause(CRef cr,bool inPurgatory)
 {
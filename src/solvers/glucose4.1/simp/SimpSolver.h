@@ -86,6 +86,7 @@ class SimpSolver : public Solver {
     bool    addClause (Lit p, Lit q);        // Add a binary clause to the solver.
     bool    addClause (Lit p, Lit q, Lit r); // Add a ternary clause to the solver.
     virtual bool    addClause_(      vec<Lit>& ps);
+    virtual bool    addClauses(const vec<int>& sizes, const vec<Lit>& lits);
     bool    substitute(Var v, Lit x);  // Replace all occurences of v with x (may cause a contradiction).
 
     // Variable mode:
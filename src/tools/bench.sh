@@ -0,0 +1,59 @@
+#!/bin/bash
+# bench.sh
+#
+# Runs the solver over a corpus of boards and writes one CSV line per board
+# with the time to the first model and to the optimum (CPU seconds, -1 if not
+# reached), the cost, the size of the formula and the peak resident memory (MB).
+#
+# usage: tools/bench.sh [-t <seconds>] [-o <file.csv>] <board>... [-- <solver options>]
+#        (called from the src directory, 'make' and tools/make-corpus.sh first)
+
+TIMEOUT=60
+OUT=/dev/stdout
+SOLVER=${SOLVER:-./main}
+
+while getopts "t:o:" opt
+do
+	case $opt in
+		t) TIMEOUT=$OPTARG ;;
+		o) OUT=$OPTARG ;;
+		*) exit 1 ;;
+	esac
+done
+shift $((OPTIND - 1))
+
+BOARDS=()
+while [ $# -gt 0 ] && [ "$1" != "--" ]
+do
+	if [ -d "$1" ]
+	then
+		BOARDS+=("$1"/*)
+	else
+		BOARDS+=("$1")
+	fi
+	shift
+done
+[ "$1" == "--" ] && shift
+
+if [ ${#BOARDS[@]} -eq 0 ] || [ ! -x "$SOLVER" ]
+then
+	echo "usage: $0 [-t <seconds>] [-o <file.csv>] <board>... [-- <solver options>]"
+	exit 1
+fi
+
+echo "board,lin,col,status,first_model,optimum,cost,vars,hard,soft,peak_rss_mb,wall" > "$OUT"
+for board in "${BOARDS[@]}"
+do
+	start=$(date +%s.%N)
+	# the solver prints its statistics when the CPU limit is reached; the
+	# wall clock limit is a safety net
+	stats=$(timeout -s KILL $((TIMEOUT + 10)) "$SOLVER" -stats -cpu-lim="$TIMEOUT" "$@" < "$board" | grep "^c stats" | tail -n 1)
+	end=$(date +%s.%N)
+	size=$(head -n 1 "$board" | tr ' ' ',')
+	if [ -z "$stats" ]
+	then
+		stats="c stats status CRASH first-model -1 optimum -1 cost -1 vars -1 hard -1 soft -1 peak-rss -1"
+	fi
+	echo "$stats" | awk -v board="$(basename "$board")" -v size="$size" -v start="$start" -v end="$end" \
+		'{ printf "%s,%s,%s,%s,%s,%s,%s,%s,%s,%s,%.3f\n", board, size, $4, $6, $8, $10, $12, $14, $16, $18, end - start }' >> "$OUT"
+done
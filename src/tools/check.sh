@@ -0,0 +1,258 @@
+#!/bin/bash
+# check.sh
+#
+# Differential check of the solver: each board is solved with every
+# algorithm/encoding configuration below, every output is checked with
+# golcheck (forward simulation and, for narrow boards, the optimum of a
+# dynamic programming oracle) and the costs of all configurations with the
+# same -border-weight must agree.
+# Runs that reach the CPU limit are reported and left out of the comparison.
+# A configuration with -resume is first run with a checkpoint written before
+# every SAT call and stopped with SIGTERM soon after its first SAT call; the
+# run that is checked resumes from that checkpoint. The boards resume-* are
+# only solved by the first configuration and by those with -resume.
+# Each board is then solved with the configurations of MASK_CONFIGS and a
+# mask file of a few queries (dead border, live centre, no fixed cell,
+# alternating first row); the answers are checked with golcheck -mask and the
+# costs of the queries must agree.
+#
+# usage: tools/check.sh [-t <seconds>] [<board>...]
+#        (called from the src directory; without boards a small corpus is
+#        generated with golgen)
+
+TIMEOUT=30
+RESUME_DELAY=${RESUME_DELAY:-0.02}
+SOLVER=${SOLVER:-./main}
+CONFIGS=(
+	"-algorithm=3"
+	"-algorithm=3 -no-unit-relax"
+	"-algorithm=3 -lower-bound=0"
+	"-algorithm=3 -lower-bound-card"
+	"-algorithm=3 -threads=3"
+	"-algorithm=3 -enum=4"
+	"-algorithm=3 -local-search=2000"
+	"-algorithm=3 -partition-strategy=2 -search-threads=2"
+	"-algorithm=3 -partition-strategy=2 -disjoint-cores"
+	"-algorithm=3 -core-min-budget=1000"
+	"-algorithm=3 -preprocess=2"
+	"-algorithm=2"
+	"-algorithm=2 -no-unit-relax"
+	"-algorithm=2 -core-trim=3"
+	"-algorithm=4"
+	"-algorithm=4 -no-unit-relax"
+	"-algorithm=4 -local-search=2000"
+	"-algorithm=4 -disjoint-cores"
+	"-algorithm=4 -preprocess=1"
+	"-algorithm=5"
+	"-algorithm=5 -portfolio=linear,oll,ihs,wbo,boosted"
+	"-algorithm=6 -boost-conflicts=1"
+	"-algorithm=7"
+	"-algorithm=7 -search-threads=2"
+	"-algorithm=1"
+	"-algorithm=1 -cardinality=0"
+	"-algorithm=1 -cardinality=2"
+	"-algorithm=0"
+	"-algorithm=0 -no-unit-relax"
+	"-algorithm=4 -border-weight=3"
+	"-algorithm=2 -no-unit-relax -border-weight=3"
+	"-algorithm=3 -no-unit-relax -border-weight=3"
+	"-algorithm=3 -border-weight=3"
+	"-algorithm=3 -partition-strategy=2 -search-threads=2 -border-weight=3"
+	"-algorithm=3 -partition-strategy=2 -disjoint-cores -border-weight=3"
+	"-algorithm=3 -core-trim=3 -border-weight=3"
+	"-algorithm=2 -core-trim=3 -core-min-budget=1000 -border-weight=3"
+	"-algorithm=4 -disjoint-cores -border-weight=3"
+	"-algorithm=2 -preprocess=2 -border-weight=3"
+	"-algorithm=4 -preprocess=2 -border-weight=3"
+	"-algorithm=0 -weight-strategy=1 -border-weight=3"
+	"-algorithm=0 -weight-strategy=2 -border-weight=3"
+	"-algorithm=5 -border-weight=3"
+	"-algorithm=3 -resume"
+	"-algorithm=2 -resume"
+)
+MASK_CONFIGS=(
+	"-algorithm=3"
+	"-algorithm=3 -search-threads=2"
+	"-algorithm=3 -disjoint-cores"
+	"-algorithm=4"
+	"-algorithm=4 -disjoint-cores"
+)
+
+while getopts "t:" opt
+do
+	case $opt in
+		t) TIMEOUT=$OPTARG ;;
+		*) exit 1 ;;
+	esac
+done
+shift $((OPTIND - 1))
+
+for tool in "$SOLVER" ./golcheck ./golgen
+do
+	if [ ! -x "$tool" ]
+	then
+		echo "Error: $tool not found, run 'make check' from the src directory"
+		exit 1
+	fi
+done
+
+TMPD=$(mktemp -d)
+trap 'rm -rf $TMPD' EXIT
+
+# Solves <board> with <config> and writes the output to $TMPD/out.
+solve() {
+	local board=$1 config=$2 resume=""
+	if [[ "$config" == *-resume* ]]
+	then
+		config=${config/ -resume/}
+		rm -f "$TMPD/checkpoint"
+		# shellcheck disable=SC2086
+		"$SOLVER" -cpu-lim="$TIMEOUT" -checkpoint="$TMPD/checkpoint" \
+			-checkpoint-interval=0 $config < "$board" > /dev/null 2>&1 &
+		local pid=$!
+		while [ ! -f "$TMPD/checkpoint" ] && kill -0 $pid 2> /dev/null
+		do
+			sleep 0.005
+		done
+		sleep $RESUME_DELAY
+		kill -TERM $pid 2> /dev/null
+		wait $pid
+		[ -f "$TMPD/checkpoint" ] && resume="-resume=$TMPD/checkpoint"
+	fi
+	# shellcheck disable=SC2086
+	"$SOLVER" -stats -cpu-lim="$TIMEOUT" $config $resume < "$board" > "$TMPD/out" 2>&1
+}
+
+# Writes the mask file of the queries of <board> to $TMPD/masks.
+masks() {
+	awk 'NR == 1 {
+		lin = $1; col = $2
+		for (q = 1; q <= 4; q++)
+			for (i = 0; i < lin; i++) {
+				row = ""
+				for (j = 0; j < col; j++) {
+					c = "."
+					if (q == 1 && (i == 0 || i == lin - 1 || j == 0 || j == col - 1))
+						c = 0
+					if (q == 2 && i == int(lin / 2) && j == int(col / 2))
+						c = 1
+					if (q == 4 && i == 0)
+						c = j % 2
+					row = row c " "
+				}
+				print row
+			}
+	}' "$1" > "$TMPD/masks"
+}
+
+BOARDS=("$@")
+if [ ${#BOARDS[@]} -eq 0 ]
+then
+	cp ../test/00 "$TMPD/test-00"
+	for object in block beehive blinker toad glider boat
+	do
+		./golgen object $object 7 7 > "$TMPD/object-$object"
+	done
+	for seed in 1 2 3 4
+	do
+		./golgen evolved 6 7 0.4 1 $seed > "$TMPD/evolved-$seed"
+		./golgen soup 5 5 0.3 $seed > "$TMPD/soup-$seed"
+	done
+	for orphan in full3 checker4
+	do
+		./golgen orphan $orphan > "$TMPD/orphan-$orphan"
+	done
+	# boards with a single row: the cells at the ends have one neighbour, so
+	# a live one has no predecessor and the partitions of PartMSU3 are empty
+	printf '1 3\n1 0 0\n' > "$TMPD/row-lonely"
+	printf '1 5\n0 1 1 1 0\n' > "$TMPD/row-triple"
+	# a board whose search is long enough to be stopped in the middle
+	./golgen evolved 10 10 0.4 1 1 > "$TMPD/resume-evolved"
+	BOARDS=("$TMPD"/object-* "$TMPD"/evolved-* "$TMPD"/soup-* "$TMPD"/orphan-* "$TMPD"/row-* "$TMPD/test-00" "$TMPD/resume-evolved")
+fi
+
+runs=0
+failures=0
+for board in "${BOARDS[@]}"
+do
+	name=$(basename "$board")
+	declare -A reference=() reference_config=()
+	weights=(1)
+	for config in "${CONFIGS[@]}"
+	do
+		if [[ "$name" == resume-* ]] && [ "$config" != "${CONFIGS[0]}" ] &&
+			[[ "$config" != *-resume* ]]
+		then
+			continue
+		fi
+		runs=$((runs + 1))
+		weight=$(echo "$config" | sed -n 's/.*-border-weight=\([0-9]*\).*/\1/p')
+		weight=${weight:-1}
+		solve "$board" "$config"
+		status=$(awk '$2 == "stats" { print $4 }' "$TMPD/out" | tail -n 1)
+		if [ "$status" != "OPTIMUM" ] && [ "$status" != "UNSATISFIABLE" ]
+		then
+			echo "$name [$config]: no optimum (${status:-crash})"
+			[ -z "$status" ] && failures=$((failures + 1))
+			continue
+		fi
+
+		result=$(./golcheck -border-weight="$weight" "$board" "$TMPD/out" | tail -n 1)
+		if [ "${result:0:2}" != "ok" ]
+		then
+			echo "$name [$config]: $result"
+			failures=$((failures + 1))
+			continue
+		fi
+
+		cost=$(echo "$result" | awk '{ print ($2 == "no") ? -1 : $NF }')
+		if [ -z "${reference[$weight]}" ]
+		then
+			reference[$weight]=$cost
+			reference_config[$weight]=$config
+			[ "$weight" != 1 ] && weights+=("$weight")
+		elif [ "$cost" != "${reference[$weight]}" ]
+		then
+			echo "$name [$config]: cost $cost, [${reference_config[$weight]}] found ${reference[$weight]}"
+			failures=$((failures + 1))
+		fi
+	done
+	for weight in "${weights[@]}"
+	do
+		oracle=$(./golcheck -border-weight="$weight" "$board" 2>/dev/null | awk '$2 == "oracle" { print $3 }')
+		suffix=""
+		[ "$weight" != 1 ] && suffix=" (border weight $weight)"
+		echo "$name$suffix: cost ${reference[$weight]:--} oracle ${oracle:--}"
+	done
+
+	[[ "$name" == resume-* ]] && continue
+	masks "$board"
+	mask_reference=""
+	for config in "${MASK_CONFIGS[@]}"
+	do
+		runs=$((runs + 1))
+		# shellcheck disable=SC2086
+		"$SOLVER" -cpu-lim="$TIMEOUT" -mask="$TMPD/masks" $config < "$board" > "$TMPD/out" 2>&1
+		result=$(./golcheck -mask="$TMPD/masks" "$board" "$TMPD/out")
+		if [ "$(echo "$result" | grep -c '^ok')" != 4 ]
+		then
+			echo "$name [$config -mask]: $(echo "$result" | grep -v '^c' | tail -n 1)"
+			failures=$((failures + 1))
+			continue
+		fi
+		costs=$(echo "$result" | awk '$1 == "ok" { printf "%s ", ($4 == "no") ? -1 : $NF }')
+		if [ -z "$mask_reference" ]
+		then
+			mask_reference=$costs
+			mask_reference_config=$config
+		elif [ "$costs" != "$mask_reference" ]
+		then
+			echo "$name [$config -mask]: costs $costs, [$mask_reference_config] found $mask_reference"
+			failures=$((failures + 1))
+		fi
+	done
+	echo "$name (masks): costs ${mask_reference:--}"
+done
+
+echo "$runs runs, $failures failures"
+[ $failures -eq 0 ]
@@ -0,0 +1,359 @@
+/*!
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+// Checker of the predecessors returned by 'main'.
+//
+//   golcheck [-border-weight=<w>] [-mask=<file>] <target> [<output>]
+//
+// Every board in the output of 'main' (comment lines start with 'c') is
+// simulated one step forward and compared with the target, and the
+// predecessors of an enumeration must be distinct and sorted by cost. If the
+// narrower side of the target has at most 'oracle_width' cells, the minimum
+// number of live cells of a predecessor is computed by dynamic programming
+// over the rows and compared with the cost of the first predecessor (or with
+// "c no predecessor"). Without an output only the oracle is printed. With
+// -border-weight a live cell on the border costs <w>, as in 'main'. With
+// -mask the output has one answer per mask of the file (after "c query <k>"),
+// whose predecessor must also keep the cells fixed by the mask and whose
+// oracle only chooses rows that keep them.
+//
+// Prints "ok" or "FAIL: <reason>" and exits with 0 or 1.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+typedef std::vector<std::vector<int> > Board;
+
+// Cells of a mask are 1 (alive), 0 (dead) or -1 (free).
+typedef Board Mask;
+
+const int oracle_width = 7;
+
+int border_weight = 1;
+
+bool readBoard(std::istream &in, Board &b) {
+  int lin, col;
+  if (!(in >> lin >> col) || lin <= 0 || col <= 0)
+    return false;
+  b.assign(lin, std::vector<int>(col, 0));
+  for (int i = 0; i < lin; i++)
+    for (int j = 0; j < col; j++)
+      if (!(in >> b[i][j]) || (b[i][j] != 0 && b[i][j] != 1))
+        return false;
+  return true;
+}
+
+// Reads the masks of a file of 'main -mask', with the size of 'target'.
+bool readMasks(std::istream &in, const Board &target, std::vector<Mask> &masks) {
+  int lin = target.size(), col = target[0].size();
+  std::string token;
+  int cell = 0;
+  while (in >> token) {
+    if (cell == 0)
+      masks.push_back(Mask(lin, std::vector<int>(col, -1)));
+    int &m = masks.back()[cell / col][cell % col];
+    if (token == "1" || token == "0")
+      m = token == "1";
+    else if (token != ".")
+      return false;
+    cell = (cell + 1) % (lin * col);
+  }
+  return cell == 0;
+}
+
+bool keepsMask(const Board &b, const Mask &mask) {
+  for (int i = 0; i < (int)b.size(); i++)
+    for (int j = 0; j < (int)b[0].size(); j++)
+      if (mask[i][j] != -1 && b[i][j] != mask[i][j])
+        return false;
+  return true;
+}
+
+Board step(const Board &b) {
+  int lin = b.size(), col = b[0].size();
+  Board next(lin, std::vector<int>(col, 0));
+  for (int i = 0; i < lin; i++)
+    for (int j = 0; j < col; j++) {
+      int n = 0;
+      for (int di = -1; di <= 1; di++)
+        for (int dj = -1; dj <= 1; dj++)
+          if ((di != 0 || dj != 0) && i + di >= 0 && i + di < lin &&
+              j + dj >= 0 && j + dj < col)
+            n += b[i + di][j + dj];
+      next[i][j] = n == 3 || (n == 2 && b[i][j]);
+    }
+  return next;
+}
+
+int cost(const Board &b) {
+  int lin = b.size(), col = b[0].size();
+  int c = 0;
+  for (int i = 0; i < lin; i++)
+    for (int j = 0; j < col; j++) {
+      bool border = i == 0 || i == lin - 1 || j == 0 || j == col - 1;
+      c += b[i][j] * (border ? border_weight : 1);
+    }
+  return c;
+}
+
+// Cost of the live cells of row 'r' of 'lin' rows (bit mask).
+int rowCost(int row, int r, int lin, int width) {
+  if (r == 0 || r == lin - 1 || width == 1)
+    return __builtin_popcount(row) * border_weight;
+  int ends = (row & 1) + (row >> (width - 1) & 1);
+  return __builtin_popcount(row) + ends * (border_weight - 1);
+}
+
+Board transpose(const Board &b) {
+  Board t(b[0].size(), std::vector<int>(b.size(), 0));
+  for (int i = 0; i < (int)b.size(); i++)
+    for (int j = 0; j < (int)b[0].size(); j++)
+      t[j][i] = b[i][j];
+  return t;
+}
+
+// Row 'mid' evolves into 'target' given the rows 'up' and 'down' (bit masks).
+bool rowEvolves(int up, int mid, int down, int target, int width) {
+  for (int j = 0; j < width; j++) {
+    int n = 0;
+    for (int dj = -1; dj <= 1; dj++) {
+      if (j + dj < 0 || j + dj >= width)
+        continue;
+      n += (up >> (j + dj) & 1) + (down >> (j + dj) & 1);
+      if (dj != 0)
+        n += mid >> (j + dj) & 1;
+    }
+    int alive = n == 3 || (n == 2 && (mid >> j & 1));
+    if (alive != (target >> j & 1))
+      return false;
+  }
+  return true;
+}
+
+// Minimum cost of the live cells of a predecessor of 'target' that keeps the
+// cells fixed by 'mask' (-1 if there is none). The state after row r is the
+// pair of predecessor rows (r-1, r); row r-1 of the target is checked when row
+// r is chosen.
+int oracle(Board target, Mask mask) {
+  if (target[0].size() > target.size()) {
+    target = transpose(target);
+    mask = transpose(mask);
+  }
+  int lin = target.size(), width = target[0].size();
+  int rows = 1 << width;
+  std::vector<int> target_rows(lin, 0);
+  // Bits of the cells of each row that the mask fixes, and their values.
+  std::vector<int> fixed(lin + 1, 0), alive(lin + 1, 0);
+  for (int i = 0; i < lin; i++)
+    for (int j = 0; j < width; j++) {
+      target_rows[i] |= target[i][j] << j;
+      if (mask[i][j] != -1) {
+        fixed[i] |= 1 << j;
+        alive[i] |= mask[i][j] << j;
+      }
+    }
+
+  const int inf = std::numeric_limits<int>::max();
+  // best[prev * rows + cur]: cheapest rows 0..r with rows r-1 and r equal to
+  // 'prev' and 'cur'.
+  std::vector<int> best(rows * rows, inf), next(rows * rows, inf);
+  for (int cur = 0; cur < rows; cur++)
+    if ((cur & fixed[0]) == alive[0])
+      best[cur] = rowCost(cur, 0, lin, width); // Row -1 is dead.
+
+  for (int r = 1; r <= lin; r++) {
+    std::fill(next.begin(), next.end(), inf);
+    // Row 'lin' is the dead row below the board.
+    int choices = r < lin ? rows : 1;
+    for (int prev = 0; prev < rows; prev++)
+      for (int cur = 0; cur < rows; cur++) {
+        int c = best[prev * rows + cur];
+        if (c == inf)
+          continue;
+        for (int down = 0; down < choices; down++) {
+          if ((down & fixed[r]) != alive[r])
+            continue;
+          int nc = c + rowCost(down, r, lin, width);
+          if (nc < next[cur * rows + down] &&
+              rowEvolves(prev, cur, down, target_rows[r - 1], width))
+            next[cur * rows + down] = nc;
+        }
+      }
+    best.swap(next);
+  }
+
+  int result = inf;
+  for (int v : best)
+    if (v < result)
+      result = v;
+  return result == inf ? -1 : result;
+}
+
+int fail(const std::string &reason) {
+  printf("FAIL: %s\n", reason.c_str());
+  return 1;
+}
+
+// Checks the answer of one query of the output, without the "c query" line.
+// 'id' names the query in the messages (empty without masks).
+int checkAnswer(const std::string &answer, const Board &target,
+                const Mask &mask, const std::string &id) {
+  int optimum = -2; // Not computed.
+  int width = std::min(target.size(), target[0].size());
+  if (width <= oracle_width) {
+    optimum = oracle(target, mask);
+    printf("c %soracle %d\n", id.c_str(), optimum);
+  }
+
+  // Boards of the answer, without the comment lines.
+  std::istringstream output(answer);
+  std::stringstream boards;
+  std::string line;
+  bool unsat = false;
+  while (std::getline(output, line)) {
+    if (line.compare(0, 16, "c no predecessor") == 0)
+      unsat = true;
+    if (!line.empty() && line[0] != 'c' && line[0] != 's')
+      boards << line << "\n";
+  }
+
+  std::vector<Board> preds;
+  Board b;
+  while (readBoard(boards, b))
+    preds.push_back(b);
+  boards >> std::ws;
+  if (!boards.eof())
+    return fail(id + "malformed output");
+
+  if (unsat) {
+    if (optimum >= 0)
+      return fail(id + "no predecessor reported, oracle found " +
+                  std::to_string(optimum));
+    printf("ok %sno predecessor\n", id.c_str());
+    return 0;
+  }
+  if (preds.empty())
+    return fail(id + "no board in the output");
+
+  for (int k = 0; k < (int)preds.size(); k++) {
+    std::string pred = id + "predecessor " + std::to_string(k + 1);
+    if (preds[k].size() != target.size() ||
+        preds[k][0].size() != target[0].size())
+      return fail(pred + " has the wrong size");
+    if (step(preds[k]) != target)
+      return fail(pred + " does not evolve into the target");
+    if (!keepsMask(preds[k], mask))
+      return fail(pred + " does not keep the mask");
+    if (k > 0 && cost(preds[k]) < cost(preds[k - 1]))
+      return fail(pred + " is cheaper than the previous one");
+    for (int l = 0; l < k; l++)
+      if (preds[l] == preds[k])
+        return fail(pred + " is repeated");
+  }
+
+  if (optimum == -1)
+    return fail(id + "oracle found no predecessor");
+  if (optimum >= 0 && cost(preds[0]) != optimum)
+    return fail(id + "cost " + std::to_string(cost(preds[0])) + ", oracle " +
+                std::to_string(optimum));
+
+  printf("ok %s%d predecessor(s) cost %d\n", id.c_str(), (int)preds.size(),
+         cost(preds[0]));
+  return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const char *mask_file = NULL;
+  for (; argc > 1 && argv[1][0] == '-'; argc--, argv++) {
+    std::string opt = argv[1];
+    if (opt.compare(0, 15, "-border-weight=") == 0)
+      border_weight = atoi(argv[1] + 15);
+    else if (opt.compare(0, 6, "-mask=") == 0)
+      mask_file = argv[1] + 6;
+    else
+      argc = 0;
+  }
+  if (argc < 2 || argc > 3 || border_weight < 1) {
+    fprintf(stderr, "usage: golcheck [-border-weight=<w>] [-mask=<file>] "
+                    "<target> [<output>]\n");
+    return 1;
+  }
+
+  Board target;
+  std::ifstream target_file(argv[1]);
+  if (!readBoard(target_file, target))
+    return fail("cannot read the target board");
+
+  // Without masks there is a single query with every cell free.
+  std::vector<Mask> masks;
+  if (mask_file != NULL) {
+    std::ifstream in(mask_file);
+    if (!in.is_open() || !readMasks(in, target, masks) || masks.empty())
+      return fail("cannot read the masks");
+  } else
+    masks.push_back(
+        Mask(target.size(), std::vector<int>(target[0].size(), -1)));
+
+  if (argc == 2) {
+    if (std::min(target.size(), target[0].size()) > (size_t)oracle_width)
+      return fail("board is too large for the oracle");
+    for (size_t q = 0; q < masks.size(); q++)
+      printf("c oracle %d\n", oracle(target, masks[q]));
+    return 0;
+  }
+
+  // Answers of the queries, split at the "c query" lines.
+  std::ifstream output_file(argv[2]);
+  std::vector<std::string> answers(mask_file != NULL ? 0 : 1);
+  std::string line;
+  while (std::getline(output_file, line)) {
+    if (mask_file != NULL && line.compare(0, 7, "c query") == 0)
+      answers.push_back("");
+    else if (!answers.empty())
+      answers.back() += line + "\n";
+  }
+  if (answers.size() != masks.size())
+    return fail(std::to_string(answers.size()) + " answers for " +
+                std::to_string(masks.size()) + " masks");
+
+  for (size_t q = 0; q < masks.size(); q++) {
+    std::string id =
+        mask_file != NULL ? "query " + std::to_string(q + 1) + ": " : "";
+    if (checkAnswer(answers[q], target, masks[q], id) != 0)
+      return 1;
+  }
+  return 0;
+}
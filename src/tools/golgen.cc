@@ -0,0 +1,245 @@
+/*!
+ * @section LICENSE
+ *
+ * Open-WBO, Copyright (c) 2013-2017, Ruben Martins, Vasco Manquinho, Ines Lynce
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+// Generator of target boards for the reversal of the Game of Life.
+//
+// Boards are printed in the input format of 'main': the number of lines and
+// columns followed by the cells (1 = alive). Cells outside the board are dead.
+//
+//   golgen soup <lin> <col> <density> [seed]
+//     Random soup; most dense soups have no predecessor.
+//   golgen evolved <lin> <col> <density> <generations> [seed]
+//     Random soup evolved 'generations' steps (>= 1), so it has a predecessor.
+//   golgen object <name> <lin> <col> [copies] [seed]
+//     Catalogued object on an empty field: one copy in the centre, or
+//     'copies' copies at random positions that do not touch each other.
+//   golgen orphan <name>
+//     Board without predecessor.
+//   golgen list
+//     Names of the objects and orphans.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Pattern {
+  const char *name;
+  std::vector<std::string> rows; // 'X' = alive.
+};
+
+const std::vector<Pattern> objects = {
+    {"block", {"XX", "XX"}},
+    {"beehive", {".XX.", "X..X", ".XX."}},
+    {"loaf", {".XX.", "X..X", ".X.X", "..X."}},
+    {"boat", {"XX.", "X.X", ".X."}},
+    {"tub", {".X.", "X.X", ".X."}},
+    {"blinker", {"XXX"}},
+    {"toad", {".XXX", "XXX."}},
+    {"beacon", {"XX..", "XX..", "..XX", "..XX"}},
+    {"glider", {".X.", "..X", "XXX"}},
+    {"lwss", {".X..X", "X....", "X...X", "XXXX."}},
+    {"rpentomino", {".XX", "XX.", ".X."}},
+    {"diehard", {"......X.", "XX......", ".X...XXX"}},
+    {"pulsar",
+     {"..XXX...XXX..", ".............", "X....X.X....X", "X....X.X....X",
+      "X....X.X....X", "..XXX...XXX..", ".............", "..XXX...XXX..",
+      "X....X.X....X", "X....X.X....X", "X....X.X....X", ".............",
+      "..XXX...XXX.."}},
+};
+
+// Whole boards without predecessor (checked by exhaustive search).
+const std::vector<Pattern> orphans = {
+    {"full3", {"XXX", "XXX", "XXX"}},
+    {"full4", {"XXXX", "XXXX", "XXXX", "XXXX"}},
+    {"checker4", {"X.X.", ".X.X", "X.X.", ".X.X"}},
+    {"stripes4", {"XXXX", "....", "XXXX", "...."}},
+};
+
+typedef std::vector<std::vector<int> > Board;
+
+const Pattern *find(const std::vector<Pattern> &catalogue, const char *name) {
+  for (const Pattern &p : catalogue)
+    if (strcmp(p.name, name) == 0)
+      return &p;
+  return NULL;
+}
+
+Board newBoard(int lin, int col) { return Board(lin, std::vector<int>(col, 0)); }
+
+void place(Board &b, const Pattern &p, int row, int col) {
+  for (int i = 0; i < (int)p.rows.size(); i++)
+    for (int j = 0; j < (int)p.rows[i].size(); j++)
+      b[row + i][col + j] = p.rows[i][j] == 'X';
+}
+
+Board soup(int lin, int col, double density, std::mt19937 &rng) {
+  std::uniform_real_distribution<double> u(0.0, 1.0);
+  Board b = newBoard(lin, col);
+  for (int i = 0; i < lin; i++)
+    for (int j = 0; j < col; j++)
+      b[i][j] = u(rng) < density;
+  return b;
+}
+
+Board step(const Board &b) {
+  int lin = b.size(), col = b[0].size();
+  Board next = newBoard(lin, col);
+  for (int i = 0; i < lin; i++)
+    for (int j = 0; j < col; j++) {
+      int n = 0;
+      for (int di = -1; di <= 1; di++)
+        for (int dj = -1; dj <= 1; dj++)
+          if ((di != 0 || dj != 0) && i + di >= 0 && i + di < lin &&
+              j + dj >= 0 && j + dj < col)
+            n += b[i + di][j + dj];
+      next[i][j] = n == 3 || (n == 2 && b[i][j]);
+    }
+  return next;
+}
+
+// Places 'copies' copies of 'p' with at least one dead cell between them.
+bool scatter(Board &b, const Pattern &p, int copies, std::mt19937 &rng) {
+  int lin = b.size(), col = b[0].size();
+  int h = p.rows.size(), w = p.rows[0].size();
+  if (h > lin || w > col)
+    return false;
+  if (copies == 1) {
+    place(b, p, (lin - h) / 2, (col - w) / 2);
+    return true;
+  }
+
+  Board used = newBoard(lin, col);
+  std::uniform_int_distribution<int> row(0, lin - h), column(0, col - w);
+  for (int c = 0, tries = 0; c < copies; tries++) {
+    if (tries > 1000 * copies)
+      return false;
+    int r = row(rng), s = column(rng);
+    bool free = true;
+    for (int i = r - 1; free && i <= r + h; i++)
+      for (int j = s - 1; free && j <= s + w; j++)
+        if (i >= 0 && i < lin && j >= 0 && j < col && used[i][j])
+          free = false;
+    if (!free)
+      continue;
+    for (int i = r; i < r + h; i++)
+      for (int j = s; j < s + w; j++)
+        used[i][j] = 1;
+    place(b, p, r, s);
+    c++;
+  }
+  return true;
+}
+
+void print(const Board &b) {
+  printf("%d %d\n", (int)b.size(), (int)b[0].size());
+  for (const std::vector<int> &row : b)
+    for (int j = 0; j < (int)row.size(); j++)
+      printf("%d%c", row[j], j + 1 < (int)row.size() ? ' ' : '\n');
+}
+
+int usage() {
+  fprintf(stderr,
+          "usage: golgen soup <lin> <col> <density> [seed]\n"
+          "       golgen evolved <lin> <col> <density> <generations> [seed]\n"
+          "       golgen object <name> <lin> <col> [copies] [seed]\n"
+          "       golgen orphan <name>\n"
+          "       golgen list\n");
+  return 1;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  if (argc < 2)
+    return usage();
+  std::string mode = argv[1];
+
+  if (mode == "list") {
+    for (const Pattern &p : objects)
+      printf("object %s\n", p.name);
+    for (const Pattern &p : orphans)
+      printf("orphan %s\n", p.name);
+    return 0;
+  }
+
+  if (mode == "orphan" && argc == 3) {
+    const Pattern *p = find(orphans, argv[2]);
+    if (p == NULL) {
+      fprintf(stderr, "Error: unknown orphan %s\n", argv[2]);
+      return 1;
+    }
+    Board b = newBoard(p->rows.size(), p->rows[0].size());
+    place(b, *p, 0, 0);
+    print(b);
+    return 0;
+  }
+
+  if (mode == "object" && argc >= 5 && argc <= 7) {
+    const Pattern *p = find(objects, argv[2]);
+    int lin = atoi(argv[3]), col = atoi(argv[4]);
+    int copies = argc > 5 ? atoi(argv[5]) : 1;
+    std::mt19937 rng(argc > 6 ? atoi(argv[6]) : 0);
+    if (p == NULL) {
+      fprintf(stderr, "Error: unknown object %s\n", argv[2]);
+      return 1;
+    }
+    if (lin <= 0 || col <= 0 || copies <= 0)
+      return usage();
+    Board b = newBoard(lin, col);
+    if (!scatter(b, *p, copies, rng)) {
+      fprintf(stderr, "Error: %d copies of %s do not fit in %dx%d\n", copies,
+              p->name, lin, col);
+      return 1;
+    }
+    print(b);
+    return 0;
+  }
+
+  if ((mode == "soup" && argc >= 5 && argc <= 6) ||
+      (mode == "evolved" && argc >= 6 && argc <= 7)) {
+    int lin = atoi(argv[2]), col = atoi(argv[3]);
+    double density = atof(argv[4]);
+    int generations = mode == "evolved" ? atoi(argv[5]) : 0;
+    int seed_arg = mode == "evolved" ? 6 : 5;
+    std::mt19937 rng(argc > seed_arg ? atoi(argv[seed_arg]) : 0);
+    if (lin <= 0 || col <= 0 || density < 0 || density > 1 ||
+        (mode == "evolved" && generations < 1))
+      return usage();
+    Board b = soup(lin, col, density, rng);
+    for (int g = 0; g < generations; g++)
+      b = step(b);
+    print(b);
+    return 0;
+  }
+
+  return usage();
+}
@@ -0,0 +1,67 @@
+#!/bin/bash
+# make-corpus.sh
+#
+# Generates the benchmark corpus of target boards with golgen.
+#
+# usage: tools/make-corpus.sh <dir>   (called from the src directory)
+
+set -e
+
+if [ $# -ne 1 ]
+then
+	echo "usage: $0 <dir>"
+	exit 1
+fi
+
+DIR=$1
+GOLGEN=./golgen
+if [ ! -x "$GOLGEN" ]
+then
+	make golgen
+fi
+mkdir -p "$DIR"
+
+# boards that are shipped with the project
+for f in ../test/*
+do
+	cp "$f" "$DIR/test-$(basename "$f")"
+done
+
+# random soups (most of the dense ones are orphans)
+for size in 6 8 10 12
+do
+	for density in 0.2 0.35 0.5
+	do
+		for seed in 1 2
+		do
+			$GOLGEN soup $size $size $density $seed > "$DIR/soup-${size}-${density}-${seed}"
+		done
+	done
+done
+
+# evolved soups (always have a predecessor)
+for size in 10 15 20 25
+do
+	for gens in 1 3
+	do
+		for seed in 1 2
+		do
+			$GOLGEN evolved $size $size 0.35 $gens $seed > "$DIR/evolved-${size}-${gens}-${seed}"
+		done
+	done
+done
+
+# catalogued objects on empty fields
+for object in block beehive loaf boat blinker toad beacon glider lwss rpentomino diehard
+do
+	$GOLGEN object $object 12 12 > "$DIR/object-${object}"
+done
+$GOLGEN object pulsar 17 17 > "$DIR/object-pulsar"
+$GOLGEN object glider 20 20 4 1 > "$DIR/object-glider-x4"
+$GOLGEN object block 20 20 6 1 > "$DIR/object-block-x6"
+
+# orphans
+for orphan in $($GOLGEN list | awk '$1 == "orphan" { print $2 }')
+do
+	$GOLGEN orphan $orphan > "$DIR/orphan-${orphan}"
+done
@@ -0,0 +1,77 @@
+#!/bin/bash
+# trace-view.sh
+#
+# Summarizes a trace written with -trace=<file>. For each search it prints the
+# number of SAT calls and the time spent in satisfiable calls (search for
+# models) and in unsatisfiable calls (cores), followed by the convergence of
+# the bounds: one line each time the lower or the upper bound changes. With
+# -p the bounds are also plotted with gnuplot.
+#
+# usage: tools/trace-view.sh [-p <file.png>] <trace.csv>
+
+PLOT=
+
+while getopts "p:" opt
+do
+	case $opt in
+		p) PLOT=$OPTARG ;;
+		*) exit 1 ;;
+	esac
+done
+shift $((OPTIND - 1))
+
+if [ $# -ne 1 ] || [ ! -f "$1" ]
+then
+	echo "usage: $0 [-p <file.png>] <trace.csv>"
+	exit 1
+fi
+TRACE=$1
+
+# Columns: time,search,seconds,result,assumptions,core,lb,ub,cost,conflicts,
+#          decisions,propagations,learnts,node_first,node_parts
+awk -F, '
+NR == 1 { next }
+{
+	s = $2
+	if (!(s in calls)) { order[++n] = s; lb[s] = -1; ub[s] = -1 }
+	calls[s]++
+	conflicts[s] += $10
+	if ($4 == "SAT") { sat[s]++; satTime[s] += $3 }
+	else if ($4 == "UNSAT") { unsat[s]++; unsatTime[s] += $3; coreSize[s] += $6 }
+	# Bounds after the call: a model may improve the upper bound and a core
+	# raises the lower bound of the next call
+	newUb = ($4 == "SAT" && (ub[s] < 0 || $9 < ub[s])) ? $9 : ub[s]
+	if ($7 != lb[s] || newUb != ub[s]) {
+		conv[s] = conv[s] sprintf("  %10.3f  lb %-8d ub %-8s node %d/%d\n", $1, $7,
+				newUb < 0 ? "-" : newUb, $14, $15)
+		lb[s] = $7; ub[s] = newUb
+	}
+}
+END {
+	for (i = 1; i <= n; i++) {
+		s = order[i]
+		printf("search %d: %d calls, %d SAT (%.3fs), %d UNSAT (%.3fs, mean core %.1f), %d conflicts\n",
+				s, calls[s], sat[s], satTime[s], unsat[s], unsatTime[s],
+				unsat[s] > 0 ? coreSize[s] / unsat[s] : 0, conflicts[s])
+		printf("%s", conv[s])
+	}
+}' "$TRACE"
+
+if [ -n "$PLOT" ]
+then
+	if ! command -v gnuplot > /dev/null
+	then
+		echo "gnuplot not found, no plot written"
+		exit 1
+	fi
+	gnuplot <<-GNUPLOT
+		set datafile separator ","
+		set terminal png size 900,600
+		set output "$PLOT"
+		set xlabel "wall time (s)"
+		set ylabel "live cells"
+		set key autotitle columnhead
+		plot "$TRACE" using 1:7 with steps title "lower bound", \
+		     "$TRACE" using 1:(\$4 eq "SAT" ? \$9 : 1/0) with points title "model cost"
+	GNUPLOT
+fi